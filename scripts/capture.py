@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+"""Record and inspect captures of advertisements received by the gateway nRF.
+
+record  Enables capture mode of the dongle over its UART, see
+        APP_UART_EXT_SET_CAPTURE, and writes every captured advertisement
+        to a capture file until the duration has passed or Ctrl-C. The
+        dongle must be connected to this host instead of the ESP32.
+info    Summarizes a capture file: duration, rate, advertisers, PHYs and
+        manufacturer IDs.
+
+Capture files are replayed into the host simulation with SIM_REPLAY, see
+src/app_capture.h for the format.
+
+Example:
+  python3 scripts/capture.py record --port /dev/ttyUSB0 --duration 600 site.cap
+  python3 scripts/capture.py info site.cap
+  SIM_REPLAY=site.cap SIM_REPLAY_SPEED=10 SIM_SPEED=0 src/targets/host_sim/_build/ruuvigw_sim
+"""
+
+import argparse
+import collections
+import os
+import select
+import struct
+import sys
+import time
+
+import gw_uart
+
+FILE_MAGIC = b"RGWCAP1\0"
+HEADER = struct.Struct("<I6sbBBBBbB")
+AD_TYPE_MANUFACTURER = 0xFF
+
+
+def records(data):
+    """Yield (time_ms, mac, rssi, primary_phy, secondary_phy, channel, is_coded,
+    tx_power, adv) of each record in capture file contents."""
+    if not data.startswith(FILE_MAGIC):
+        raise ValueError("not a capture file")
+    index = len(FILE_MAGIC)
+    while index + HEADER.size <= len(data):
+        fields = HEADER.unpack_from(data, index)
+        index += HEADER.size
+        adv = data[index:index + fields[-1]]
+        index += fields[-1]
+        yield fields[:-1] + (adv,)
+
+
+def manufacturer_id(adv):
+    index = 0
+    while index + 3 < len(adv):
+        length = adv[index]
+        if adv[index + 1] == AD_TYPE_MANUFACTURER and length >= 3:
+            return adv[index + 2] | (adv[index + 3] << 8)
+        index += length + 1
+    return None
+
+
+def record(args):
+    fd = gw_uart.port_open(args.port, args.baud)
+    decoder = gw_uart.FrameDecoder()
+    count = 0
+    end = time.monotonic() + args.duration if args.duration else None
+    with open(args.output, "wb") as output:
+        output.write(FILE_MAGIC)
+        os.write(fd, gw_uart.frame_encode(gw_uart.EXT_SET_CAPTURE, b"\x01"))
+        try:
+            while end is None or time.monotonic() < end:
+                readable, _, _ = select.select([fd], [], [], 0.5)
+                if not readable:
+                    continue
+                for cmd, payload in decoder.put(os.read(fd, 4096)):
+                    if cmd == gw_uart.EXT_CAPTURE:
+                        output.write(payload)
+                        count += 1
+        except KeyboardInterrupt:
+            pass
+        finally:
+            os.write(fd, gw_uart.frame_encode(gw_uart.EXT_SET_CAPTURE, b"\x00"))
+            os.close(fd)
+    print("{} records written to {}".format(count, args.output))
+    return 0
+
+
+def info(args):
+    with open(args.capture, "rb") as capture:
+        data = capture.read()
+    count = 0
+    duration_ms = 0
+    previous = None
+    macs = set()
+    phys = collections.Counter()
+    manufacturers = collections.Counter()
+    for time_ms, mac, _, _, _, _, is_coded, _, adv in records(data):
+        if previous is not None:
+            duration_ms += (time_ms - previous) & 0xFFFFFFFF
+        previous = time_ms
+        count += 1
+        macs.add(mac)
+        phys["coded" if is_coded else "1m"] += 1
+        manufacturers[manufacturer_id(adv)] += 1
+    rate = count * 1000.0 / duration_ms if duration_ms else 0.0
+    print("records      {}".format(count))
+    print("duration     {:.1f} s".format(duration_ms / 1000.0))
+    print("rate         {:.1f} /s".format(rate))
+    print("advertisers  {}".format(len(macs)))
+    print("phy          " + ", ".join("{} {}".format(k, v) for k, v in sorted(phys.items())))
+    for manufacturer, number in manufacturers.most_common(args.top):
+        name = "none" if manufacturer is None else "0x{:04X}".format(manufacturer)
+        print("manufacturer {:<7}{:>8} {:6.1%}".format(name, number, number / max(count, 1)))
+    return 0
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    commands = parser.add_subparsers(dest="command", required=True)
+    parser_record = commands.add_parser("record", help="Record capture from dongle")
+    parser_record.add_argument("--port", required=True, help="Serial port of dongle")
+    parser_record.add_argument("--baud", type=int, default=115200, choices=sorted(gw_uart.BAUDS))
+    parser_record.add_argument("--duration", type=float, help="Seconds to record")
+    parser_record.add_argument("output", help="Capture file to write")
+    parser_record.set_defaults(handler=record)
+    parser_info = commands.add_parser("info", help="Summarize capture file")
+    parser_info.add_argument("--top", type=int, default=5, help="Manufacturer IDs to list")
+    parser_info.add_argument("capture", help="Capture file to read")
+    parser_info.set_defaults(handler=info)
+    args = parser.parse_args(argv)
+    return args.handler(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,261 @@
+#!/usr/bin/env python3
+"""Stand in for the ESP32 of Ruuvi Gateway on the UART of the gateway nRF.
+
+Speaks the Ruuvi CA UART endpoint protocol to a dongle or to the host
+simulation: answers GET_ALL polls with SET_ALL built from the options,
+requests the device ID, counts and decodes advertisement reports and
+reports frames/s, bytes/s, advertisements/s, CRC errors and discarded bytes
+every interval and as JSON at the end.
+
+With --timestamps the gateway-specific ADV_RPRT_TS reports are enabled
+instead of ADV_RPRT2. Their dongle reception time is mapped to host time
+with SYNC_TIME to measure latency from radio reception to this host, and
+their sequence numbers count reports lost on the way. The dongle time of
+SYNC_TIME is taken as the arrival of the request, because its response can
+queue behind reports while the request goes straight through.
+
+Example:
+  SIM_UART_LINK=/tmp/ttyGW src/targets/host_sim/_build/ruuvigw_sim &
+  python3 scripts/esp32_standin.py --port /tmp/ttyGW --duration 30 --timestamps
+"""
+
+import argparse
+import json
+import os
+import select
+import struct
+import sys
+import time
+
+import gw_uart
+
+# SET_ALL payload: manufacturer ID u16 LE, delimiter, flags u8 with bits of
+# SET_ALL_FLAGS, delimiter, maximum advertisement length u8, delimiter.
+SET_ALL_FLAGS = ("filter", "coded", "1m", "2m", "37", "38", "39")
+ADV_RPRT_TS = struct.Struct("<II6sbBBBBbB")
+SYNC_TIME = struct.Struct("<QI")
+MAC_LEN = 6
+SEQ_MODULO = 1 << 32
+BITS_PER_BYTE = 10
+
+
+def set_all_payload(args):
+    enabled = {"filter": args.filter}
+    enabled.update((phy, phy in args.phy) for phy in ("coded", "1m", "2m"))
+    enabled.update((str(ch), ch in args.channels) for ch in (37, 38, 39))
+    flags = sum(1 << bit for bit, name in enumerate(SET_ALL_FLAGS) if enabled[name])
+    return struct.pack("<HBBBBB", args.manufacturer_id, gw_uart.FIELD_DELIMITER, flags,
+                       gw_uart.FIELD_DELIMITER, args.max_adv_len, gw_uart.FIELD_DELIMITER)
+
+
+def percentile(values, fraction):
+    if not values:
+        return None
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(fraction * len(ordered)))]
+
+
+class Link:
+    """State and counters of the link to one dongle."""
+
+    def __init__(self, fd, args):
+        self.fd = fd
+        self.args = args
+        self.decoder = gw_uart.FrameDecoder()
+        self.start = time.monotonic()
+        self.frames = {}
+        self.rx_bytes = 0
+        self.tx_frames = 0
+        self.advs = 0
+        self.macs = set()
+        self.device_id = None
+        self.configured = 0
+        self.acks = {"ok": 0, "error": 0}
+        self.heartbeats = 0
+        self.offset_ms = None
+        self.rtt_ms = None
+        self.last_seq = None
+        self.lost = 0
+        self.latencies = []
+
+    def send(self, cmd, payload=b""):
+        os.write(self.fd, gw_uart.frame_encode(cmd, payload))
+        self.tx_frames += 1
+
+    def sync(self):
+        self.send(gw_uart.EXT_SYNC_TIME, struct.pack("<Q", time.monotonic_ns()))
+
+    def sync_line_ms(self):
+        """Time to transmit a SYNC_TIME request on the line."""
+        frame_len = struct.calcsize("<Q") + gw_uart.FRAME_OVERHEAD
+        return frame_len * BITS_PER_BYTE * 1000.0 / self.args.baud
+
+    def on_sync(self, payload):
+        if len(payload) != SYNC_TIME.size:
+            return
+        sent_ns, dongle_ms = SYNC_TIME.unpack(payload)
+        now_ns = time.monotonic_ns()
+        # Every sync replaces the offset so drift of the dongle RTC is followed.
+        self.rtt_ms = (now_ns - sent_ns) / 1e6
+        self.offset_ms = sent_ns / 1e6 + self.sync_line_ms() - dongle_ms
+
+    def on_adv_ts(self, payload):
+        if len(payload) < ADV_RPRT_TS.size:
+            return
+        seq, rx_ms, mac = ADV_RPRT_TS.unpack_from(payload)[:3]
+        self.macs.add(mac)
+        if self.last_seq is not None:
+            gap = (seq - self.last_seq - 1) % SEQ_MODULO
+            # A backwards step is a reboot of the dongle, not a loss.
+            if gap < SEQ_MODULO // 2:
+                self.lost += gap
+        self.last_seq = seq
+        if self.offset_ms is not None:
+            dongle_now_ms = time.monotonic_ns() / 1e6 - self.offset_ms
+            latency_ms = (dongle_now_ms - rx_ms) % SEQ_MODULO
+            # Sync error can make the shortest latencies slightly negative.
+            if latency_ms >= SEQ_MODULO // 2:
+                latency_ms -= SEQ_MODULO
+            self.latencies.append(latency_ms)
+
+    def on_frame(self, cmd, payload):
+        self.frames[cmd] = self.frames.get(cmd, 0) + 1
+        self.rx_bytes += len(payload) + gw_uart.FRAME_OVERHEAD
+        if cmd == gw_uart.CA_GET_ALL:
+            self.send(gw_uart.CA_SET_ALL, set_all_payload(self.args))
+            self.configured += 1
+        elif cmd in (gw_uart.CA_ADV_RPRT, gw_uart.CA_ADV_RPRT2):
+            self.advs += 1
+            self.macs.add(payload[:MAC_LEN])
+        elif cmd == gw_uart.EXT_ADV_RPRT_TS:
+            self.advs += 1
+            self.on_adv_ts(payload)
+        elif cmd == gw_uart.EXT_SYNC_TIME:
+            self.on_sync(payload)
+        elif cmd == gw_uart.CA_DEVICE_ID:
+            self.device_id = payload.hex()
+        elif cmd == gw_uart.CA_ACK:
+            # Last payload byte is the state, 0 for success.
+            self.acks["ok" if payload[-1:] == b"\x00" else "error"] += 1
+        elif cmd == gw_uart.EXT_HEARTBEAT:
+            self.heartbeats += 1
+
+    def poll(self, timeout):
+        readable, _, _ = select.select([self.fd], [], [], timeout)
+        if readable:
+            for cmd, payload in self.decoder.put(os.read(self.fd, 4096)):
+                self.on_frame(cmd, payload)
+
+    def summary(self):
+        elapsed = max(time.monotonic() - self.start, 1e-9)
+        frames = sum(self.frames.values())
+        result = {
+            "duration_s": round(elapsed, 3),
+            "frames": frames,
+            "frames_per_s": round(frames / elapsed, 1),
+            "bytes": self.rx_bytes,
+            "bytes_per_s": round(self.rx_bytes / elapsed, 1),
+            "advs": self.advs,
+            "advs_per_s": round(self.advs / elapsed, 1),
+            "advertisers": len(self.macs),
+            "crc_errors": self.decoder.crc_errors,
+            "discarded_bytes": self.decoder.discarded,
+            "tx_frames": self.tx_frames,
+            "configured": self.configured,
+            "acks": self.acks,
+            "heartbeats": self.heartbeats,
+            "device_id": self.device_id,
+            "frames_by_cmd": {"0x{:02X}".format(k): v for k, v in sorted(self.frames.items())},
+        }
+        if self.args.timestamps:
+            result["lost"] = self.lost
+            result["sync_rtt_ms"] = None if self.rtt_ms is None else round(self.rtt_ms, 3)
+            result["latency_ms"] = {
+                "count": len(self.latencies),
+                "p50": percentile(self.latencies, 0.5),
+                "p95": percentile(self.latencies, 0.95),
+                "max": max(self.latencies) if self.latencies else None,
+            }
+        return result
+
+
+def report(previous, current):
+    dt = max(current["duration_s"] - previous.get("duration_s", 0.0), 1e-9)
+    line = "{:7.1f} s {:7.1f} frames/s {:9.1f} B/s {:7.1f} adv/s crc {} discarded {}".format(
+        current["duration_s"], (current["frames"] - previous.get("frames", 0)) / dt,
+        (current["bytes"] - previous.get("bytes", 0)) / dt,
+        (current["advs"] - previous.get("advs", 0)) / dt,
+        current["crc_errors"], current["discarded_bytes"])
+    if "latency_ms" in current and current["latency_ms"]["p50"] is not None:
+        line += " latency p50 {:.1f} p95 {:.1f} ms lost {}".format(
+            current["latency_ms"]["p50"], current["latency_ms"]["p95"], current["lost"])
+    print(line, file=sys.stderr)
+
+
+def run(args):
+    link = Link(gw_uart.port_open(args.port, args.baud), args)
+    link.send(gw_uart.CA_GET_DEVICE_ID)
+    if args.config:
+        link.send(gw_uart.CA_SET_ALL, set_all_payload(args))
+    if args.timestamps:
+        link.send(gw_uart.EXT_SET_ADV_TIMESTAMP, b"\x01")
+        link.sync()
+    end = link.start + args.duration if args.duration else None
+    next_report = link.start + args.interval
+    next_sync = link.start + args.sync_interval
+    previous = {}
+    try:
+        while end is None or time.monotonic() < end:
+            link.poll(0.1)
+            now = time.monotonic()
+            if args.timestamps and now >= next_sync:
+                link.sync()
+                next_sync = now + args.sync_interval
+            if args.interval and now >= next_report:
+                current = link.summary()
+                report(previous, current)
+                previous = current
+                next_report = now + args.interval
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if args.timestamps:
+            link.send(gw_uart.EXT_SET_ADV_TIMESTAMP, b"\x00")
+        os.close(link.fd)
+    result = link.summary()
+    text = json.dumps(result, indent=2)
+    if args.output:
+        with open(args.output, "w") as output:
+            output.write(text + "\n")
+    else:
+        print(text)
+    return 0 if result["frames"] else 1
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--port", required=True, help="Serial port or pty of dongle")
+    parser.add_argument("--baud", type=int, default=115200, choices=sorted(gw_uart.BAUDS))
+    parser.add_argument("--duration", type=float, help="Seconds to run, until Ctrl-C if omitted")
+    parser.add_argument("--interval", type=float, default=1.0,
+                        help="Seconds between progress reports, 0 for none")
+    parser.add_argument("--output", help="File to write final JSON to instead of stdout")
+    parser.add_argument("--config", action="store_true",
+                        help="Send SET_ALL at start instead of waiting for GET_ALL")
+    parser.add_argument("--manufacturer-id", type=lambda s: int(s, 0), default=0x0499)
+    parser.add_argument("--filter", action="store_true", help="Forward only manufacturer ID")
+    parser.add_argument("--phy", nargs="+", choices=("1m", "2m", "coded"), default=["1m", "coded"])
+    parser.add_argument("--channels", nargs="+", type=int, choices=(37, 38, 39),
+                        default=[37, 38, 39])
+    parser.add_argument("--max-adv-len", type=int, default=0, help="0 for no limit")
+    parser.add_argument("--timestamps", action="store_true",
+                        help="Use timestamped reports to measure latency and loss")
+    parser.add_argument("--sync-interval", type=float, default=10.0,
+                        help="Seconds between time synchronizations")
+    args = parser.parse_args(argv)
+    return run(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,241 @@
+#!/usr/bin/env python3
+"""RAM, flash and stack footprint per module of a firmware build.
+
+Reads the linker map and the -fstack-usage (.su) files of one board target
+and reports per module:
+
+  ram    Bytes of input sections placed in the RAM region, .data and .bss.
+  flash  Bytes of input sections placed in the FLASH region, plus the
+         initial values of .data which are copied from flash.
+  stack  Largest stack frame of a single function linked in the image,
+         marked dynamic if the compiler could not bound it.
+
+Modules are defined in the configuration file as source file name patterns,
+the first matching module takes a file. Sections of a library archive are
+matched by the archive name, e.g. libc_nano.a.
+
+Budgets of each board are in the same file as maximum bytes of ram, flash
+and stack per module, "total" for the whole image. The script exits with an
+error if any budget is exceeded or if no .su files are found, i.e. the
+board was built without -fstack-usage. --baseline writes the current footprint
+plus headroom as budgets of the board, for tightening budgets after a
+deliberate change.
+
+Example:
+  make -C src footprint
+  python3 scripts/footprint.py --board ruuvigw_nrf \\
+      --map src/targets/ruuvigw_nrf/_build/nrf52811_xxaa.map \\
+      --objects src/targets/ruuvigw_nrf/_build/nrf52811_xxaa --output footprint.json
+"""
+
+import argparse
+import collections
+import fnmatch
+import glob
+import json
+import math
+import os
+import re
+import sys
+
+KINDS = ("ram", "flash", "stack")
+TOTAL = "total"
+BUDGET_ROUNDING = 64
+
+REGION = re.compile(r"^(\S+)\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)")
+# Input section with name on the same line or on the previous line.
+SECTION = re.compile(r"^ (\S+)?\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)\s+(\S.*)$")
+SECTION_NAME = re.compile(r"^ (\S+)$")
+ARCHIVE_MEMBER = re.compile(r"^(.*\.a)\(.*\)$")
+
+
+def source_name(path):
+    """File name of source of object or archive in map."""
+    member = ARCHIVE_MEMBER.match(path)
+    if member:
+        return os.path.basename(member.group(1))
+    name = os.path.basename(path)
+    return name[:-2] if name.endswith(".o") else name
+
+
+def module_of(name, modules):
+    for module, patterns in modules.items():
+        if any(fnmatch.fnmatch(name, pattern) for pattern in patterns):
+            return module
+    return "other"
+
+
+def parse_map(text):
+    """Return memory regions {name: (origin, length)} and input sections
+    [(section, address, size, source)] of a GNU ld map."""
+    regions = {}
+    sections = []
+    state = None
+    pending_name = None
+    for line in text.splitlines():
+        if line.startswith("Memory Configuration"):
+            state = "regions"
+            continue
+        if line.startswith("Linker script and memory map"):
+            state = "map"
+            continue
+        if state == "regions":
+            region = REGION.match(line)
+            if region and region.group(1) != "Name":
+                regions[region.group(1)] = (int(region.group(2), 16), int(region.group(3), 16))
+        elif state == "map":
+            section = SECTION.match(line)
+            if section:
+                name = section.group(1) or pending_name
+                pending_name = None
+                if name and name != "*fill*":
+                    sections.append((name, int(section.group(2), 16), int(section.group(3), 16),
+                                     source_name(section.group(4).strip())))
+                continue
+            name = SECTION_NAME.match(line)
+            pending_name = name.group(1) if name else None
+    return regions, sections
+
+
+def parse_stack_usage(directory):
+    """Return [(source, function, bytes, qualifiers)] of .su files."""
+    frames = []
+    for path in sorted(glob.glob(os.path.join(directory, "**", "*.su"), recursive=True)):
+        with open(path) as su:
+            for line in su:
+                fields = line.rstrip("\n").split("\t")
+                if len(fields) != 3:
+                    continue
+                location, size, qualifiers = fields
+                # location is file:line:column:function.
+                parts = location.rsplit(":", 3)
+                frames.append((os.path.basename(parts[0]), parts[-1], int(size), qualifiers))
+    return frames
+
+
+def in_region(address, region):
+    return region is not None and region[0] <= address < region[0] + region[1]
+
+
+def footprint(regions, sections, frames, modules):
+    usage = {}
+
+    def module_usage(module):
+        return usage.setdefault(module, {"ram": 0, "flash": 0, "stack": 0,
+                                         "stack_function": None, "stack_dynamic": False})
+
+    total = {"ram": 0, "flash": 0}
+    linked = set()
+    for name, address, size, source in sections:
+        ram = in_region(address, regions.get("RAM"))
+        flash = in_region(address, regions.get("FLASH"))
+        if not (ram or flash) or not size:
+            continue
+        entry = module_usage(module_of(source, modules))
+        if ram:
+            entry["ram"] += size
+            total["ram"] += size
+            # Initial values of .data are loaded from flash.
+            if name.startswith(".data"):
+                entry["flash"] += size
+                total["flash"] += size
+        else:
+            entry["flash"] += size
+            total["flash"] += size
+            if name.startswith(".text."):
+                linked.add(name[len(".text."):])
+    total_stack = {"stack": 0}
+    for source, function, size, qualifiers in frames:
+        # With -ffunction-sections a function without its section was discarded.
+        if linked and function not in linked:
+            continue
+        entry = module_usage(module_of(source, modules))
+        if size > entry["stack"]:
+            entry["stack"] = size
+            entry["stack_function"] = function
+        entry["stack_dynamic"] |= "dynamic" in qualifiers
+        total_stack["stack"] = max(total_stack["stack"], size)
+    # Report in order of configuration.
+    ordered = collections.OrderedDict((module, usage[module])
+                                      for module in list(modules) + ["other"] if module in usage)
+    ordered[TOTAL] = dict(total, **total_stack)
+    return ordered
+
+
+def check(usage, budgets):
+    """Return messages of exceeded budgets."""
+    failures = []
+    for module, budget in budgets.items():
+        for kind in KINDS:
+            limit = budget.get(kind)
+            used = usage.get(module, {}).get(kind, 0)
+            if limit is not None and used > limit:
+                failures.append("{} {} {} B exceeds budget {} B".format(module, kind, used, limit))
+    return failures
+
+
+def baseline(usage, headroom):
+    budgets = collections.OrderedDict()
+    for module, entry in usage.items():
+        budgets[module] = {kind: int(math.ceil(entry[kind] * (1.0 + headroom / 100.0)
+                                               / BUDGET_ROUNDING) * BUDGET_ROUNDING)
+                           for kind in KINDS if kind in entry}
+    return budgets
+
+
+def print_report(board, usage, budgets):
+    print("{:<12}{:>9}{:>9}{:>8}  {}".format(board, "ram", "flash", "stack", "largest frame"))
+    for module, entry in usage.items():
+        budget = budgets.get(module, {})
+        cells = []
+        for kind, width in (("ram", 9), ("flash", 9), ("stack", 8)):
+            limit = budget.get(kind)
+            cell = str(entry[kind]) + ("!" if limit is not None and entry[kind] > limit else "")
+            cells.append(cell.rjust(width))
+        function = entry.get("stack_function") or ""
+        if entry.get("stack_dynamic"):
+            function += " (dynamic)"
+        print("{:<12}{}  {}".format(module, "".join(cells), function))
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--board", required=True, help="Board target, key of budgets")
+    parser.add_argument("--map", required=True, help="Linker map of the build")
+    parser.add_argument("--objects", required=True, help="Directory of objects and .su files")
+    parser.add_argument("--config", default=os.path.join(os.path.dirname(__file__), os.pardir,
+                                                         "src", "footprint.json"))
+    parser.add_argument("--output", help="File to write footprint to as JSON")
+    parser.add_argument("--baseline", type=float, metavar="PERCENT",
+                        help="Write current footprint plus PERCENT headroom as budgets")
+    args = parser.parse_args(argv)
+    with open(args.config) as config_file:
+        config = json.load(config_file, object_pairs_hook=collections.OrderedDict)
+    with open(args.map) as map_file:
+        regions, sections = parse_map(map_file.read())
+    frames = parse_stack_usage(args.objects)
+    if not frames:
+        print("{}: no stack usage (.su) files in {}, build with -fstack-usage"
+              .format(args.board, args.objects), file=sys.stderr)
+        return 1
+    usage = footprint(regions, sections, frames, config["modules"])
+    if args.baseline is not None:
+        config["budgets"][args.board] = baseline(usage, args.baseline)
+        with open(args.config, "w") as config_file:
+            json.dump(config, config_file, indent=2)
+            config_file.write("\n")
+    budgets = config["budgets"].get(args.board, {})
+    print_report(args.board, usage, budgets)
+    if args.output:
+        with open(args.output, "w") as output:
+            json.dump({"board": args.board, "modules": usage}, output, indent=2)
+            output.write("\n")
+    failures = check(usage, budgets)
+    for failure in failures:
+        print("{}: {}".format(args.board, failure), file=sys.stderr)
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,112 @@
+"""UART framing of the gateway nRF firmware, shared by the host-side scripts.
+
+Ruuvi CA UART endpoint commands and gateway-specific commands (app_uart_ext.h)
+share the frame STX | LEN | CMD | PAYLOAD | CRC16 | ETX, where LEN is the
+length of PAYLOAD and CRC16 is CRC-16/CCITT-FALSE of LEN, CMD and PAYLOAD in
+little-endian byte order. Serial ports are opened with termios, so only the
+standard library is needed.
+"""
+
+import os
+import struct
+import termios
+
+STX = 0xCA
+ETX = 0x0A
+FIELD_DELIMITER = 0x2C
+FRAME_OVERHEAD = 6
+
+# Ruuvi CA UART endpoint commands, re_ca_uart_cmd_t.
+CA_SET_ALL = 15
+CA_ADV_RPRT = 16
+CA_DEVICE_ID = 17
+CA_GET_DEVICE_ID = 24
+CA_GET_ALL = 25
+CA_ACK = 32
+CA_LED_CTRL = 33
+CA_ADV_RPRT2 = 34
+
+# Gateway-specific commands, app_uart_ext_cmd_t.
+EXT_GET_STATS = 0xA3
+EXT_ADV_RPRT_TS = 0xA6
+EXT_SET_ADV_TIMESTAMP = 0xA7
+EXT_SYNC_TIME = 0xA8
+EXT_GET_SEQ_STATUS = 0xA9
+EXT_HEARTBEAT = 0xAC
+EXT_SET_CAPTURE = 0xAE
+EXT_CAPTURE = 0xAF
+
+BAUDS = {9600: termios.B9600, 19200: termios.B19200, 38400: termios.B38400,
+         57600: termios.B57600, 115200: termios.B115200, 230400: termios.B230400,
+         460800: termios.B460800, 921600: termios.B921600, 1000000: termios.B1000000}
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE, as app_uart_ext_crc16."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def frame_encode(cmd, payload=b""):
+    body = bytes([len(payload), cmd]) + bytes(payload)
+    return bytes([STX]) + body + struct.pack("<H", crc16(body)) + bytes([ETX])
+
+
+class FrameDecoder:
+    """Reassemble frames from received bytes like app_uart_rx.
+
+    Bytes outside frames are counted in discarded. A frame with STX and ETX
+    in place but wrong CRC is counted in crc_errors, and parsing resumes from
+    the byte after its STX in case the length was corrupted.
+    """
+
+    def __init__(self):
+        self.pending = b""
+        self.discarded = 0
+        self.crc_errors = 0
+
+    def put(self, data):
+        """Add received bytes, return list of (cmd, payload) of complete frames."""
+        buffer = self.pending + data
+        frames = []
+        index = 0
+        while index < len(buffer):
+            if buffer[index] != STX:
+                self.discarded += 1
+                index += 1
+                continue
+            if len(buffer) - index < 2:
+                break
+            end = index + buffer[index + 1] + FRAME_OVERHEAD
+            if end > len(buffer):
+                break
+            body = buffer[index + 1:end - 3]
+            crc = struct.unpack_from("<H", buffer, end - 3)[0]
+            if buffer[end - 1] == ETX and crc == crc16(body):
+                frames.append((body[1], bytes(body[2:])))
+                index = end
+                continue
+            if buffer[end - 1] == ETX:
+                self.crc_errors += 1
+            self.discarded += 1
+            index += 1
+        self.pending = buffer[index:]
+        return frames
+
+
+def port_open(path, baud=115200):
+    """Open serial port or pty in raw mode, return file descriptor."""
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+    attrs = termios.tcgetattr(fd)
+    attrs[0] = 0
+    attrs[1] = 0
+    attrs[2] = termios.CS8 | termios.CREAD | termios.CLOCAL
+    attrs[3] = 0
+    attrs[4] = attrs[5] = BAUDS[baud]
+    termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return fd
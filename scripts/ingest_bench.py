@@ -0,0 +1,199 @@
+#!/usr/bin/env python3
+"""Advertisement ingest throughput of the gateway nRF firmware.
+
+Runs the host simulation (src/targets/host_sim) with synthetic tag
+populations which the virtual radio feeds to on_scan_isr, for each
+combination of payload length, manufacturer filter and number of tags.
+
+For every combination the highest advertisement rate which is forwarded
+without any drop is searched by bisection. The run at that rate gives the
+sustained forwarded frames per second and CPU time per advertisement. A
+second run at twice the rate gives the drop rate of each stage, relative
+to advertisements given to the application:
+
+  sched_full  Scheduler queue full in on_scan_isr.
+  uart_busy   UART driver did not accept frame.
+  encode      Frame could not be encoded.
+  too_long    Payload does not fit in a UART frame.
+
+Half of the tags advertise other manufacturers' data by default, so the
+filtered runs forward half of what is received.
+
+Results are written as JSON. Given a previous result as baseline, the script
+exits with an error if a sustained rate regressed by more than the
+tolerance. CPU time depends on the host and is compared only on request.
+
+Example:
+  make -C src/targets/host_sim
+  python3 scripts/ingest_bench.py --output ingest.json --baseline previous.json
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+DEFAULT_SIM = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src",
+                           "targets", "host_sim", "_build", "ruuvigw_sim")
+DROP_STAGES = (("sched_full", "drop_sched_full"), ("uart_busy", "drop_uart_busy"),
+               ("encode", "encode_errors"), ("too_long", "fltr_too_long"))
+
+
+def run_sim(args, adv_len, is_filtered, tags, rate):
+    """Run simulation with one configuration, return its result object."""
+    with tempfile.TemporaryDirectory() as tmp:
+        result_path = os.path.join(tmp, "result.json")
+        env = dict(os.environ)
+        env.update({
+            "SIM_SPEED": "0",
+            "SIM_DURATION_MS": str(args.duration_ms),
+            "SIM_ADV_RATE": str(rate),
+            "SIM_ADV_TAGS": str(tags),
+            "SIM_ADV_LEN": str(adv_len),
+            "SIM_ADV_FOREIGN_PCT": str(args.foreign_pct),
+            "SIM_FILTER": "1" if is_filtered else "0",
+            "SIM_UART_BAUD": str(args.baud),
+            "SIM_UART_SINK": "1",
+            "SIM_RESULT": result_path,
+            "SIM_LOG": "1",
+        })
+        subprocess.run([args.sim], env=env, check=True, stdout=subprocess.DEVNULL,
+                       stderr=subprocess.DEVNULL)
+        with open(result_path) as result_file:
+            return json.load(result_file)
+
+
+def drops(result):
+    """Advertisements lost between radio and UART."""
+    app = result["app"]
+    return sum(app[counter] for _, counter in DROP_STAGES) + result["uart"]["tx_lost"]
+
+
+def sustained(args, adv_len, is_filtered, tags):
+    """Bisect highest rate without drops, return rate and its result."""
+    low, low_result = 0, None
+    high = args.max_rate
+    result = run_sim(args, adv_len, is_filtered, tags, high)
+    if drops(result) == 0:
+        return high, result, False
+    while high - low > max(1, low // args.resolution):
+        mid = (low + high) // 2
+        result = run_sim(args, adv_len, is_filtered, tags, max(mid, 1))
+        if drops(result) == 0:
+            low, low_result = mid, result
+        else:
+            high = mid
+    return low, low_result, True
+
+
+def bench(args, adv_len, is_filtered, tags):
+    rate, result, is_saturated = sustained(args, adv_len, is_filtered, tags)
+    row = {
+        "adv_len": adv_len,
+        "filter": is_filtered,
+        "tags": tags,
+        "sustained_rate": rate,
+        "saturated": is_saturated,
+        "forwarded_per_s": result["forwarded_per_s"] if result else 0.0,
+        "cpu_ns_per_adv": result["cpu_ns_per_adv"] if result else 0,
+    }
+    if is_saturated:
+        over_rate = min(max(2 * rate, 1), args.max_rate)
+        over = run_sim(args, adv_len, is_filtered, tags, over_rate)
+        received = max(over["radio"]["received"], 1)
+        row["overload"] = {
+            "rate": over_rate,
+            "forwarded_per_s": over["forwarded_per_s"],
+            "drop_rate": {stage: over["app"][counter] / received
+                          for stage, counter in DROP_STAGES},
+        }
+    return row
+
+
+def compare(rows, baseline, args):
+    """Return descriptions of regressions against baseline results."""
+    previous = {(r["adv_len"], r["filter"], r["tags"]): r for r in baseline["results"]}
+    regressions = []
+    for row in rows:
+        old = previous.get((row["adv_len"], row["filter"], row["tags"]))
+        if old is None:
+            continue
+        name = "len={} filter={} tags={}".format(row["adv_len"], row["filter"], row["tags"])
+        if row["sustained_rate"] < old["sustained_rate"] * (1.0 - args.tolerance):
+            regressions.append("{}: sustained rate {} < {}".format(
+                name, row["sustained_rate"], old["sustained_rate"]))
+        if (args.cpu_tolerance is not None and old["cpu_ns_per_adv"]
+                and row["cpu_ns_per_adv"] > old["cpu_ns_per_adv"] * (1.0 + args.cpu_tolerance)):
+            regressions.append("{}: CPU time {} ns > {} ns".format(
+                name, row["cpu_ns_per_adv"], old["cpu_ns_per_adv"]))
+    return regressions
+
+
+def int_list(text):
+    return [int(value) for value in text.split(",")]
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--sim", default=DEFAULT_SIM, help="Host simulation executable")
+    parser.add_argument("--lens", type=int_list, default=[31, 192],
+                        help="Payload lengths, over 31 is extended advertising")
+    parser.add_argument("--tags", type=int_list, default=[10, 100, 1000, 5000],
+                        help="Numbers of tags")
+    parser.add_argument("--foreign-pct", type=int, default=50,
+                        help="Share of tags with other manufacturer ID, %%")
+    parser.add_argument("--max-rate", type=int, default=5000,
+                        help="Highest advertisement rate to try, 1/s")
+    parser.add_argument("--resolution", type=int, default=50,
+                        help="Bisection stops within rate / resolution")
+    parser.add_argument("--duration-ms", type=int, default=10000,
+                        help="Virtual time of each run, ms")
+    parser.add_argument("--baud", type=int, default=115200, help="UART line rate")
+    parser.add_argument("--output", help="File to write JSON results to")
+    parser.add_argument("--baseline", help="Previous JSON results to compare to")
+    parser.add_argument("--tolerance", type=float, default=0.1,
+                        help="Allowed relative drop of sustained rate")
+    parser.add_argument("--cpu-tolerance", type=float,
+                        help="Allowed relative growth of CPU time, not compared if unset")
+    args = parser.parse_args(argv)
+
+    rows = []
+    print("{:>6}{:>8}{:>7}{:>11}{:>12}{:>10}{:>12}{:>11}".format(
+        "len", "filter", "tags", "rate/s", "forward/s", "ns/adv", "sched_drop", "uart_drop"))
+    for adv_len in args.lens:
+        for is_filtered in (False, True):
+            for tags in args.tags:
+                row = bench(args, adv_len, is_filtered, tags)
+                rows.append(row)
+                drop = row.get("overload", {}).get("drop_rate", {})
+                print("{:>6}{:>8}{:>7}{:>10}{}{:>12.1f}{:>10}{:>11.1%}{:>11.1%}".format(
+                    adv_len, "on" if is_filtered else "off", tags, row["sustained_rate"],
+                    " " if row["saturated"] else "+", row["forwarded_per_s"],
+                    row["cpu_ns_per_adv"], drop.get("sched_full", 0.0),
+                    drop.get("uart_busy", 0.0)))
+
+    results = {
+        "duration_ms": args.duration_ms,
+        "foreign_pct": args.foreign_pct,
+        "baud": args.baud,
+        "results": rows,
+    }
+    if args.output:
+        with open(args.output, "w") as output:
+            json.dump(results, output, indent=1)
+
+    status = 0
+    if args.baseline:
+        with open(args.baseline) as baseline:
+            regressions = compare(rows, json.load(baseline), args)
+        for regression in regressions:
+            print("regression: " + regression)
+        status = 1 if regressions else 0
+    return status
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
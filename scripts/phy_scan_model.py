@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+"""Monte-Carlo model of scanning mixed LE 1M / LE Coded tag populations.
+
+Compares reception of PHY scan modes with assumed slot and radio behaviour;
+it is a model to choose parameters, not a measurement of the firmware:
+
+  alternating   PHY switches on every scan slot (APP_PHY_SCHED adaptive off).
+  adaptive      Slots are divided by packet yield like src/app_phy_sched.c.
+  simultaneous  SoftDevice scans both primary PHYs, interleaving scan
+                windows within every scan interval. Not implemented by the
+                firmware, the radio driver selects one primary PHY per
+                ri_radio_init; modelled to show what it would gain.
+
+For each mode the model reports the packet reception ratio per PHY and the
+share of report periods in which each tag was heard at least once, which is
+what the backend sees as data freshness.
+
+Example:
+  python3 phy_scan_model.py --tags-1m 40 --tags-coded 5 --duration 3600
+"""
+
+import argparse
+import random
+import sys
+
+YIELD_SCALE = 16
+EWMA_SHIFT = 2
+
+
+class PhySched:
+    """Python port of the slot allocation in src/app_phy_sched.c."""
+
+    def __init__(self, adaptive, round_slots, min_slots):
+        self.adaptive = adaptive
+        self.round_slots = round_slots
+        self.min_slots = min_slots
+        self.yield_x16 = {False: 0, True: 0}
+        self.slots_left = 0
+
+    def _alloc(self, coded):
+        if not self.adaptive:
+            return 1
+        total = self.yield_x16[False] + self.yield_x16[True]
+        share = self.min_slots
+        if total > 0:
+            share = (self.round_slots * self.yield_x16[coded] + total // 2) // total
+        return max(self.min_slots, min(share, self.round_slots - self.min_slots))
+
+    def next_is_coded(self, current_coded, packets):
+        sample = min(packets, 0xFFFF // YIELD_SCALE) * YIELD_SCALE
+        y = self.yield_x16[current_coded]
+        # C division truncates towards zero.
+        delta = int((sample - y) / (1 << EWMA_SHIFT))
+        self.yield_x16[current_coded] = y + delta
+        if self.slots_left > 0:
+            self.slots_left -= 1
+        if self.slots_left == 0:
+            current_coded = not current_coded
+            self.slots_left = self._alloc(current_coded)
+        return current_coded
+
+
+def make_tags(rng, count, coded, interval_s, duration_s):
+    """Advertisement times of each tag, with BLE advDelay of 0..10 ms."""
+    tags = []
+    for _ in range(count):
+        t = rng.uniform(0.0, interval_s)
+        times = []
+        while t < duration_s:
+            times.append(t)
+            t += interval_s + rng.uniform(0.0, 0.010)
+        tags.append((coded, times))
+    return tags
+
+
+def slot_listener(tags, args, rng, adaptive):
+    """Reception with one PHY per scan slot, switched by PhySched."""
+    sched = PhySched(adaptive, args.round_slots, args.min_slots)
+    events = sorted((t, i) for i, (_, times) in enumerate(tags) for t in times)
+    received = [[] for _ in tags]
+    slot_end = args.slot_s
+    coded = False
+    packets = 0
+    for t, i in events:
+        while t >= slot_end:
+            coded = sched.next_is_coded(coded, packets)
+            packets = 0
+            slot_end += args.slot_s + args.restart_s
+        slot_start = slot_end - args.slot_s
+        if t < slot_start:
+            continue  # Radio is being reinitialized.
+        if tags[i][0] == coded and rng.random() >= args.loss:
+            received[i].append(t)
+            packets += 1
+    return received
+
+
+def simultaneous_listener(tags, args, rng):
+    """Reception when controller interleaves PHYs within each scan interval."""
+    received = [[] for _ in tags]
+    half = args.interval_s / 2.0
+    for i, (coded, times) in enumerate(tags):
+        for t in times:
+            phase = t % args.interval_s
+            listening_coded = phase >= half
+            if listening_coded == coded and rng.random() >= args.loss:
+                received[i].append(t)
+    return received
+
+
+def summarize(name, tags, received, args):
+    rows = []
+    for phy_coded, phy_name in ((False, "1M"), (True, "coded")):
+        sent = 0
+        got = 0
+        periods = 0
+        heard = 0
+        n_periods = int(args.duration // args.report_s)
+        for (coded, times), rx in zip(tags, received):
+            if coded != phy_coded:
+                continue
+            sent += len(times)
+            got += len(rx)
+            heard_periods = {int(t // args.report_s) for t in rx}
+            periods += n_periods
+            heard += sum(1 for p in range(n_periods) if p in heard_periods)
+        if sent:
+            rows.append((name, phy_name, got / sent, heard / periods))
+    return rows
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--tags-1m", type=int, default=40, help="Tags on LE 1M PHY")
+    parser.add_argument("--tags-coded", type=int, default=5, help="Tags on LE Coded PHY")
+    parser.add_argument("--adv-interval", type=float, default=1.285,
+                        help="Advertising interval of tags, s")
+    parser.add_argument("--duration", type=float, default=3600.0, help="Simulated time, s")
+    parser.add_argument("--slot-s", type=float, default=21.0,
+                        help="Length of a scan slot before timeout, s")
+    parser.add_argument("--restart-s", type=float, default=0.005,
+                        help="Radio reinitialization time between slots, s")
+    parser.add_argument("--interval-s", type=float, default=0.1,
+                        help="Scan interval of simultaneous mode, s")
+    parser.add_argument("--round-slots", type=int, default=8, help="APP_PHY_SCHED_ROUND_SLOTS")
+    parser.add_argument("--min-slots", type=int, default=1, help="APP_PHY_SCHED_MIN_SLOTS")
+    parser.add_argument("--loss", type=float, default=0.1,
+                        help="Probability of losing a packet heard on the right PHY")
+    parser.add_argument("--report-s", type=float, default=10.0,
+                        help="Period in which a tag should be heard at least once, s")
+    parser.add_argument("--seed", type=int, default=1, help="Random seed")
+    args = parser.parse_args(argv)
+
+    rng = random.Random(args.seed)
+    tags = (make_tags(rng, args.tags_1m, False, args.adv_interval, args.duration)
+            + make_tags(rng, args.tags_coded, True, args.adv_interval, args.duration))
+
+    rows = []
+    rows += summarize("alternating", tags, slot_listener(tags, args, rng, False), args)
+    rows += summarize("adaptive", tags, slot_listener(tags, args, rng, True), args)
+    rows += summarize("simultaneous", tags, simultaneous_listener(tags, args, rng), args)
+
+    print("{:<14}{:<8}{:>12}{:>12}".format("mode", "phy", "packets", "fresh"))
+    for name, phy, ratio, fresh in rows:
+        print("{:<14}{:<8}{:>11.1%}{:>12.1%}".format(name, phy, ratio, fresh))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,268 @@
+#!/usr/bin/env python3
+"""Worst-case stack depth of the firmware from its call graph.
+
+The call graph is read from the disassembly of the linked image, so it
+reflects inlining and discarded functions: bl and blx to a symbol are calls,
+branches to another function are tail calls. Frame sizes are taken from the
+-fstack-usage (.su) files, or estimated from push and sub sp of the prologue
+for functions compiled without them, e.g. libc and assembly.
+
+Calls through function pointers are resolved only in the dispatch functions
+of the configuration, e.g. app_sched_execute calls any handler given to
+ri_scheduler_event_put. "@name" in targets are the last arguments of calls
+to the function of registrations in the project sources, other targets are
+function name patterns. Indirect calls elsewhere are listed as unresolved and
+add nothing to the depth.
+
+Each context of the configuration is a set of roots, main for the thread
+and interrupt handlers for the others. Contexts at different interrupt
+priorities can preempt each other, so the worst case is the main context
+plus the deepest context of each priority, an exception frame for each
+preemption and the stack reserved for the SoftDevice. The script exits with
+an error if it exceeds the stack section of the build.
+
+Example:
+  make -C src footprint
+  python3 scripts/stack_depth.py --board ruuvigw_nrf \\
+      --elf src/targets/ruuvigw_nrf/_build/nrf52811_xxaa.out \\
+      --map src/targets/ruuvigw_nrf/_build/nrf52811_xxaa.map \\
+      --objects src/targets/ruuvigw_nrf/_build/nrf52811_xxaa
+"""
+
+import argparse
+import collections
+import fnmatch
+import glob
+import json
+import os
+import re
+import subprocess
+import sys
+
+import footprint
+
+FUNCTION = re.compile(r"^([0-9a-f]+) <([^>]+)>:$")
+INSTRUCTION = re.compile(r"^\s+[0-9a-f]+:\s+(\S+)\s*(.*)$")
+SYMBOL = re.compile(r"<([^>+]+)>$")
+BRANCH = re.compile(r"^b(eq|ne|cs|hs|cc|lo|mi|pl|vs|vc|hi|ls|ge|lt|gt|le|al)?(\.[nw])?$")
+REGISTER_LIST = re.compile(r"\{([^}]*)\}")
+SUB_SP = re.compile(r"^sp,\s*(?:sp,\s*)?#(\d+)")
+PROLOGUE_LEN = 8
+WORD_BYTES = 4
+
+
+class Function:
+    def __init__(self, name):
+        self.name = name
+        self.calls = set()
+        self.indirect = 0
+        self.push = 0
+        self.sub = 0
+
+    def estimate(self):
+        return self.push + self.sub
+
+
+def register_count(operands):
+    registers = REGISTER_LIST.search(operands)
+    count = 0
+    if registers:
+        for register in registers.group(1).split(","):
+            bounds = register.strip().split("-")
+            if len(bounds) == 2:
+                count += int(bounds[1].lstrip("r")) - int(bounds[0].lstrip("r")) + 1
+            else:
+                count += 1
+    return count
+
+
+def parse_disassembly(text):
+    """Return {name: Function} of objdump -d output."""
+    functions = {}
+    current = None
+    position = 0
+    for line in text.splitlines():
+        header = FUNCTION.match(line)
+        if header:
+            current = functions.setdefault(header.group(2), Function(header.group(2)))
+            position = 0
+            continue
+        instruction = INSTRUCTION.match(line)
+        if current is None or not instruction:
+            continue
+        mnemonic, operands = instruction.group(1), instruction.group(2).split(";")[0].strip()
+        target = SYMBOL.search(operands)
+        if mnemonic in ("bl", "blx"):
+            if target:
+                current.calls.add(target.group(1))
+            else:
+                current.indirect += 1
+        elif BRANCH.match(mnemonic) and target and target.group(1) != current.name:
+            current.calls.add(target.group(1))
+        elif mnemonic == "bx" and operands != "lr":
+            current.indirect += 1
+        if position < PROLOGUE_LEN:
+            if mnemonic in ("push", "push.w") or (mnemonic == "stmdb" and operands.startswith("sp!")):
+                current.push += WORD_BYTES * register_count(operands)
+            elif mnemonic in ("sub", "sub.w", "subw"):
+                immediate = SUB_SP.match(operands)
+                if immediate:
+                    current.sub += int(immediate.group(1))
+        position += 1
+    return functions
+
+
+def registered_functions(sources, registration):
+    """Names given as last argument to registration in C sources."""
+    call = re.compile(re.escape(registration) + r"\s*\(([^;]*?)\)\s*;", re.S)
+    names = set()
+    for path in sources:
+        with open(path) as source:
+            for arguments in call.findall(source.read()):
+                last = arguments.rsplit(",", 1)[-1].strip().lstrip("&").strip()
+                if re.match(r"^\w+$", last):
+                    names.add(last)
+    return names
+
+
+def resolve_targets(patterns, functions, registered):
+    targets = set()
+    for pattern in patterns:
+        if pattern.startswith("@"):
+            targets |= registered[pattern[1:]]
+        else:
+            targets |= set(fnmatch.filter(functions, pattern))
+    return targets
+
+
+class Analysis:
+    def __init__(self, functions, frames, dispatch):
+        self.functions = functions
+        self.frames = frames
+        self.dispatch = dispatch
+        self.memo = {}
+        self.estimated = set()
+        self.dynamic = set()
+        self.unresolved = set()
+        self.recursive = set()
+
+    def frame(self, name):
+        if name in self.frames:
+            size, qualifiers = self.frames[name]
+            if "dynamic" in qualifiers:
+                self.dynamic.add(name)
+            return size
+        self.estimated.add(name)
+        function = self.functions.get(name)
+        return function.estimate() if function else 0
+
+    def callees(self, name):
+        function = self.functions.get(name)
+        if function is None:
+            return set()
+        callees = set(function.calls)
+        if function.indirect:
+            if name in self.dispatch:
+                callees |= self.dispatch[name]
+            else:
+                self.unresolved.add(name)
+        return callees
+
+    def depth(self, name, stack=()):
+        """Return (bytes, call chain) of deepest path from name."""
+        if name in self.memo:
+            return self.memo[name]
+        if name in stack:
+            self.recursive.add(name)
+            return 0, []
+        deepest = (0, [])
+        for callee in sorted(self.callees(name)):
+            result = self.depth(callee, stack + (name,))
+            if result[0] > deepest[0]:
+                deepest = result
+        frame = self.frame(name)
+        result = (frame + deepest[0], [(name, frame)] + deepest[1])
+        self.memo[name] = result
+        return result
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--board", required=True)
+    parser.add_argument("--elf", required=True, help="Linked image")
+    parser.add_argument("--map", required=True, help="Linker map, for size of stack")
+    parser.add_argument("--objects", required=True, help="Directory of .su files")
+    parser.add_argument("--config", default=os.path.join(os.path.dirname(__file__), os.pardir,
+                                                         "src", "stack_depth.json"))
+    parser.add_argument("--objdump", default="arm-none-eabi-objdump")
+    parser.add_argument("--output", help="File to write analysis to as JSON")
+    args = parser.parse_args(argv)
+    config_dir = os.path.dirname(os.path.abspath(args.config))
+    with open(args.config) as config_file:
+        config = json.load(config_file, object_pairs_hook=collections.OrderedDict)
+    disassembly = subprocess.run([args.objdump, "-d", "--no-show-raw-insn", args.elf],
+                                 check=True, stdout=subprocess.PIPE, universal_newlines=True)
+    functions = parse_disassembly(disassembly.stdout)
+    frames = {}
+    for _, function, size, qualifiers in footprint.parse_stack_usage(args.objects):
+        # Static functions of the same name in different files: keep the larger.
+        if size >= frames.get(function, (0, ""))[0]:
+            frames[function] = (size, qualifiers)
+    with open(args.map) as map_file:
+        _, sections = footprint.parse_map(map_file.read())
+    stack_size = sum(size for name, _, size, _ in sections if name == ".stack")
+    sources = sorted(glob.glob(os.path.join(config_dir, config["sources"])))
+    registered = {name: registered_functions(sources, registration)
+                  for name, registration in config["registrations"].items()}
+    dispatch = {}
+    for pattern, targets in config["dispatch"].items():
+        for name in fnmatch.filter(functions, pattern):
+            dispatch.setdefault(name, set()).update(resolve_targets(targets, functions,
+                                                                    registered))
+    analysis = Analysis(functions, frames, dispatch)
+    contexts = collections.OrderedDict()
+    for context, setup in config["contexts"].items():
+        deepest = (0, [])
+        for root in setup["roots"]:
+            if root not in functions:
+                print("{}: root {} not in image".format(args.board, root), file=sys.stderr)
+                continue
+            result = analysis.depth(root)
+            if result[0] > deepest[0]:
+                deepest = result
+        contexts[context] = {"priority": setup.get("priority"), "bytes": deepest[0],
+                             "path": ["{} {}".format(name, frame) for name, frame in deepest[1]]}
+    by_priority = {}
+    for context, result in contexts.items():
+        if result["priority"] is not None:
+            by_priority[result["priority"]] = max(by_priority.get(result["priority"], 0),
+                                                  result["bytes"])
+    thread = sum(result["bytes"] for result in contexts.values() if result["priority"] is None)
+    worst = (thread + sum(by_priority.values())
+             + len(by_priority) * config["exception_frame"] + config["softdevice"])
+    result = collections.OrderedDict([
+        ("board", args.board), ("stack_size", stack_size), ("worst_case", worst),
+        ("headroom", stack_size - worst), ("softdevice", config["softdevice"]),
+        ("contexts", contexts),
+        ("unresolved_indirect", sorted(analysis.unresolved)),
+        ("recursive", sorted(analysis.recursive)),
+        ("dynamic_frames", sorted(analysis.dynamic)),
+        ("estimated_frames", sorted(analysis.estimated & set(functions))),
+    ])
+    for context, entry in contexts.items():
+        print("{:<10}{:>6} B  {}".format(context, entry["bytes"], " > ".join(entry["path"])))
+    print("{}: worst case {} B of {} B stack, headroom {} B".format(
+        args.board, worst, stack_size, stack_size - worst))
+    for key in ("unresolved_indirect", "recursive", "dynamic_frames"):
+        if result[key]:
+            print("{}: {}".format(key.replace("_", " "), ", ".join(result[key])))
+    if args.output:
+        with open(args.output, "w") as output:
+            json.dump(result, output, indent=2)
+            output.write("\n")
+    return 1 if stack_size and worst > stack_size else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -9,7 +9,18 @@
 
 #include "app_ble.h"
 #include <string.h>
+#include "ble_gap.h"
+#include "app_config.h"
+#include "app_ch_sched.h"
+#include "app_flash.h"
+#include "app_latency.h"
+#include "app_phy_sched.h"
+#include "app_prof.h"
+#include "app_queue.h"
+#include "app_stats.h"
+#include "app_trace.h"
 #include "app_uart.h"
+#include "app_wdt.h"
 #include "ruuvi_driver_error.h"
 #include "ruuvi_boards.h"
 #include "ruuvi_interface_log.h"
@@ -17,8 +28,9 @@
 #include "ruuvi_interface_communication_radio.h"
 #include "ruuvi_interface_communication_ble_advertising.h"
 #include "ruuvi_interface_gpio.h"
+#include "ruuvi_interface_rtc.h"
 #include "ruuvi_interface_scheduler.h"
-#include "ruuvi_interface_watchdog.h"
+#include "ruuvi_interface_timer.h"
 #include "ruuvi_task_advertisement.h"
 #include "ruuvi_task_led.h"
 #if !defined(CEEDLING) && !defined(SONAR)
@@ -29,11 +41,11 @@
 #endif
 
 #define RB_BLE_UNKNOWN_MANUFACTURER_ID  0xFFFF                  //!< Unknown id
-#define RB_BLE_DEFAULT_CH37_STATE       0                       //!< Default channel 37 state
-#define RB_BLE_DEFAULT_CH38_STATE       0                       //!< Default channel 38 state
-#define RB_BLE_DEFAULT_CH39_STATE       0                       //!< Default channel 39 state
+#define RB_BLE_DEFAULT_CH37_STATE       1                       //!< Default channel 37 state
+#define RB_BLE_DEFAULT_CH38_STATE       1                       //!< Default channel 38 state
+#define RB_BLE_DEFAULT_CH39_STATE       1                       //!< Default channel 39 state
 #define RB_BLE_DEFAULT_125KBPS_STATE    false                   //!< Default 125kbps state
-#define RB_BLE_DEFAULT_1MBIT_STATE      false                   //!< Default 1mbit state
+#define RB_BLE_DEFAULT_1MBIT_STATE      true                    //!< Default 1mbit state
 #define RB_BLE_DEFAULT_2MBIT_STATE      false                   //!< Default 2mbit state
 #define RB_BLE_DEFAULT_FLTR_STATE       true                    //!< Default filter id state
 #define RB_BLE_DEFAULT_MANUFACTURER_ID  RB_BLE_MANUFACTURER_ID  //!< Default id
@@ -65,24 +77,182 @@ static app_ble_scan_t m_scan_params =
     .modulation_2mbit_enabled = RB_BLE_DEFAULT_2MBIT_STATE,
     .is_current_modulation_125kbps = false,
     .manufacturer_filter_enabled = RB_BLE_DEFAULT_FLTR_STATE,
+    .timing.interval_ms = APP_BLE_SCAN_INTERVAL_MS,
+    .timing.window_ms = APP_BLE_SCAN_WINDOW_MS,
+    .timing.timeout_ms = APP_BLE_SCAN_TIMEOUT_MS,
 };
 
+static app_ble_scan_t m_staged_params;          //!< Parameters of open transaction.
+static bool m_is_config_staging = false;        //!< True while transaction is open.
+static app_ble_commit_stats_t m_commit_stats;   //!< Statistics of committed transactions.
+static app_ble_scan_t m_radio_params;           //!< Parameters radio was initialized with.
+static bool m_is_radio_configured = false;      //!< True if m_radio_params is valid.
+static app_ble_restart_stats_t m_restart_stats; //!< Statistics of scan restarts.
+static ri_radio_channels_t m_radio_channels;    //!< Channels radio was initialized with.
+static ri_radio_modulation_t m_radio_modulation = RI_RADIO_BLE_1MBPS; //!< Modulation of radio.
+static ri_timer_id_t m_scan_timer = NULL;       //!< Ends scan windows and slots.
+static bool m_is_scan_timer_running = false;    //!< True while m_scan_timer is armed.
+static bool m_is_scan_paused = false;           //!< Scan is idle for rest of interval.
+static uint64_t m_slot_start_ms;                //!< RTC time of latest scan slot start.
+
+/**
+ * @brief Get parameters modified by setters.
+ *
+ * @return Staged parameters if a configuration transaction is open,
+ *         live scan parameters otherwise.
+ */
+static inline app_ble_scan_t * config_target (void)
+{
+    return m_is_config_staging ? &m_staged_params : &m_scan_params;
+}
+
+static inline uint16_t effective_manufacturer_id (const app_ble_scan_t * const params)
+{
+    return params->manufacturer_filter_enabled
+           ? params->manufacturer_id
+           : RB_BLE_UNKNOWN_MANUFACTURER_ID;
+}
+
+/** @brief Check if two sets of channels differ. */
+static inline bool channels_differ (const ri_radio_channels_t a,
+                                    const ri_radio_channels_t b)
+{
+    return (a.channel_37 != b.channel_37)
+           || (a.channel_38 != b.channel_38)
+           || (a.channel_39 != b.channel_39);
+}
+
+/** @brief Channels as trace argument, bit 0 for channel 37. */
+static inline uint16_t channel_bits (const ri_radio_channels_t channels)
+{
+    return (uint16_t) ( (channels.channel_37 ? 1U : 0U)
+                        | (channels.channel_38 ? 2U : 0U)
+                        | (channels.channel_39 ? 4U : 0U));
+}
+
+/**
+ * @brief Check if two sets of parameters would configure the radio differently.
+ *
+ * Manufacturer ID is ignored while the filter is disabled and the currently active
+ * modulation is runtime state rather than configuration.
+ */
+static bool scan_params_differ (const app_ble_scan_t * const p_a,
+                                const app_ble_scan_t * const p_b)
+{
+    return (effective_manufacturer_id (p_a) != effective_manufacturer_id (p_b))
+           || channels_differ (p_a->scan_channels, p_b->scan_channels)
+           || (p_a->modulation_125kbps_enabled != p_b->modulation_125kbps_enabled)
+           || (p_a->modulation_1mbit_enabled != p_b->modulation_1mbit_enabled)
+           || (p_a->modulation_2mbit_enabled != p_b->modulation_2mbit_enabled)
+           || (p_a->max_adv_length != p_b->max_adv_length);
+}
+
+/** @brief Check if timing applied by the application differs, radio is unaffected. */
+static inline bool scan_timing_differ (const app_ble_scan_timing_t * const p_a,
+                                       const app_ble_scan_timing_t * const p_b)
+{
+    return (p_a->interval_ms != p_b->interval_ms)
+           || (p_a->window_ms != p_b->window_ms)
+           || (p_a->timeout_ms != p_b->timeout_ms);
+}
+
+static inline bool scan_is_duty_cycled (const app_ble_scan_timing_t * const p_timing)
+{
+    return p_timing->window_ms < p_timing->interval_ms;
+}
+
+static inline bool scan_timing_is_valid (const app_ble_scan_timing_t * const p_timing)
+{
+    return (p_timing->window_ms >= APP_BLE_SCAN_WINDOW_MIN_MS)
+           && (p_timing->window_ms <= p_timing->interval_ms)
+           && ( (0U == p_timing->timeout_ms)
+                || (p_timing->timeout_ms >= p_timing->interval_ms));
+}
+
+/**
+ * @brief Length of scan slot timed by the application.
+ *
+ * @return Slot length in milliseconds, 0 if scan timeout of the radio driver
+ *         ends the slot.
+ */
+static inline uint32_t scan_slot_ms (const app_ble_scan_timing_t * const p_timing)
+{
+    uint32_t slot_ms = p_timing->timeout_ms;
+
+    if ( (0U == slot_ms) && scan_is_duty_cycled (p_timing))
+    {
+        // Driver timeout restarts on every resumed window and would never fire.
+        slot_ms = (APP_BLE_SCAN_DUTY_SLOT_MS > p_timing->interval_ms)
+                  ? APP_BLE_SCAN_DUTY_SLOT_MS
+                  : p_timing->interval_ms;
+    }
+
+    return slot_ms;
+}
+
+/** @brief Check if the application has to time scan windows or slots. */
+static inline bool scan_timing_is_active (const app_ble_scan_timing_t * const p_timing)
+{
+    return scan_is_duty_cycled (p_timing) || (0U != p_timing->timeout_ms);
+}
+
+static inline app_stats_id_t rx_stats_id (const ri_adv_scan_t * const p_scan)
+{
+    app_stats_id_t id = APP_STATS_RX_1M;
+
+    if (p_scan->is_coded_phy)
+    {
+        id = APP_STATS_RX_CODED;
+    }
+    else if (BLE_GAP_PHY_2MBPS == p_scan->secondary_phy)
+    {
+        id = APP_STATS_RX_2M;
+    }
+    else
+    {
+        // Legacy or extended advertisement on LE 1M PHY.
+    }
+
+    return id;
+}
+
 #ifndef CEEDLING
 static
 #endif
 void repeat_adv (void * p_data, uint16_t data_len)
 {
     rd_status_t err_code = RD_SUCCESS;
+    APP_PROF_START (APP_PROF_REPEAT_ADV);
+    app_queue_sched_done (APP_QUEUE_SRC_SCAN);
+    app_latency_adv_begin();
 
     if (sizeof (ri_adv_scan_t) == data_len)
     {
         err_code |= app_uart_send_broadcast ((ri_adv_scan_t *) p_data);
+    }
 
-        if (RD_SUCCESS == err_code)
-        {
-            (void) ri_watchdog_feed();
-        }
+    app_latency_adv_end();
+    APP_PROF_STOP (APP_PROF_REPEAT_ADV);
+}
+
+/**
+ * @brief Check if received advertisement would pass manufacturer filter of app_uart.
+ *
+ * Advertisements dropped before app_uart take a sequence number only if they
+ * would have been sent, otherwise filtered advertisements show as gaps.
+ */
+static bool scan_passes_filter (void * const p_data, const size_t data_len)
+{
+    bool is_passed = (sizeof (ri_adv_scan_t) == data_len);
+
+    if (is_passed && m_scan_params.manufacturer_filter_enabled)
+    {
+        ri_adv_scan_t * const p_scan = (ri_adv_scan_t *) p_data;
+        is_passed = (m_scan_params.manufacturer_id
+                     == ri_adv_parse_manuid (p_scan->data, p_scan->data_len));
     }
+
+    return is_passed;
 }
 
 /**
@@ -108,24 +278,69 @@ rd_status_t on_scan_isr (const ri_comm_evt_t evt, void * p_data, // -V2009
                          size_t data_len)
 {
     rd_status_t err_code = RD_SUCCESS;
+    APP_PROF_START (APP_PROF_SCAN_ISR);
 
     switch (evt)
     {
         case RI_COMM_RECEIVED:
             LOGD ("DATA\r\n");
+            app_phy_sched_on_rx();
+
+            if (sizeof (ri_adv_scan_t) == data_len)
+            {
+                const ri_adv_scan_t * const p_scan = (const ri_adv_scan_t *) p_data;
+                app_ch_sched_on_rx (p_scan->ch_index);
+                app_stats_inc (rx_stats_id (p_scan));
+            }
+
             err_code |= ri_scheduler_event_put (p_data, (uint16_t) data_len, repeat_adv);
+
+            if (RD_SUCCESS != err_code)
+            {
+                app_stats_inc (APP_STATS_DROP_SCHED_FULL);
+
+                if (scan_passes_filter (p_data, data_len))
+                {
+                    app_uart_adv_seq_drop();
+                }
+
+                app_queue_full_record (APP_QUEUE_SCHED);
+                app_trace_record (APP_TRACE_ENQUEUE_FAIL, (uint8_t) APP_QUEUE_SCHED, 0U);
+            }
+            else
+            {
+                app_queue_sched_put (APP_QUEUE_SRC_SCAN);
+                app_latency_on_rx();
+            }
+
             break;
 
         case RI_COMM_TIMEOUT:
+        {
             LOG ("Timeout\r\n");
+            app_trace_record (APP_TRACE_SCAN_TIMEOUT, 0U, 0U);
+            const uint64_t timeout_ms = ri_rtc_millis();
+            app_phy_sched_slot_complete();
             err_code |= app_ble_scan_start();
+            const uint32_t gap_ms = (uint32_t) (ri_rtc_millis() - timeout_ms);
+            m_restart_stats.last_restart_ms = timeout_ms;
+            m_restart_stats.last_gap_ms = gap_ms;
+            m_restart_stats.total_gap_ms += gap_ms;
+
+            if (gap_ms > m_restart_stats.max_gap_ms)
+            {
+                m_restart_stats.max_gap_ms = gap_ms;
+            }
+
             break;
+        }
 
         default:
             LOG ("Unknown event\r\n");
             break;
     }
 
+    APP_PROF_STOP (APP_PROF_SCAN_ISR);
     RD_ERROR_CHECK (err_code, ~RD_ERROR_FATAL);
     return err_code;
 }
@@ -133,7 +348,7 @@ rd_status_t on_scan_isr (const ri_comm_evt_t evt, void * p_data, // -V2009
 rd_status_t app_ble_manufacturer_filter_set (const bool state)
 {
     rd_status_t  err_code = RD_SUCCESS;
-    m_scan_params.manufacturer_filter_enabled = state;
+    config_target()->manufacturer_filter_enabled = state;
     return err_code;
 }
 
@@ -146,16 +361,17 @@ bool app_ble_manufacturer_filter_enabled (uint16_t * const p_manufacturer_id)
 rd_status_t app_ble_manufacturer_id_set (const uint16_t id)
 {
     rd_status_t  err_code = RD_SUCCESS;
-    m_scan_params.manufacturer_id = id;
+    config_target()->manufacturer_id = id;
     return err_code;
 }
 
 rd_status_t app_ble_channels_get (ri_radio_channels_t * p_channels)
 {
     rd_status_t  err_code = RD_SUCCESS;
-    p_channels->channel_37 = m_scan_params.scan_channels.channel_37;
-    p_channels->channel_38 = m_scan_params.scan_channels.channel_38;
-    p_channels->channel_39 = m_scan_params.scan_channels.channel_39;
+    const app_ble_scan_t * const p_params = config_target();
+    p_channels->channel_37 = p_params->scan_channels.channel_37;
+    p_channels->channel_38 = p_params->scan_channels.channel_38;
+    p_channels->channel_39 = p_params->scan_channels.channel_39;
     return err_code;
 }
 
@@ -171,7 +387,7 @@ rd_status_t app_ble_channels_set (const ri_radio_channels_t channels)
     }
     else
     {
-        m_scan_params.scan_channels = channels;
+        config_target()->scan_channels = channels;
     }
 
     return err_code;
@@ -179,7 +395,32 @@ rd_status_t app_ble_channels_set (const ri_radio_channels_t channels)
 
 void app_ble_set_max_adv_len (uint8_t max_adv_length)
 {
-    m_scan_params.max_adv_length = max_adv_length;
+    config_target()->max_adv_length = max_adv_length;
+}
+
+rd_status_t app_ble_scan_timing_set (const app_ble_scan_timing_t * const p_timing)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (NULL == p_timing)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if (!scan_timing_is_valid (p_timing))
+    {
+        err_code |= RD_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        config_target()->timing = *p_timing;
+    }
+
+    return err_code;
+}
+
+void app_ble_scan_timing_get (app_ble_scan_timing_t * const p_timing)
+{
+    *p_timing = config_target()->timing;
 }
 
 rd_status_t app_ble_modulation_enable (const ri_radio_modulation_t modulation,
@@ -192,7 +433,7 @@ rd_status_t app_ble_modulation_enable (const ri_radio_modulation_t modulation,
         case RI_RADIO_BLE_125KBPS:
             if (RB_BLE_CODED_SUPPORTED)
             {
-                m_scan_params.modulation_125kbps_enabled = enable;
+                config_target()->modulation_125kbps_enabled = enable;
             }
             else
             {
@@ -202,11 +443,11 @@ rd_status_t app_ble_modulation_enable (const ri_radio_modulation_t modulation,
             break;
 
         case RI_RADIO_BLE_1MBPS:
-            m_scan_params.modulation_1mbit_enabled = enable;
+            config_target()->modulation_1mbit_enabled = enable;
             break;
 
         case RI_RADIO_BLE_2MBPS:
-            m_scan_params.modulation_2mbit_enabled = enable;
+            config_target()->modulation_2mbit_enabled = enable;
             break;
 
         default:
@@ -217,31 +458,340 @@ rd_status_t app_ble_modulation_enable (const ri_radio_modulation_t modulation,
     return err_code;
 }
 
-static inline void next_modulation_select (void)
+rd_status_t app_ble_config_begin (void)
 {
-    if (m_scan_params.is_current_modulation_125kbps)
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (m_is_config_staging)
     {
-        if (m_scan_params.modulation_1mbit_enabled ||
-                m_scan_params.modulation_2mbit_enabled)
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        m_staged_params = m_scan_params;
+        m_is_config_staging = true;
+    }
+
+    return err_code;
+}
+
+rd_status_t app_ble_config_commit (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (!m_is_config_staging)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        const bool is_radio_changed = scan_params_differ (&m_staged_params, &m_scan_params);
+        const bool is_changed = is_radio_changed
+                                || scan_timing_differ (&m_staged_params.timing,
+                                        &m_scan_params.timing);
+        m_is_config_staging = false;
+        // Scan timeout may have switched the PHY while the transaction was open.
+        m_staged_params.is_current_modulation_125kbps =
+            m_scan_params.is_current_modulation_125kbps;
+        m_scan_params = m_staged_params;
+        m_commit_stats.commits++;
+
+        if (is_changed)
         {
-            m_scan_params.is_current_modulation_125kbps = false;
+            // Timing alone is applied on a resumed scan.
+            m_is_radio_configured = m_is_radio_configured && (!is_radio_changed);
+            const uint64_t start_ms = ri_rtc_millis();
+            err_code |= app_ble_scan_start();
+            const uint32_t downtime_ms = (uint32_t) (ri_rtc_millis() - start_ms);
+            m_commit_stats.restarts++;
+            m_commit_stats.last_downtime_ms = downtime_ms;
+            m_commit_stats.total_downtime_ms += downtime_ms;
+
+            if (downtime_ms > m_commit_stats.max_downtime_ms)
+            {
+                m_commit_stats.max_downtime_ms = downtime_ms;
+            }
+
+            NRF_LOG_INFO ("Config committed, radio down for %d ms", downtime_ms);
+
+            if (RD_SUCCESS == err_code)
+            {
+                // Storage errors are counted by app_flash, scanning continues regardless.
+                (void) app_flash_scan_params_store (&m_scan_params);
+            }
         }
-        else
+    }
+
+    return err_code;
+}
+
+rd_status_t app_ble_config_abort (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (!m_is_config_staging)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        m_is_config_staging = false;
+        m_commit_stats.aborts++;
+    }
+
+    return err_code;
+}
+
+rd_status_t app_ble_config_restore (void)
+{
+    app_ble_scan_t params = m_scan_params;
+    const rd_status_t err_code = app_flash_scan_params_load (&params);
+
+    if (RD_SUCCESS == err_code)
+    {
+        params.is_current_modulation_125kbps = m_scan_params.is_current_modulation_125kbps;
+
+        if (!scan_timing_is_valid (&params.timing))
         {
-            // No action needed.
+            params.timing = m_scan_params.timing;
         }
+
+        m_scan_params = params;
+        m_is_radio_configured = false;
+    }
+
+    return err_code;
+}
+
+void app_ble_commit_stats_get (app_ble_commit_stats_t * const p_stats)
+{
+    *p_stats = m_commit_stats;
+}
+
+void app_ble_restart_stats_get (app_ble_restart_stats_t * const p_stats)
+{
+    *p_stats = m_restart_stats;
+}
+
+ri_radio_modulation_t app_ble_modulation_get (void)
+{
+    return m_radio_modulation;
+}
+
+/**
+ * @brief End current scan slot and get modulation of the next one.
+ *
+ * @return True if next scan should be on coded PHY, false for 1M PHY.
+ */
+static inline bool next_modulation_is_125kbps (void)
+{
+    return app_phy_sched_next_is_coded (m_scan_params.is_current_modulation_125kbps,
+                                        m_scan_params.modulation_125kbps_enabled,
+                                        m_scan_params.modulation_1mbit_enabled
+                                        || m_scan_params.modulation_2mbit_enabled);
+}
+
+/**
+ * @brief Check if the scan can be resumed without reinitializing the radio.
+ *
+ * @param[in] is_next_125kbps Modulation of the next scan.
+ * @return True if radio is already initialized with current parameters on the PHY
+ *         of the next scan.
+ */
+static inline bool scan_is_resumable (const bool is_next_125kbps)
+{
+    return m_is_radio_configured
+           && (!scan_params_differ (&m_radio_params, &m_scan_params))
+           && (m_radio_params.is_current_modulation_125kbps == is_next_125kbps);
+}
+
+/**
+ * @brief Longest time from start of a scan slot to start of the next one.
+ *
+ * Slot length includes pauses of a duty cycled scan.
+ */
+static uint32_t scan_wdt_timeout (void)
+{
+    return APP_WDT_SCAN_TIMEOUT_MS + scan_slot_ms (&m_scan_params.timing);
+}
+
+static rd_status_t scan_resume (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    err_code |= rt_adv_scan_start (&on_scan_isr);
+
+    if (RD_SUCCESS != err_code)
+    {
+        // Reinitialize everything on next attempt.
+        m_is_radio_configured = false;
+    }
+    else
+    {
+        m_restart_stats.fast_restarts++;
+        app_trace_record (APP_TRACE_SCAN_START, (uint8_t) m_radio_modulation,
+                          channel_bits (m_radio_channels));
+    }
+
+    return err_code;
+}
+
+#ifndef CEEDLING
+static void on_scan_timer (void * p_data, uint16_t data_len);
+#endif
+
+/** @brief Timer runs in interrupt context, defer scan control to scheduler. */
+static void scan_timer_isr (void * const p_context)
+{
+    (void) p_context;
+    m_is_scan_timer_running = false;
+    (void) ri_scheduler_event_put (NULL, (uint16_t) 0, on_scan_timer);
+}
+
+/**
+ * @brief Arm scan timer for the current scan phase.
+ *
+ * @param[in] phase_ms Length of scan window or idle time.
+ * @param[in] now_ms Current RTC time.
+ * @return Error code from timer driver.
+ */
+static rd_status_t scan_timer_arm (const uint32_t phase_ms, const uint64_t now_ms)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    const uint32_t timeout_ms = scan_slot_ms (&m_scan_params.timing);
+    uint32_t timer_ms = phase_ms;
+
+    if (0U != timeout_ms)
+    {
+        // Phase is cut short by end of scan slot.
+        const uint64_t elapsed_ms = now_ms - m_slot_start_ms;
+        const uint32_t remaining_ms = (elapsed_ms < timeout_ms)
+                                      ? (uint32_t) (timeout_ms - elapsed_ms)
+                                      : 1U;
+
+        if (remaining_ms < timer_ms)
+        {
+            timer_ms = remaining_ms;
+        }
+    }
+
+    if (NULL == m_scan_timer)
+    {
+        err_code |= ri_timer_create (&m_scan_timer, RI_TIMER_MODE_SINGLE_SHOT,
+                                     &scan_timer_isr);
+    }
+    else if (m_is_scan_timer_running)
+    {
+        err_code |= ri_timer_stop (m_scan_timer);
     }
     else
     {
-        if (m_scan_params.modulation_125kbps_enabled)
+        // Timer is idle.
+    }
+
+    if (RD_SUCCESS == err_code)
+    {
+        err_code |= ri_timer_start (m_scan_timer, timer_ms, NULL);
+        m_is_scan_timer_running = (RD_SUCCESS == err_code);
+    }
+
+    return err_code;
+}
+
+static rd_status_t scan_timer_stop (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (m_is_scan_timer_running)
+    {
+        err_code |= ri_timer_stop (m_scan_timer);
+        m_is_scan_timer_running = false;
+    }
+
+    m_is_scan_paused = false;
+    return err_code;
+}
+
+/**
+ * @brief Start timing a new scan slot.
+ *
+ * Called after scan was started. Timer is only used if scan is duty cycled or
+ * slots have a length set by the application.
+ */
+static rd_status_t scan_timing_start (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    const app_ble_scan_timing_t * const p_timing = &m_scan_params.timing;
+    err_code |= scan_timer_stop();
+
+    if (scan_timing_is_active (p_timing))
+    {
+        m_slot_start_ms = ri_rtc_millis();
+        err_code |= scan_timer_arm (scan_is_duty_cycled (p_timing)
+                                    ? p_timing->window_ms
+                                    : p_timing->timeout_ms,
+                                    m_slot_start_ms);
+    }
+
+    return err_code;
+}
+
+#ifndef CEEDLING
+static
+#endif
+void on_scan_timer (void * p_data, uint16_t data_len)
+{
+    (void) p_data;
+    (void) data_len;
+    rd_status_t err_code = RD_SUCCESS;
+    const app_ble_scan_timing_t * const p_timing = &m_scan_params.timing;
+
+    if (scan_timing_is_active (p_timing) && scan_is_enabled (&m_scan_params))
+    {
+        const uint64_t now_ms = ri_rtc_millis();
+        const uint32_t slot_ms = scan_slot_ms (p_timing);
+
+        if ( (0U != slot_ms) && ( (now_ms - m_slot_start_ms) >= slot_ms))
+        {
+            app_trace_record (APP_TRACE_SCAN_TIMEOUT, 1U, 0U);
+
+            if (!m_is_scan_paused)
+            {
+                err_code |= rt_adv_scan_stop();
+            }
+
+            m_is_scan_paused = false;
+            app_phy_sched_slot_complete();
+            err_code |= app_ble_scan_start();
+        }
+        else if (m_is_scan_paused)
+        {
+            m_is_scan_paused = false;
+            err_code |= scan_resume();
+
+            if (RD_SUCCESS == err_code)
+            {
+                err_code |= scan_timer_arm (p_timing->window_ms, now_ms);
+            }
+            else
+            {
+                err_code = app_ble_scan_start();
+            }
+        }
+        else if (scan_is_duty_cycled (p_timing))
         {
-            m_scan_params.is_current_modulation_125kbps = true;
+            err_code |= rt_adv_scan_stop();
+            m_is_scan_paused = true;
+            const uint32_t pause_ms = (uint32_t) p_timing->interval_ms - p_timing->window_ms;
+            err_code |= scan_timer_arm (pause_ms, now_ms);
         }
         else
         {
-            // No action needed.
+            // Timer fired before end of slot.
+            err_code |= scan_timer_arm (slot_ms, now_ms);
         }
     }
+
+    RD_ERROR_CHECK (err_code, ~RD_ERROR_FATAL);
 }
 
 static rd_status_t pa_lna_ctrl (void)
@@ -266,14 +816,40 @@ rd_status_t app_ble_scan_start (void)
 {
     NRF_LOG_INFO ("app_ble_scan_start");
     rd_status_t err_code = RD_SUCCESS;
+    // Every scan start ends a scan slot of the PHY scheduler, slots which did not
+    // end on scan timeout are cut short and not sampled.
+    const bool is_next_125kbps = scan_is_enabled (&m_scan_params)
+                                 && next_modulation_is_125kbps();
+    const ri_radio_channels_t channels =
+        scan_is_enabled (&m_scan_params)
+        ? app_ch_sched_next_channels (m_scan_params.scan_channels)
+        : m_scan_params.scan_channels;
+
+    if (!scan_is_enabled (&m_scan_params))
+    {
+        err_code |= app_ble_scan_stop();
+    }
+    else if (scan_is_resumable (is_next_125kbps)
+             && (!channels_differ (m_radio_channels, channels)))
+    {
+        err_code |= scan_resume();
 
-    if (scan_is_enabled (&m_scan_params))
+        if (RD_SUCCESS == err_code)
+        {
+            // Only slot starts feed the supervisor, resumes within a slot do not.
+            app_wdt_arm (APP_WDT_SCAN, scan_wdt_timeout());
+            err_code |= scan_timing_start();
+        }
+    }
+    else
     {
+        m_is_radio_configured = false;
+        m_restart_stats.full_restarts++;
         err_code |= rt_adv_uninit();
         err_code |= ri_radio_uninit();
         rt_adv_init_t adv_params =
         {
-            .channels = m_scan_params.scan_channels,
+            .channels = channels,
             .adv_interval_ms = (1000U), //!< Unused
             .adv_pwr_dbm     = (0),     //!< Unused
             .manufacturer_id = m_scan_params.manufacturer_id,
@@ -310,30 +886,47 @@ rd_status_t app_ble_scan_start (void)
                           m_scan_params.modulation_1mbit_enabled,
                           m_scan_params.modulation_2mbit_enabled,
                           m_scan_params.modulation_125kbps_enabled);
-            next_modulation_select();
+            m_scan_params.is_current_modulation_125kbps = is_next_125kbps;
             NRF_LOG_INFO ("Current PHY: %s",
                           m_scan_params.is_current_modulation_125kbps
                           ? "LE Coded PHY"
                           : "LE 1M PHY");
+            const ri_radio_modulation_t modulation =
+                m_scan_params.is_current_modulation_125kbps ? RI_RADIO_BLE_125KBPS
+                : RI_RADIO_BLE_1MBPS;
             err_code |= pa_lna_ctrl();
-            err_code |= ri_radio_init (m_scan_params.is_current_modulation_125kbps ?
-                                       RI_RADIO_BLE_125KBPS : RI_RADIO_BLE_1MBPS);
+            err_code |= ri_radio_init (modulation);
 
             if (RD_SUCCESS == err_code)
             {
                 err_code |= rt_adv_init (&adv_params);
                 err_code |= rt_adv_scan_start (&on_scan_isr);
             }
+
+            if (RD_SUCCESS == err_code)
+            {
+                m_radio_params = m_scan_params;
+                m_radio_channels = channels;
+                m_is_radio_configured = true;
+
+                if (modulation != m_radio_modulation)
+                {
+                    app_trace_record (APP_TRACE_PHY_SWITCH, (uint8_t) modulation,
+                                      (uint16_t) m_radio_modulation);
+                    m_radio_modulation = modulation;
+                }
+
+                app_trace_record (APP_TRACE_SCAN_START, (uint8_t) modulation,
+                                  channel_bits (channels));
+                app_wdt_arm (APP_WDT_SCAN, scan_wdt_timeout());
+                err_code |= scan_timing_start();
+            }
         }
         else
         {
             NRF_LOG_ERROR ("rt_adv_uninit or ri_radio_uninit failed, err=%d", err_code);
         }
     }
-    else
-    {
-        err_code |= app_ble_scan_stop();
-    }
 
     return err_code;
 }
@@ -341,6 +934,8 @@ rd_status_t app_ble_scan_start (void)
 rd_status_t app_ble_scan_stop (void)
 {
     rd_status_t err_code = RD_SUCCESS;
+    app_wdt_disarm (APP_WDT_SCAN);
+    err_code |= scan_timer_stop();
     err_code |= rt_adv_scan_stop();
     return err_code;
 }
@@ -15,6 +15,15 @@
 #include "ruuvi_interface_communication_radio.h"
 #include "ruuvi_interface_communication_ble_advertising.h"
 
+/** @brief Scan duty cycle and slot length. */
+typedef struct
+{
+    uint16_t interval_ms; //!< Period of scan duty cycle.
+    uint16_t window_ms;   //!< Scan time in every period, interval_ms to scan continuously.
+    uint32_t timeout_ms;  //!< Length of scan slot, 0 to use scan timeout of radio driver,
+                          //!< or APP_BLE_SCAN_DUTY_SLOT_MS if scan is duty cycled.
+} app_ble_scan_timing_t;
+
 /** @brief definition of application scan parameters */
 typedef struct
 {
@@ -26,8 +35,31 @@ typedef struct
     bool manufacturer_filter_enabled;  //!< True to scan only data of one manufacturer.
     bool is_current_modulation_125kbps; //!< Modulation used currently.
     uint8_t max_adv_length;            //!< Maximum length of advertisement data
+    app_ble_scan_timing_t timing;      //!< Scan duty cycle and slot length.
 } app_ble_scan_t;
 
+/** @brief Statistics of committed configuration transactions. */
+typedef struct
+{
+    uint32_t commits;           //!< Number of committed transactions.
+    uint32_t aborts;            //!< Number of discarded transactions.
+    uint32_t restarts;          //!< Number of commits which reconfigured the radio.
+    uint32_t last_downtime_ms;  //!< Radio downtime of latest reconfiguration.
+    uint32_t max_downtime_ms;   //!< Longest radio downtime of a reconfiguration.
+    uint32_t total_downtime_ms; //!< Sum of radio downtimes of reconfigurations.
+} app_ble_commit_stats_t;
+
+/** @brief Statistics of scan restarts. */
+typedef struct
+{
+    uint32_t fast_restarts;     //!< Scans resumed on already initialized radio.
+    uint32_t full_restarts;     //!< Scans started with full radio reinitialization.
+    uint64_t last_restart_ms;   //!< RTC time of latest scan timeout.
+    uint32_t last_gap_ms;       //!< Time from latest scan timeout to scan restart.
+    uint32_t max_gap_ms;        //!< Longest time from scan timeout to scan restart.
+    uint32_t total_gap_ms;      //!< Sum of times from scan timeouts to scan restarts.
+} app_ble_restart_stats_t;
+
 /**
  * @brief Enable or disable id filter.
  *
@@ -83,6 +115,100 @@ void app_ble_set_max_adv_len (uint8_t max_adv_length);
 rd_status_t app_ble_modulation_enable (const ri_radio_modulation_t modulation,
                                        const bool enable);
 
+/**
+ * @brief Begin a configuration transaction.
+ *
+ * Setters modify a staged copy of the scan parameters until the transaction
+ * is committed, getters of the configuration return the staged values.
+ *
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_INVALID_STATE if a transaction is already open.
+ */
+rd_status_t app_ble_config_begin (void);
+
+/**
+ * @brief Commit the open configuration transaction.
+ *
+ * Staged parameters are compared to the live ones and the radio is reconfigured
+ * with a single call to app_ble_scan_start() only if the effective scan
+ * parameters differ. Radio downtime of the reconfiguration is recorded.
+ *
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_INVALID_STATE if there is no open transaction.
+ * @return Error code from app_ble_scan_start() if radio could not be reconfigured.
+ */
+rd_status_t app_ble_config_commit (void);
+
+/**
+ * @brief Discard the open configuration transaction.
+ *
+ * Staged parameters are dropped and the live configuration is kept, radio is
+ * not touched.
+ *
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_INVALID_STATE if there is no open transaction.
+ */
+rd_status_t app_ble_config_abort (void);
+
+/**
+ * @brief Restore last committed configuration from flash.
+ *
+ * Call before starting the scan to resume scanning with the configuration
+ * which was in use before reset.
+ *
+ * @retval RD_SUCCESS if configuration was restored.
+ * @return Error code from app_flash_scan_params_load() if there was no valid
+ *         configuration to restore, current configuration is kept.
+ */
+rd_status_t app_ble_config_restore (void);
+
+/**
+ * @brief Get statistics of committed configuration transactions.
+ *
+ * @param[out] p_stats Statistics.
+ */
+void app_ble_commit_stats_get (app_ble_commit_stats_t * const p_stats);
+
+/**
+ * @brief Get statistics of scan restarts.
+ *
+ * @param[out] p_stats Statistics.
+ */
+void app_ble_restart_stats_get (app_ble_restart_stats_t * const p_stats);
+
+/**
+ * @brief Get modulation radio was latest initialized with.
+ *
+ * @return Modulation of radio.
+ */
+ri_radio_modulation_t app_ble_modulation_get (void);
+
+/**
+ * @brief Set scan duty cycle and slot length.
+ *
+ * Scan is paused for interval_ms - window_ms after every window_ms of scanning.
+ * A scan slot ends after timeout_ms, and the next one is started on PHY and
+ * channels selected by schedulers. Duty cycled scan with timeout_ms 0 uses
+ * slots of APP_BLE_SCAN_DUTY_SLOT_MS. Timing is applied by the application on top
+ * of the scan interval and window of the radio driver.
+ *
+ * @param[in] p_timing Timing to set.
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_NULL if p_timing is NULL.
+ * @retval RD_ERROR_INVALID_PARAM if window_ms is shorter than
+ *                                APP_BLE_SCAN_WINDOW_MIN_MS or longer than
+ *                                interval_ms, or if timeout_ms is non-zero
+ *                                and shorter than interval_ms.
+ */
+rd_status_t app_ble_scan_timing_set (const app_ble_scan_timing_t * const p_timing);
+
+/**
+ * @brief Get scan duty cycle and slot length.
+ *
+ * @param[out] p_timing Timing of open transaction or live configuration.
+ */
+void app_ble_scan_timing_get (app_ble_scan_timing_t * const p_timing);
+
 /**
  * @brief Start a scan sequence.
  *
@@ -91,6 +217,10 @@ rd_status_t app_ble_modulation_enable (const ri_radio_modulation_t modulation,
  * callback on data. If all PHYs are disabled, calls app_ble_scan_stop() to
  * stop scanning process until any PHY is reactivated.
  *
+ * If the radio is already initialized with the current parameters on the PHY
+ * of the next scan, only the scan is resumed. Radio is reinitialized when
+ * switching between coded and 1M PHY or after parameters have changed.
+ *
  * @retval RD_SUCCESS on success.
  *
  */
@@ -123,6 +253,7 @@ rd_status_t app_ble_scan_stop (void);
 rd_status_t on_scan_isr (const ri_comm_evt_t evt, void * p_data, // -V2009
                          size_t data_len);
 void repeat_adv (void * p_data, uint16_t data_len);
+void on_scan_timer (void * p_data, uint16_t data_len);
 #endif
 
 #endif
@@ -0,0 +1,111 @@
+/**
+ * @addtogroup APP_CAPTURE
+ * @{
+ */
+/**
+ *  @file app_capture.c
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Capture records of received advertisements.
+ */
+#include "app_capture.h"
+#include <stdbool.h>
+#include <string.h>
+
+rd_status_t app_capture_encode (uint8_t * const p_buffer, size_t * const p_len,
+                                const uint32_t time_ms, const ri_adv_scan_t * const p_scan)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if ( (NULL == p_buffer) || (NULL == p_len) || (NULL == p_scan))
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if ( (p_scan->data_len > UINT8_MAX)
+              || (*p_len < (APP_CAPTURE_HEADER_LEN + p_scan->data_len)))
+    {
+        err_code |= RD_ERROR_DATA_SIZE;
+    }
+    else
+    {
+        size_t index = 0;
+
+        for (size_t ii = 0; ii < sizeof (time_ms); ii++)
+        {
+            p_buffer[index++] = (uint8_t) (time_ms >> (8U * ii));
+        }
+
+        memcpy (&p_buffer[index], p_scan->addr, sizeof (p_scan->addr));
+        index += sizeof (p_scan->addr);
+        p_buffer[index++] = (uint8_t) p_scan->rssi;
+        p_buffer[index++] = p_scan->primary_phy;
+        p_buffer[index++] = p_scan->secondary_phy;
+        p_buffer[index++] = p_scan->ch_index;
+        p_buffer[index++] = p_scan->is_coded_phy ? 1U : 0U;
+        p_buffer[index++] = (uint8_t) p_scan->tx_power;
+        p_buffer[index++] = (uint8_t) p_scan->data_len;
+        memcpy (&p_buffer[index], p_scan->data, p_scan->data_len);
+        *p_len = index + p_scan->data_len;
+    }
+
+    return err_code;
+}
+
+rd_status_t app_capture_decode (const uint8_t * const p_buffer, size_t * const p_len,
+                                uint32_t * const p_time_ms, ri_adv_scan_t * const p_scan)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if ( (NULL == p_buffer) || (NULL == p_len) || (NULL == p_time_ms) || (NULL == p_scan))
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if (*p_len < APP_CAPTURE_HEADER_LEN)
+    {
+        err_code |= RD_ERROR_DATA_SIZE;
+    }
+    else
+    {
+        const size_t data_len = p_buffer[APP_CAPTURE_DATA_LEN_IDX];
+        const size_t record_len = APP_CAPTURE_HEADER_LEN + data_len;
+
+        if (*p_len < record_len)
+        {
+            err_code |= RD_ERROR_DATA_SIZE;
+        }
+        else if (data_len > sizeof (p_scan->data))
+        {
+            err_code |= RD_ERROR_INVALID_LENGTH;
+        }
+        else
+        {
+            size_t index = 0;
+            memset (p_scan, 0, sizeof (*p_scan));
+            *p_time_ms = 0;
+
+            for (size_t ii = 0; ii < sizeof (*p_time_ms); ii++)
+            {
+                *p_time_ms |= (uint32_t) p_buffer[index++] << (8U * ii);
+            }
+
+            memcpy (p_scan->addr, &p_buffer[index], sizeof (p_scan->addr));
+            index += sizeof (p_scan->addr);
+            p_scan->rssi = (int8_t) p_buffer[index++];
+            p_scan->primary_phy = p_buffer[index++];
+            p_scan->secondary_phy = p_buffer[index++];
+            p_scan->ch_index = p_buffer[index++];
+            p_scan->is_coded_phy = (0U != p_buffer[index++]);
+            p_scan->tx_power = (int8_t) p_buffer[index++];
+            index++;
+            memcpy (p_scan->data, &p_buffer[index], data_len);
+            p_scan->data_len = data_len;
+        }
+
+        *p_len = record_len;
+    }
+
+    return err_code;
+}
+
+/** @} */
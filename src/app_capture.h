@@ -0,0 +1,72 @@
+#ifndef APP_CAPTURE_H
+#define APP_CAPTURE_H
+
+/**
+ * @defgroup APP_CAPTURE Capture of received advertisements.
+ * @{
+ */
+/**
+ *  @file app_capture.h
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Compact binary records of advertisements as given by the scanner, for
+ *  replaying real traffic into the host simulation.
+ *
+ *  While capture is enabled with APP_UART_EXT_SET_CAPTURE the gateway sends
+ *  every received advertisement as one record in an APP_UART_EXT_CAPTURE
+ *  frame, before any filtering. A capture file is APP_CAPTURE_FILE_MAGIC
+ *  followed by the records back to back.
+ *
+ *  Record: reception time u32 in milliseconds of dongle RTC, MAC address
+ *  6 bytes, RSSI i8, primary PHY u8, secondary PHY u8, channel u8, is coded
+ *  PHY u8, TX power i8, data length u8, data. PHYs and TX power are the
+ *  values of ri_adv_scan_t, so a replayed record is the scan it was made of.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ruuvi_driver_error.h"
+#include "ruuvi_interface_communication_ble_advertising.h"
+
+/** @brief Bytes of record before advertisement data. */
+#define APP_CAPTURE_HEADER_LEN (17U)
+/** @brief Index of data length in record. */
+#define APP_CAPTURE_DATA_LEN_IDX (APP_CAPTURE_HEADER_LEN - 1U)
+/** @brief Longest record. */
+#define APP_CAPTURE_RECORD_MAX_LEN (APP_CAPTURE_HEADER_LEN + UINT8_MAX)
+/** @brief Start of capture file, including the terminating zero byte. */
+#define APP_CAPTURE_FILE_MAGIC "RGWCAP1"
+
+/**
+ * @brief Encode a record.
+ *
+ * @param[out] p_buffer Buffer to encode to.
+ * @param[in,out] p_len In: size of buffer. Out: length of record.
+ * @param[in] time_ms Reception time.
+ * @param[in] p_scan Received advertisement.
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_NULL if any pointer is NULL.
+ * @retval RD_ERROR_DATA_SIZE if record does not fit in buffer.
+ */
+rd_status_t app_capture_encode (uint8_t * const p_buffer, size_t * const p_len,
+                                const uint32_t time_ms, const ri_adv_scan_t * const p_scan);
+
+/**
+ * @brief Decode a record.
+ *
+ * @param[in] p_buffer Data starting with a record.
+ * @param[in,out] p_len In: bytes of data. Out: length of record.
+ * @param[out] p_time_ms Reception time.
+ * @param[out] p_scan Received advertisement.
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_NULL if any pointer is NULL.
+ * @retval RD_ERROR_DATA_SIZE if data ends before record, p_len is length
+ *                            of record if known.
+ * @retval RD_ERROR_INVALID_LENGTH if advertisement does not fit in p_scan.
+ */
+rd_status_t app_capture_decode (const uint8_t * const p_buffer, size_t * const p_len,
+                                uint32_t * const p_time_ms, ri_adv_scan_t * const p_scan);
+
+/** @} */
+#endif // APP_CAPTURE_H
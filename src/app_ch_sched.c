@@ -0,0 +1,218 @@
+/**
+ * @addtogroup APP_CH_SCHED
+ * @{
+ */
+/**
+ *  @file app_ch_sched.c
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Adaptive primary channel weighting.
+ */
+#include "app_config.h"
+#include "app_ch_sched.h"
+#include <string.h>
+
+#define APP_CH_SCHED_FIRST_CH      (37U) //!< Index of first primary channel.
+/** @brief Weight of newest slot in yield average is 1 / 2^shift. */
+#define APP_CH_SCHED_EWMA_SHIFT    (2U)
+/** @brief Fixed point scaling of yield average. */
+#define APP_CH_SCHED_YIELD_SCALE   (16U)
+/** @brief Limit normalized packets of one slot so that scaled yield fits uint16_t. */
+#define APP_CH_SCHED_SLOT_PACKETS_MAX (UINT16_MAX / APP_CH_SCHED_YIELD_SCALE)
+
+static app_ch_sched_cfg_t m_cfg =
+{
+    .is_adaptive = APP_CH_SCHED_ADAPTIVE_ENABLED,
+    .round_slots = APP_CH_SCHED_ROUND_SLOTS,
+    .min_slots = APP_CH_SCHED_MIN_SLOTS
+};
+
+static app_ch_sched_stats_t m_stats;
+static volatile uint32_t m_slot_packets[APP_CH_SCHED_NUM]; //!< Packets of current slot.
+static bool m_current[APP_CH_SCHED_NUM];  //!< Channels of current slot.
+static bool m_enabled[APP_CH_SCHED_NUM];  //!< Enabled channels of current round.
+static uint8_t m_slot;                    //!< Slot index in current round.
+static bool m_is_round_started = false;   //!< False until first round is allocated.
+
+static void channels_to_array (const ri_radio_channels_t channels,
+                               bool * const p_array)
+{
+    p_array[APP_CH_SCHED_37] = (0U != channels.channel_37);
+    p_array[APP_CH_SCHED_38] = (0U != channels.channel_38);
+    p_array[APP_CH_SCHED_39] = (0U != channels.channel_39);
+}
+
+static ri_radio_channels_t array_to_channels (const bool * const p_array)
+{
+    ri_radio_channels_t channels = {0};
+    channels.channel_37 = p_array[APP_CH_SCHED_37] ? 1U : 0U;
+    channels.channel_38 = p_array[APP_CH_SCHED_38] ? 1U : 0U;
+    channels.channel_39 = p_array[APP_CH_SCHED_39] ? 1U : 0U;
+    return channels;
+}
+
+static void slot_end (void)
+{
+    uint32_t active = 0;
+
+    for (size_t ch = 0; ch < APP_CH_SCHED_NUM; ch++)
+    {
+        active += m_current[ch] ? 1U : 0U;
+    }
+
+    for (size_t ch = 0; ch < APP_CH_SCHED_NUM; ch++)
+    {
+        const uint32_t packets = m_slot_packets[ch];
+        m_slot_packets[ch] = 0;
+        m_stats.ch[ch].packets += packets;
+
+        if (m_current[ch])
+        {
+            app_ch_sched_ch_stats_t * const p_ch = &m_stats.ch[ch];
+            // Channel had 1 / active of the slot, scale to a full slot.
+            uint32_t normalized = packets * active;
+
+            if (normalized > APP_CH_SCHED_SLOT_PACKETS_MAX)
+            {
+                normalized = APP_CH_SCHED_SLOT_PACKETS_MAX;
+            }
+
+            const int32_t sample = (int32_t) (normalized * APP_CH_SCHED_YIELD_SCALE);
+            const int32_t yield = (int32_t) p_ch->yield_x16;
+            const int32_t delta = (sample - yield) / (1 << APP_CH_SCHED_EWMA_SHIFT);
+            p_ch->yield_x16 = (uint16_t) (yield + delta);
+            p_ch->slots++;
+        }
+    }
+}
+
+/**
+ * @brief Allocate slots of a new round.
+ *
+ * Best channel is scanned on every slot, others in proportion to their yield
+ * relative to the best one. Without any yield all channels get every slot.
+ */
+static void round_start (void)
+{
+    uint32_t best = 0;
+
+    for (size_t ch = 0; ch < APP_CH_SCHED_NUM; ch++)
+    {
+        if (m_enabled[ch] && (m_stats.ch[ch].yield_x16 > best))
+        {
+            best = m_stats.ch[ch].yield_x16;
+        }
+    }
+
+    for (size_t ch = 0; ch < APP_CH_SCHED_NUM; ch++)
+    {
+        uint32_t slots = 0;
+
+        if (!m_enabled[ch])
+        {
+            // Channel is not scanned.
+        }
+        else if ( (!m_cfg.is_adaptive) || (0U == best))
+        {
+            slots = m_cfg.round_slots;
+        }
+        else
+        {
+            // Round to nearest.
+            slots = ( ( (uint32_t) m_cfg.round_slots * m_stats.ch[ch].yield_x16)
+                      + (best / 2U)) / best;
+
+            if (slots < m_cfg.min_slots)
+            {
+                slots = m_cfg.min_slots;
+            }
+        }
+
+        m_stats.ch[ch].alloc_slots = (uint8_t) slots;
+    }
+
+    m_slot = 0;
+    m_stats.rounds++;
+    m_is_round_started = true;
+}
+
+rd_status_t app_ch_sched_configure (const app_ch_sched_cfg_t * const p_cfg)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (NULL == p_cfg)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if ( (0U == p_cfg->min_slots) || (p_cfg->round_slots < p_cfg->min_slots))
+    {
+        err_code |= RD_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        m_cfg = *p_cfg;
+    }
+
+    return err_code;
+}
+
+void app_ch_sched_config_get (app_ch_sched_cfg_t * const p_cfg)
+{
+    *p_cfg = m_cfg;
+}
+
+void app_ch_sched_on_rx (const uint8_t ch_index)
+{
+    if ( (ch_index >= APP_CH_SCHED_FIRST_CH)
+            && (ch_index < (APP_CH_SCHED_FIRST_CH + APP_CH_SCHED_NUM)))
+    {
+        m_slot_packets[ch_index - APP_CH_SCHED_FIRST_CH]++;
+    }
+}
+
+ri_radio_channels_t app_ch_sched_next_channels (const ri_radio_channels_t enabled)
+{
+    bool enabled_array[APP_CH_SCHED_NUM];
+    bool is_any = false;
+    channels_to_array (enabled, enabled_array);
+    slot_end();
+    m_slot++;
+
+    if ( (!m_is_round_started) || (m_slot >= m_cfg.round_slots)
+            || (0 != memcmp (enabled_array, m_enabled, sizeof (m_enabled))))
+    {
+        memcpy (m_enabled, enabled_array, sizeof (m_enabled));
+        round_start();
+    }
+
+    for (size_t ch = 0; ch < APP_CH_SCHED_NUM; ch++)
+    {
+        m_current[ch] = m_enabled[ch] && (m_slot < m_stats.ch[ch].alloc_slots);
+        is_any = is_any || m_current[ch];
+    }
+
+    if (!is_any)
+    {
+        memcpy (m_current, m_enabled, sizeof (m_current));
+    }
+
+    return array_to_channels (m_current);
+}
+
+void app_ch_sched_stats_get (app_ch_sched_stats_t * const p_stats)
+{
+    *p_stats = m_stats;
+}
+
+void app_ch_sched_reset (void)
+{
+    memset (&m_stats, 0, sizeof (m_stats));
+    memset ( (void *) m_slot_packets, 0, sizeof (m_slot_packets));
+    memset (m_current, 0, sizeof (m_current));
+    memset (m_enabled, 0, sizeof (m_enabled));
+    m_slot = 0;
+    m_is_round_started = false;
+}
+
+/** @} */
@@ -0,0 +1,109 @@
+#ifndef APP_CH_SCHED_H
+#define APP_CH_SCHED_H
+
+/**
+ * @defgroup APP_CH_SCHED Adaptive primary channel weighting.
+ * @{
+ */
+/**
+ *  @file app_ch_sched.h
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Select primary advertising channels of each scan slot.
+ *
+ *  The radio rotates through all channels enabled for a scan slot, so the
+ *  share of scan time on a channel is adjusted by leaving it out of some
+ *  slots. Packet yield of each channel is tracked per slot, normalized by
+ *  the number of channels sharing the slot. In every round of slots the most
+ *  productive channel is scanned on all slots and others on a number of slots
+ *  proportional to their yield relative to it, at least the configured
+ *  minimum.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ruuvi_driver_error.h"
+#include "ruuvi_interface_communication_radio.h"
+
+/** @brief Primary advertising channels. */
+typedef enum
+{
+    APP_CH_SCHED_37 = 0, //!< Channel 37.
+    APP_CH_SCHED_38,     //!< Channel 38.
+    APP_CH_SCHED_39,     //!< Channel 39.
+    APP_CH_SCHED_NUM     //!< Number of primary channels.
+} app_ch_sched_ch_t;
+
+/** @brief Scheduler configuration. */
+typedef struct
+{
+    bool is_adaptive;     //!< False to scan all enabled channels on every slot.
+    uint8_t round_slots;  //!< Slots in one round.
+    uint8_t min_slots;    //!< Minimum slots of an enabled channel in one round.
+} app_ch_sched_cfg_t;
+
+/** @brief Statistics of one channel. */
+typedef struct
+{
+    uint32_t slots;       //!< Number of completed slots which included the channel.
+    uint32_t packets;     //!< Number of packets received on the channel.
+    uint16_t yield_x16;   //!< Average packets per slot spent on the channel only, x16.
+    uint8_t alloc_slots;  //!< Slots of the channel in current round.
+} app_ch_sched_ch_stats_t;
+
+/** @brief Statistics of all channels. */
+typedef struct
+{
+    app_ch_sched_ch_stats_t ch[APP_CH_SCHED_NUM]; //!< Indexed by app_ch_sched_ch_t.
+    uint32_t rounds; //!< Number of started rounds.
+} app_ch_sched_stats_t;
+
+/**
+ * @brief Configure the scheduler.
+ *
+ * Takes effect at start of the next round.
+ *
+ * @param[in] p_cfg New configuration.
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_NULL if p_cfg is NULL.
+ * @retval RD_ERROR_INVALID_PARAM if min_slots is 0 or greater than round_slots.
+ */
+rd_status_t app_ch_sched_configure (const app_ch_sched_cfg_t * const p_cfg);
+
+/**
+ * @brief Get current configuration.
+ *
+ * @param[out] p_cfg Current configuration.
+ */
+void app_ch_sched_config_get (app_ch_sched_cfg_t * const p_cfg);
+
+/**
+ * @brief Count a packet received in current slot.
+ *
+ * Safe to call from interrupt context.
+ *
+ * @param[in] ch_index Channel packet was received on, secondary channels are ignored.
+ */
+void app_ch_sched_on_rx (const uint8_t ch_index);
+
+/**
+ * @brief End current slot and select channels of the next slot.
+ *
+ * @param[in] enabled Channels enabled by configuration.
+ * @return Channels to scan on next slot, a non-empty subset of enabled.
+ */
+ri_radio_channels_t app_ch_sched_next_channels (const ri_radio_channels_t enabled);
+
+/**
+ * @brief Get statistics of channels.
+ *
+ * @param[out] p_stats Statistics.
+ */
+void app_ch_sched_stats_get (app_ch_sched_stats_t * const p_stats);
+
+/** @brief Reset yield history and statistics, configuration is kept. */
+void app_ch_sched_reset (void);
+
+/** @} */
+#endif
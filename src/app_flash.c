@@ -0,0 +1,253 @@
+/**
+ * @addtogroup APP_FLASH
+ * @{
+ */
+/**
+ *  @file app_flash.c
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Persist last applied scan configuration.
+ */
+#include "app_config.h"
+#include "app_flash.h"
+#include <string.h>
+#include "app_ble.h"
+#include "ruuvi_driver_error.h"
+#include "ruuvi_interface_flash.h"
+
+#define APP_FLASH_SCAN_FILE_ID   (0xA5U) //!< Flash page of scan configuration.
+#define APP_FLASH_SCAN_RECORD_ID (0x01U) //!< Record of scan configuration.
+/** @brief Increment when layout of app_ble_scan_t changes. */
+#define APP_FLASH_SCAN_VERSION   (2U)
+
+/** @brief Stored scan configuration. */
+typedef struct
+{
+    uint16_t version;      //!< APP_FLASH_SCAN_VERSION of writing firmware.
+    uint16_t params_size;  //!< Size of app_ble_scan_t of writing firmware.
+    app_ble_scan_t params; //!< Scan configuration.
+} app_flash_scan_record_t;
+
+/** @brief Flash records are written as whole words. */
+typedef union
+{
+    app_flash_scan_record_t record;                                 //!< Record.
+    uint32_t words[(sizeof (app_flash_scan_record_t) + 3U) / 4U];   //!< Alignment.
+} app_flash_scan_storage_t;
+
+/** @brief State of asynchronous store. */
+typedef enum
+{
+    APP_FLASH_STATE_IDLE = 0, //!< No flash operation in progress.
+    APP_FLASH_STATE_GC,       //!< Garbage collection runs, record is written after it.
+    APP_FLASH_STATE_WRITE,    //!< Write of m_stored runs.
+} app_flash_state_e;
+
+/** @brief Copy of record in flash, source of writes until they complete. */
+static app_flash_scan_storage_t m_stored;
+static bool m_is_stored_valid = false;    //!< True if m_stored matches flash.
+static app_flash_state_e m_state = APP_FLASH_STATE_IDLE;
+static app_ble_scan_t m_next;             //!< Configuration to store after current write.
+static bool m_is_next_pending = false;    //!< True if m_next waits for current write.
+static app_flash_stats_t m_stats;
+
+/**
+ * @brief Build record to store.
+ *
+ * Fields are copied one by one into zeroed storage, padding of app_ble_scan_t
+ * is not copied and records of equal configurations compare equal.
+ */
+static void scan_record_build (app_flash_scan_storage_t * const p_storage,
+                               const app_ble_scan_t * const p_params)
+{
+    app_ble_scan_t * const p_record = &p_storage->record.params;
+    memset (p_storage, 0, sizeof (*p_storage));
+    p_storage->record.version = APP_FLASH_SCAN_VERSION;
+    p_storage->record.params_size = (uint16_t) sizeof (app_ble_scan_t);
+    p_record->manufacturer_id = p_params->manufacturer_id;
+    p_record->scan_channels.channel_37 = p_params->scan_channels.channel_37;
+    p_record->scan_channels.channel_38 = p_params->scan_channels.channel_38;
+    p_record->scan_channels.channel_39 = p_params->scan_channels.channel_39;
+    p_record->modulation_125kbps_enabled = p_params->modulation_125kbps_enabled;
+    p_record->modulation_1mbit_enabled = p_params->modulation_1mbit_enabled;
+    p_record->modulation_2mbit_enabled = p_params->modulation_2mbit_enabled;
+    p_record->manufacturer_filter_enabled = p_params->manufacturer_filter_enabled;
+    // Runtime state, not configuration.
+    p_record->is_current_modulation_125kbps = false;
+    p_record->max_adv_length = p_params->max_adv_length;
+    p_record->timing.interval_ms = p_params->timing.interval_ms;
+    p_record->timing.window_ms = p_params->timing.window_ms;
+    p_record->timing.timeout_ms = p_params->timing.timeout_ms;
+}
+
+/** @brief Start write of configuration, completed by app_flash_process. */
+static rd_status_t store_start (const app_ble_scan_t * const p_params)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    app_flash_scan_storage_t storage;
+    scan_record_build (&storage, p_params);
+
+    if (m_is_stored_valid && (0 == memcmp (&storage, &m_stored, sizeof (storage))))
+    {
+        m_stats.skipped++;
+    }
+    else
+    {
+        // Flash reads the record after this function has returned,
+        // write from static copy which is kept until the write completes.
+        m_stored = storage;
+        m_is_stored_valid = false;
+        err_code |= ri_flash_record_set (APP_FLASH_SCAN_FILE_ID, APP_FLASH_SCAN_RECORD_ID,
+                                         sizeof (m_stored), &m_stored);
+
+        if (RD_ERROR_NO_MEM == err_code)
+        {
+            // Erase old versions of the record, write is retried once GC completes.
+            err_code = ri_flash_gc_run();
+
+            if (RD_SUCCESS == err_code)
+            {
+                m_state = APP_FLASH_STATE_GC;
+            }
+        }
+        else if (RD_SUCCESS == err_code)
+        {
+            m_state = APP_FLASH_STATE_WRITE;
+        }
+
+        if (RD_SUCCESS != err_code)
+        {
+            m_stats.errors++;
+        }
+    }
+
+    return err_code;
+}
+
+rd_status_t app_flash_init (void)
+{
+    rd_status_t err_code = ri_flash_init();
+
+    if (RD_ERROR_INVALID_STATE == err_code)
+    {
+        // Already initialized.
+        err_code = RD_SUCCESS;
+    }
+
+    m_is_stored_valid = false;
+    m_state = APP_FLASH_STATE_IDLE;
+    m_is_next_pending = false;
+    memset (&m_stats, 0, sizeof (m_stats));
+    return err_code;
+}
+
+rd_status_t app_flash_scan_params_load (app_ble_scan_t * const p_params)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    app_flash_scan_storage_t storage;
+
+    if (NULL == p_params)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else
+    {
+        memset (&storage, 0, sizeof (storage));
+        err_code |= ri_flash_record_get (APP_FLASH_SCAN_FILE_ID, APP_FLASH_SCAN_RECORD_ID,
+                                         sizeof (storage), &storage);
+
+        if (RD_SUCCESS == err_code)
+        {
+            if ( (APP_FLASH_SCAN_VERSION != storage.record.version)
+                    || (sizeof (app_ble_scan_t) != storage.record.params_size))
+            {
+                err_code |= RD_ERROR_INVALID_DATA;
+            }
+            else
+            {
+                *p_params = storage.record.params;
+
+                if (APP_FLASH_STATE_IDLE == m_state)
+                {
+                    m_stored = storage;
+                    m_is_stored_valid = true;
+                }
+            }
+        }
+    }
+
+    return err_code;
+}
+
+rd_status_t app_flash_scan_params_store (const app_ble_scan_t * const p_params)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (NULL == p_params)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if (APP_FLASH_STATE_IDLE != m_state)
+    {
+        // Source of the running write must not change, store latest configuration after it.
+        m_next = *p_params;
+        m_is_next_pending = true;
+    }
+    else
+    {
+        err_code |= store_start (p_params);
+    }
+
+    return err_code;
+}
+
+void app_flash_process (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if ( (APP_FLASH_STATE_IDLE != m_state) && !ri_flash_is_busy())
+    {
+        if (APP_FLASH_STATE_GC == m_state)
+        {
+            err_code |= ri_flash_record_set (APP_FLASH_SCAN_FILE_ID,
+                                             APP_FLASH_SCAN_RECORD_ID,
+                                             sizeof (m_stored), &m_stored);
+
+            if (RD_SUCCESS == err_code)
+            {
+                m_state = APP_FLASH_STATE_WRITE;
+            }
+            else
+            {
+                m_stats.errors++;
+                m_state = APP_FLASH_STATE_IDLE;
+            }
+        }
+        else
+        {
+            m_is_stored_valid = true;
+            m_stats.writes++;
+            m_state = APP_FLASH_STATE_IDLE;
+        }
+
+        if ( (APP_FLASH_STATE_IDLE == m_state) && m_is_next_pending)
+        {
+            m_is_next_pending = false;
+            // Errors are counted in statistics, there is no caller to report to.
+            (void) store_start (&m_next);
+        }
+    }
+}
+
+bool app_flash_is_busy (void)
+{
+    return (APP_FLASH_STATE_IDLE != m_state);
+}
+
+void app_flash_stats_get (app_flash_stats_t * const p_stats)
+{
+    *p_stats = m_stats;
+}
+
+/** @} */
@@ -0,0 +1,96 @@
+#ifndef APP_FLASH_H
+#define APP_FLASH_H
+
+/**
+ * @defgroup APP_FLASH Application flash storage.
+ * @{
+ */
+/**
+ *  @file app_flash.h
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Persist last applied scan configuration, so that scanning can resume right
+ *  after reset without waiting for the configuration from ESP32. Only boards
+ *  with pages reserved for application data store the configuration, see
+ *  RI_FLASH_ENABLED.
+ *
+ *  Configuration is stored as a single record through Ruuvi flash interface.
+ *  The interface is log-structured: every update is appended to the page and
+ *  old versions are erased by garbage collection, which spreads erases over all
+ *  pages reserved for application data. Writes are skipped if the configuration
+ *  has not changed since the last write to reduce wear further.
+ */
+
+#include "ruuvi_driver_error.h"
+#include "app_ble.h"
+
+/** @brief Statistics of flash storage. */
+typedef struct
+{
+    uint32_t writes;  //!< Number of records written.
+    uint32_t skipped; //!< Number of writes skipped, configuration was unchanged.
+    uint32_t errors;  //!< Number of failed writes.
+} app_flash_stats_t;
+
+/**
+ * @brief Initialize flash storage.
+ *
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_NOT_SUPPORTED if flash is not enabled on this board.
+ * @return Error code from flash driver.
+ */
+rd_status_t app_flash_init (void);
+
+/**
+ * @brief Load last stored scan configuration.
+ *
+ * @param[out] p_params Stored parameters, not modified on error.
+ * @retval RD_SUCCESS if valid configuration was loaded.
+ * @retval RD_ERROR_NULL if p_params is NULL.
+ * @retval RD_ERROR_NOT_FOUND if configuration has not been stored.
+ * @retval RD_ERROR_INVALID_DATA if stored configuration is from incompatible
+ *                               firmware version.
+ * @return Error code from flash driver.
+ */
+rd_status_t app_flash_scan_params_load (app_ble_scan_t * const p_params);
+
+/**
+ * @brief Store scan configuration.
+ *
+ * Write is skipped if the configuration equals the last stored one.
+ * Starts the write and returns, app_flash_process() completes it.
+ * Runs garbage collection and retries once if flash is full. If a write is
+ * already in progress, the configuration is stored after it completes and
+ * overrides any earlier configuration waiting for the write.
+ *
+ * @param[in] p_params Parameters to store, copied before return.
+ * @retval RD_SUCCESS if write was started, queued or not needed.
+ * @retval RD_ERROR_NULL if p_params is NULL.
+ * @return Error code from flash driver.
+ */
+rd_status_t app_flash_scan_params_store (const app_ble_scan_t * const p_params);
+
+/**
+ * @brief Complete writes started by app_flash_scan_params_store().
+ *
+ * Call from main loop, flash events wake the loop when operations complete.
+ */
+void app_flash_process (void);
+
+/**
+ * @brief Check if a write started by app_flash_scan_params_store() is in progress.
+ *
+ * @retval true if write has not completed yet.
+ */
+bool app_flash_is_busy (void);
+
+/**
+ * @brief Get statistics of flash storage.
+ *
+ * @param[out] p_stats Statistics.
+ */
+void app_flash_stats_get (app_flash_stats_t * const p_stats);
+
+/** @} */
+#endif
@@ -0,0 +1,150 @@
+/**
+ * @addtogroup APP_LATENCY
+ * @{
+ */
+/**
+ *  @file app_latency.c
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Advertisement latency histogram.
+ */
+#include "app_config.h"
+#include "app_latency.h"
+#include <string.h>
+#include "ruuvi_interface_rtc.h"
+
+/** @brief Queued reception times, must be a power of two. */
+#define APP_LATENCY_RX_DEPTH  (16U)
+/** @brief Frames tracked in UART driver, must be a power of two. */
+#define APP_LATENCY_TX_DEPTH  (16U)
+
+_Static_assert (APP_LATENCY_RX_DEPTH >= RI_SCHEDULER_LENGTH,
+                "Every advertisement in scheduler queue needs a timestamp.");
+
+/** @brief Reception time of a frame in UART driver. */
+typedef struct
+{
+    uint32_t rx_ms;   //!< Reception time of advertisement.
+    bool is_adv;      //!< False if frame does not carry an advertisement.
+} app_latency_frame_t;
+
+// Written by scan interrupt: m_rx_ms, m_rx_head. Read by scheduler: m_rx_tail.
+static volatile uint32_t m_rx_ms[APP_LATENCY_RX_DEPTH];
+static volatile uint8_t m_rx_head;
+static volatile uint8_t m_rx_tail;
+static app_latency_frame_t m_current;    //!< Advertisement being handled.
+static app_latency_frame_t m_tx[APP_LATENCY_TX_DEPTH];
+static uint8_t m_tx_head;
+static uint8_t m_tx_tail;
+static app_latency_hist_t m_hist;
+
+static uint8_t bucket_index (const uint32_t latency_ms)
+{
+    uint8_t index = 0;
+    uint32_t remaining = latency_ms;
+
+    while ( (0U != remaining) && (index < (APP_LATENCY_BUCKETS - 1U)))
+    {
+        remaining >>= 1U;
+        index++;
+    }
+
+    return index;
+}
+
+void app_latency_on_rx (void)
+{
+    const uint8_t head = m_rx_head;
+
+    if ( (uint8_t) (head - m_rx_tail) < APP_LATENCY_RX_DEPTH)
+    {
+        m_rx_ms[head & (APP_LATENCY_RX_DEPTH - 1U)] = (uint32_t) ri_rtc_millis();
+        m_rx_head = (uint8_t) (head + 1U);
+    }
+}
+
+void app_latency_adv_begin (void)
+{
+    const uint8_t tail = m_rx_tail;
+    m_current.is_adv = (tail != m_rx_head);
+
+    if (m_current.is_adv)
+    {
+        m_current.rx_ms = m_rx_ms[tail & (APP_LATENCY_RX_DEPTH - 1U)];
+        m_rx_tail = (uint8_t) (tail + 1U);
+    }
+}
+
+void app_latency_adv_end (void)
+{
+    m_current.is_adv = false;
+}
+
+bool app_latency_rx_ms_get (uint32_t * const p_rx_ms)
+{
+    if (m_current.is_adv)
+    {
+        *p_rx_ms = m_current.rx_ms;
+    }
+
+    return m_current.is_adv;
+}
+
+void app_latency_on_frame_queued (void)
+{
+    if ( (uint8_t) (m_tx_head - m_tx_tail) >= APP_LATENCY_TX_DEPTH)
+    {
+        // Sent events were lost, start over.
+        m_hist.lost += (uint8_t) (m_tx_head - m_tx_tail);
+        m_tx_tail = m_tx_head;
+    }
+
+    m_tx[m_tx_head & (APP_LATENCY_TX_DEPTH - 1U)] = m_current;
+    m_tx_head++;
+    // One advertisement is relayed in one frame.
+    m_current.is_adv = false;
+}
+
+void app_latency_on_frame_sent (void)
+{
+    if (m_tx_tail != m_tx_head)
+    {
+        const app_latency_frame_t frame = m_tx[m_tx_tail & (APP_LATENCY_TX_DEPTH - 1U)];
+        m_tx_tail++;
+
+        if (frame.is_adv)
+        {
+            const uint32_t latency_ms = (uint32_t) ri_rtc_millis() - frame.rx_ms;
+            m_hist.count++;
+            m_hist.buckets[bucket_index (latency_ms)]++;
+
+            if (latency_ms > m_hist.max_ms)
+            {
+                m_hist.max_ms = latency_ms;
+            }
+        }
+    }
+}
+
+void app_latency_get (app_latency_hist_t * const p_hist, const bool reset)
+{
+    *p_hist = m_hist;
+
+    if (reset)
+    {
+        memset (&m_hist, 0, sizeof (m_hist));
+    }
+}
+
+void app_latency_clear (void)
+{
+    memset (&m_hist, 0, sizeof (m_hist));
+    memset (&m_current, 0, sizeof (m_current));
+    m_rx_head = 0U;
+    m_rx_tail = 0U;
+    m_tx_head = 0U;
+    m_tx_tail = 0U;
+}
+
+/** @} */
@@ -0,0 +1,95 @@
+#ifndef APP_LATENCY_H
+#define APP_LATENCY_H
+
+/**
+ * @defgroup APP_LATENCY Advertisement latency histogram.
+ * @{
+ */
+/**
+ *  @file app_latency.h
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Measure time from reception of an advertisement in the scan interrupt to
+ *  completion of the UART transmission which relays it.
+ *
+ *  Reception time is queued in the scan interrupt, in the same order as
+ *  advertisements are queued to the scheduler. When the scheduler handles an
+ *  advertisement, its reception time follows the UART frame it is sent in, and
+ *  the latency is recorded when UART reports the frame sent. Frames which do not
+ *  carry an advertisement keep their place in the queue without a timestamp.
+ *
+ *  Latencies are recorded in milliseconds to a histogram of log2 buckets.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @brief Number of histogram buckets. */
+#define APP_LATENCY_BUCKETS (16U)
+
+/** @brief Latency histogram. */
+typedef struct
+{
+    uint32_t count;   //!< Number of recorded latencies.
+    uint32_t max_ms;  //!< Longest recorded latency.
+    uint32_t lost;    //!< Frames in flight when queue of timestamps overflowed.
+    /**
+     * @brief Number of latencies per bucket.
+     *
+     * Bucket 0 has latencies of 0 ms, bucket n latencies of 2^(n-1) to 2^n - 1 ms.
+     * The last bucket also has all longer latencies.
+     */
+    uint32_t buckets[APP_LATENCY_BUCKETS];
+} app_latency_hist_t;
+
+/**
+ * @brief Timestamp an advertisement queued to scheduler.
+ *
+ * Call from the scan interrupt after the advertisement was queued.
+ */
+void app_latency_on_rx (void);
+
+/**
+ * @brief Start handling the oldest queued advertisement.
+ *
+ * A frame queued to UART before app_latency_adv_end carries the reception
+ * time of the advertisement.
+ */
+void app_latency_adv_begin (void);
+
+/** @brief End handling of advertisement, which may have been filtered out. */
+void app_latency_adv_end (void);
+
+/**
+ * @brief Get reception time of the advertisement being handled.
+ *
+ * @param[out] p_rx_ms RTC time in milliseconds, truncated to 32 bits.
+ * @retval true if an advertisement is being handled.
+ * @retval false if not between app_latency_adv_begin and app_latency_adv_end.
+ */
+bool app_latency_rx_ms_get (uint32_t * const p_rx_ms);
+
+/** @brief Register a frame accepted by UART driver. */
+void app_latency_on_frame_queued (void);
+
+/** @brief Register completed UART transmission of the oldest queued frame. */
+void app_latency_on_frame_sent (void);
+
+/**
+ * @brief Get latency histogram.
+ *
+ * @param[out] p_hist Histogram.
+ * @param[in] reset True to clear histogram after read.
+ */
+void app_latency_get (app_latency_hist_t * const p_hist, const bool reset);
+
+/**
+ * @brief Clear histogram and queued timestamps.
+ *
+ * Not safe while scanning, for initialization.
+ */
+void app_latency_clear (void);
+
+/** @} */
+#endif
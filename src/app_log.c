@@ -0,0 +1,263 @@
+/**
+ * @addtogroup APP_LOG
+ * @{
+ */
+/**
+ *  @file app_log.c
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Deferred logging.
+ */
+#include "app_log.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#if !defined(CEEDLING) && !defined(SONAR)
+#include "nrf_log.h"
+#else
+#define NRF_LOG_ERROR(fmt, ...)
+#define NRF_LOG_WARNING(fmt, ...)
+#define NRF_LOG_INFO(fmt, ...)
+#define NRF_LOG_DEBUG(fmt, ...)
+#define NRF_LOG_HEXDUMP_INFO(data, len)
+#define NRF_LOG_HEXDUMP_DEBUG(data, len)
+#define NRF_LOG_PUSH(p_str) (p_str)
+#endif
+
+/** @brief Longest conversion specification, e.g. "%-08x". */
+#define APP_LOG_SPEC_MAX_LEN (8U)
+/** @brief Characters ending a conversion specification. */
+#define APP_LOG_CONVERSIONS "diuxXcs"
+/** @brief Flags and width of a conversion specification. */
+#define APP_LOG_FLAGS "-+ #0123456789"
+
+/** @brief Header of record, followed by arguments and bytes to dump. */
+typedef struct
+{
+    const char * p_fmt;              //!< Format.
+    uint8_t level;                   //!< ri_log_severity_t.
+    uint8_t argc;                    //!< Number of arguments.
+    uint8_t data_len;                //!< Bytes to dump.
+    uint8_t has_mac;                 //!< 1 if mac is set.
+    uint8_t mac[APP_LOG_MAC_LEN];    //!< MAC address for %s.
+} app_log_header_t;
+
+#if APP_LOG_DEFERRED_ENABLED
+static uint8_t m_buffer[APP_LOG_BUFFER_LEN];
+static size_t m_len;
+#endif
+static uint32_t m_dropped;
+static uint32_t m_dropped_reported;
+static char m_line[APP_LOG_LINE_MAX_LEN];
+
+static void app_log_emit (const ri_log_severity_t level, const uint8_t * const p_data,
+                          const size_t data_len)
+{
+    switch (level)
+    {
+        case RI_LOG_LEVEL_ERROR:
+            NRF_LOG_ERROR ("%s", NRF_LOG_PUSH (m_line));
+            break;
+
+        case RI_LOG_LEVEL_WARNING:
+            NRF_LOG_WARNING ("%s", NRF_LOG_PUSH (m_line));
+            break;
+
+        case RI_LOG_LEVEL_INFO:
+            NRF_LOG_INFO ("%s", NRF_LOG_PUSH (m_line));
+            break;
+
+        default:
+            NRF_LOG_DEBUG ("%s", NRF_LOG_PUSH (m_line));
+            break;
+    }
+
+    if (0U != data_len)
+    {
+        if (RI_LOG_LEVEL_DEBUG == level)
+        {
+            NRF_LOG_HEXDUMP_DEBUG (p_data, data_len);
+        }
+        else
+        {
+            NRF_LOG_HEXDUMP_INFO (p_data, data_len);
+        }
+    }
+}
+
+size_t app_log_format (char * const p_line, const size_t size, const char * const p_fmt,
+                       const uint8_t * const p_mac, const int32_t * const p_args,
+                       const uint8_t argc)
+{
+    size_t len = 0;
+    uint8_t arg = 0;
+    const char * p_next = p_fmt;
+
+    while ( ('\0' != *p_next) && ( (len + 1U) < size))
+    {
+        if ('%' != *p_next)
+        {
+            p_line[len++] = *p_next++;
+        }
+        else if ('%' == p_next[1])
+        {
+            p_line[len++] = '%';
+            p_next += 2;
+        }
+        else
+        {
+            // Copy one conversion specification and print it on its own.
+            char spec[APP_LOG_SPEC_MAX_LEN + 1U] = {0};
+            size_t spec_len = 0;
+
+            do
+            {
+                spec[spec_len++] = *p_next++;
+            } while ( ('\0' != *p_next) && (NULL != strchr (APP_LOG_FLAGS, *p_next))
+                      && (spec_len < (APP_LOG_SPEC_MAX_LEN - 1U)));
+
+            if ( ('\0' == *p_next) || (NULL == strchr (APP_LOG_CONVERSIONS, *p_next)))
+            {
+                break;
+            }
+
+            const char conversion = *p_next++;
+            spec[spec_len] = conversion;
+            const int32_t value = (arg < argc) ? p_args[arg] : 0;
+            int printed = 0;
+
+            if ('s' == conversion)
+            {
+                char mac[(APP_LOG_MAC_LEN * 3U)] = "-";
+
+                if (NULL != p_mac)
+                {
+                    (void) snprintf (mac, sizeof (mac), "%02x:%02x:%02x:%02x:%02x:%02x",
+                                     p_mac[0], p_mac[1], p_mac[2], p_mac[3], p_mac[4], p_mac[5]);
+                }
+
+                printed = snprintf (&p_line[len], size - len, spec, mac);
+            }
+            else
+            {
+                arg++;
+
+                if ( ('d' == conversion) || ('i' == conversion) || ('c' == conversion))
+                {
+                    printed = snprintf (&p_line[len], size - len, spec, (int) value);
+                }
+                else
+                {
+                    printed = snprintf (&p_line[len], size - len, spec, (unsigned int) value);
+                }
+            }
+
+            if (printed > 0)
+            {
+                len += ( (size_t) printed < (size - len)) ? (size_t) printed : (size - len - 1U);
+            }
+        }
+    }
+
+    if (0U != size)
+    {
+        p_line[len] = '\0';
+    }
+
+    return len;
+}
+
+void app_log_put (const ri_log_severity_t level, const char * const p_fmt,
+                  const uint8_t * const p_mac, const uint8_t * const p_data,
+                  const size_t data_len, const int32_t * const p_args, const uint8_t argc)
+{
+    const uint8_t args = (argc < APP_LOG_ARGS_MAX) ? argc : APP_LOG_ARGS_MAX;
+    const uint8_t dump_len = (NULL == p_data) ? 0U
+                             : ( (data_len < UINT8_MAX) ? (uint8_t) data_len : UINT8_MAX);
+
+    if ( (NULL != p_fmt) && (level <= APP_LOG_LEVEL) && (RI_LOG_LEVEL_NONE != level))
+    {
+#if APP_LOG_DEFERRED_ENABLED
+        const size_t record_len = sizeof (app_log_header_t) + (args * sizeof (int32_t))
+                                  + dump_len;
+
+        if ( (m_len + record_len) > sizeof (m_buffer))
+        {
+            m_dropped++;
+        }
+        else
+        {
+            app_log_header_t header = {0};
+            header.p_fmt = p_fmt;
+            header.level = (uint8_t) level;
+            header.argc = args;
+            header.data_len = dump_len;
+
+            if (NULL != p_mac)
+            {
+                header.has_mac = 1U;
+                memcpy (header.mac, p_mac, sizeof (header.mac));
+            }
+
+            memcpy (&m_buffer[m_len], &header, sizeof (header));
+            m_len += sizeof (header);
+            memcpy (&m_buffer[m_len], p_args, args * sizeof (int32_t));
+            m_len += args * sizeof (int32_t);
+            memcpy (&m_buffer[m_len], p_data, dump_len);
+            m_len += dump_len;
+        }
+
+#else
+        (void) app_log_format (m_line, sizeof (m_line), p_fmt, p_mac, p_args, args);
+        app_log_emit (level, p_data, dump_len);
+#endif
+    }
+}
+
+void app_log_process (void)
+{
+#if APP_LOG_DEFERRED_ENABLED
+    size_t index = 0;
+
+    while (index < m_len)
+    {
+        app_log_header_t header;
+        int32_t args[APP_LOG_ARGS_MAX];
+        memcpy (&header, &m_buffer[index], sizeof (header));
+        index += sizeof (header);
+        memcpy (args, &m_buffer[index], header.argc * sizeof (int32_t));
+        index += header.argc * sizeof (int32_t);
+        (void) app_log_format (m_line, sizeof (m_line), header.p_fmt,
+                               header.has_mac ? header.mac : NULL, args, header.argc);
+        app_log_emit ( (ri_log_severity_t) header.level, &m_buffer[index], header.data_len);
+        index += header.data_len;
+    }
+
+    m_len = 0;
+#endif
+
+    if (m_dropped != m_dropped_reported)
+    {
+        (void) snprintf (m_line, sizeof (m_line), "app_log: %u records dropped",
+                         (unsigned int) (m_dropped - m_dropped_reported));
+        app_log_emit (RI_LOG_LEVEL_WARNING, NULL, 0U);
+        m_dropped_reported = m_dropped;
+    }
+}
+
+uint32_t app_log_dropped (void)
+{
+    return m_dropped;
+}
+
+void app_log_clear (void)
+{
+#if APP_LOG_DEFERRED_ENABLED
+    m_len = 0;
+#endif
+    m_dropped = 0;
+    m_dropped_reported = 0;
+}
+
+/** @} */
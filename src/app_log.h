@@ -0,0 +1,109 @@
+#ifndef APP_LOG_H
+#define APP_LOG_H
+
+/**
+ * @defgroup APP_LOG Deferred logging of the forwarding path.
+ * @{
+ */
+/**
+ *  @file app_log.h
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Logs of the forwarding path are recorded as raw arguments and formatted
+ *  when the main loop is idle, so that debug builds forward close to the
+ *  rate of release builds.
+ *
+ *  A record keeps the format string pointer, up to APP_LOG_ARGS_MAX integer
+ *  arguments, an optional MAC address and optional bytes to dump after the
+ *  formatted line. The format supports conversions d, i, u, x, X and c with
+ *  flags and width, and s for the MAC address of the record.
+ *
+ *  Records are put and processed in thread context, i.e. from scheduler
+ *  events, not from interrupts. A record which does not fit in the buffer
+ *  is dropped and counted. With APP_LOG_DEFERRED_ENABLED 0 records are
+ *  formatted immediately, and without RI_LOG_ENABLED APP_LOG compiles out.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "app_config.h"
+#include "ruuvi_interface_log.h"
+
+/** @brief Maximum number of integer arguments of a record. */
+#define APP_LOG_ARGS_MAX (8U)
+/** @brief Longest formatted line, longer lines are truncated. */
+#define APP_LOG_LINE_MAX_LEN (160U)
+/** @brief Bytes of MAC address. */
+#define APP_LOG_MAC_LEN (6U)
+
+#if RI_LOG_ENABLED
+/**
+ * @brief Log a line with integer arguments, a MAC address and a dump of bytes.
+ *
+ * Arguments are converted to int32_t, at least one is required.
+ *
+ * @param[in] level ri_log_severity_t of the record.
+ * @param[in] p_mac MAC address printed for %s, NULL if none.
+ * @param[in] p_data Bytes dumped after the line, NULL if none.
+ * @param[in] data_len Number of bytes to dump.
+ * @param[in] p_fmt Format, a string literal.
+ */
+#   define APP_LOG(level, p_mac, p_data, data_len, p_fmt, ...) \
+        app_log_put ((level), (p_fmt), (p_mac), (p_data), (data_len), \
+                     (const int32_t[]) {__VA_ARGS__}, \
+                     (uint8_t) (sizeof ((const int32_t[]) {__VA_ARGS__}) / sizeof (int32_t)))
+#else
+#   define APP_LOG(level, p_mac, p_data, data_len, p_fmt, ...)
+#endif
+
+/**
+ * @brief Record a log line, see APP_LOG.
+ *
+ * @param[in] level ri_log_severity_t, records less severe than APP_LOG_LEVEL
+ *                  are ignored.
+ * @param[in] p_fmt Format, must stay valid until processed.
+ * @param[in] p_mac MAC address printed for %s, NULL if none.
+ * @param[in] p_data Bytes dumped after the line, NULL if none.
+ * @param[in] data_len Number of bytes to dump.
+ * @param[in] p_args Integer arguments.
+ * @param[in] argc Number of arguments, at most APP_LOG_ARGS_MAX.
+ */
+void app_log_put (const ri_log_severity_t level, const char * const p_fmt,
+                  const uint8_t * const p_mac, const uint8_t * const p_data,
+                  const size_t data_len, const int32_t * const p_args, const uint8_t argc);
+
+/**
+ * @brief Format and output recorded lines, call when idle.
+ */
+void app_log_process (void);
+
+/**
+ * @brief Format a record into a line.
+ *
+ * @param[out] p_line Buffer for zero-terminated line.
+ * @param[in] size Size of p_line.
+ * @param[in] p_fmt Format.
+ * @param[in] p_mac MAC address printed for %s, NULL if none.
+ * @param[in] p_args Integer arguments.
+ * @param[in] argc Number of arguments, missing arguments are printed as 0.
+ * @return Length of line without terminating zero.
+ */
+size_t app_log_format (char * const p_line, const size_t size, const char * const p_fmt,
+                       const uint8_t * const p_mac, const int32_t * const p_args,
+                       const uint8_t argc);
+
+/**
+ * @brief Get number of records dropped because buffer was full.
+ *
+ * @return Number of dropped records.
+ */
+uint32_t app_log_dropped (void);
+
+/**
+ * @brief Discard recorded lines and reset drop count.
+ */
+void app_log_clear (void);
+
+/** @} */
+#endif // APP_LOG_H
@@ -0,0 +1,195 @@
+/**
+ * @addtogroup APP_PHY_SCHED
+ * @{
+ */
+/**
+ *  @file app_phy_sched.c
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Adaptive PHY time-slicing.
+ */
+#include "app_config.h"
+#include "app_phy_sched.h"
+#include <string.h>
+
+/** @brief Weight of newest slot in yield average is 1 / 2^shift. */
+#define APP_PHY_SCHED_EWMA_SHIFT   (2U)
+/** @brief Fixed point scaling of yield average. */
+#define APP_PHY_SCHED_YIELD_SCALE  (16U)
+/** @brief Limit packets of one slot so that scaled yield fits uint16_t. */
+#define APP_PHY_SCHED_SLOT_PACKETS_MAX (UINT16_MAX / APP_PHY_SCHED_YIELD_SCALE)
+
+static app_phy_sched_cfg_t m_cfg =
+{
+    .is_adaptive = APP_PHY_SCHED_ADAPTIVE_ENABLED,
+    .round_slots = APP_PHY_SCHED_ROUND_SLOTS,
+    .min_slots = APP_PHY_SCHED_MIN_SLOTS
+};
+
+static app_phy_sched_stats_t m_stats;
+static volatile uint32_t m_slot_packets; //!< Packets received in current slot.
+static uint8_t m_slots_left;             //!< Slots left on current PHY.
+static bool m_is_slot_complete;          //!< Current slot ran for its full length.
+
+static inline app_phy_sched_phy_t phy_index (const bool is_coded)
+{
+    return is_coded ? APP_PHY_SCHED_CODED : APP_PHY_SCHED_1M;
+}
+
+static void slot_end (const app_phy_sched_phy_t phy)
+{
+    app_phy_sched_phy_stats_t * const p_phy = &m_stats.phy[phy];
+    // Scan ISR may count a packet between read and clear.
+    uint32_t packets = __atomic_exchange_n (&m_slot_packets, 0U, __ATOMIC_RELAXED);
+    p_phy->packets += packets;
+
+    // Packets of a slot cut short would be averaged as a full slot of low yield.
+    if (m_is_slot_complete)
+    {
+        p_phy->slots++;
+
+        if (packets > APP_PHY_SCHED_SLOT_PACKETS_MAX)
+        {
+            packets = APP_PHY_SCHED_SLOT_PACKETS_MAX;
+        }
+
+        const int32_t sample = (int32_t) (packets * APP_PHY_SCHED_YIELD_SCALE);
+        const int32_t yield = (int32_t) p_phy->yield_x16;
+        const int32_t delta = (sample - yield) / (1 << APP_PHY_SCHED_EWMA_SHIFT);
+        p_phy->yield_x16 = (uint16_t) (yield + delta);
+    }
+    else
+    {
+        p_phy->cut_slots++;
+    }
+
+    m_is_slot_complete = false;
+}
+
+/**
+ * @brief Number of consecutive slots given to a PHY on switch.
+ *
+ * Round is divided in proportion to yields, clamped so that the other PHY
+ * also gets its minimum. If neither PHY has received anything, both get the
+ * minimum to keep sampling.
+ */
+static uint8_t slots_alloc (const app_phy_sched_phy_t phy)
+{
+    uint8_t slots = 1U;
+
+    if (m_cfg.is_adaptive)
+    {
+        const uint32_t total = (uint32_t) m_stats.phy[APP_PHY_SCHED_1M].yield_x16
+                               + m_stats.phy[APP_PHY_SCHED_CODED].yield_x16;
+        const uint32_t max_slots = (uint32_t) m_cfg.round_slots - m_cfg.min_slots;
+        uint32_t share = m_cfg.min_slots;
+
+        if (total > 0U)
+        {
+            // Round to nearest.
+            share = ( ( (uint32_t) m_cfg.round_slots * m_stats.phy[phy].yield_x16)
+                      + (total / 2U)) / total;
+        }
+
+        if (share < m_cfg.min_slots)
+        {
+            share = m_cfg.min_slots;
+        }
+        else if (share > max_slots)
+        {
+            share = max_slots;
+        }
+        else
+        {
+            // Share is within limits.
+        }
+
+        slots = (uint8_t) share;
+    }
+
+    return slots;
+}
+
+rd_status_t app_phy_sched_configure (const app_phy_sched_cfg_t * const p_cfg)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (NULL == p_cfg)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if ( (0U == p_cfg->min_slots)
+              || (p_cfg->round_slots < (2U * p_cfg->min_slots)))
+    {
+        err_code |= RD_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        m_cfg = *p_cfg;
+    }
+
+    return err_code;
+}
+
+void app_phy_sched_config_get (app_phy_sched_cfg_t * const p_cfg)
+{
+    *p_cfg = m_cfg;
+}
+
+void app_phy_sched_on_rx (void)
+{
+    (void) __atomic_fetch_add (&m_slot_packets, 1U, __ATOMIC_RELAXED);
+}
+
+void app_phy_sched_slot_complete (void)
+{
+    m_is_slot_complete = true;
+}
+
+bool app_phy_sched_next_is_coded (const bool is_current_coded,
+                                  const bool is_coded_enabled,
+                                  const bool is_1m_enabled)
+{
+    bool is_next_coded = is_current_coded;
+    slot_end (phy_index (is_current_coded));
+
+    if (is_coded_enabled && is_1m_enabled)
+    {
+        if (m_slots_left > 0U)
+        {
+            m_slots_left--;
+        }
+
+        if (0U == m_slots_left)
+        {
+            is_next_coded = !is_current_coded;
+            m_slots_left = slots_alloc (phy_index (is_next_coded));
+            m_stats.phy[phy_index (is_next_coded)].alloc_slots = m_slots_left;
+            m_stats.switches++;
+        }
+    }
+    else
+    {
+        // Switch to other PHY as soon as both are enabled.
+        is_next_coded = is_coded_enabled;
+        m_slots_left = 0U;
+    }
+
+    return is_next_coded;
+}
+
+void app_phy_sched_stats_get (app_phy_sched_stats_t * const p_stats)
+{
+    *p_stats = m_stats;
+}
+
+void app_phy_sched_reset (void)
+{
+    memset (&m_stats, 0, sizeof (m_stats));
+    m_slot_packets = 0;
+    m_slots_left = 0;
+    m_is_slot_complete = false;
+}
+
+/** @} */
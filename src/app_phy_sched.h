@@ -0,0 +1,124 @@
+#ifndef APP_PHY_SCHED_H
+#define APP_PHY_SCHED_H
+
+/**
+ * @defgroup APP_PHY_SCHED Adaptive PHY time-slicing.
+ * @{
+ */
+/**
+ *  @file app_phy_sched.h
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Select primary PHY of each scan slot when both LE Coded PHY and
+ *  LE 1M PHY (possibly with LE 2M PHY secondary) are enabled.
+ *
+ *  A slot is the time between two scan starts. Packet yield of each PHY is
+ *  tracked as an exponentially weighted moving average of packets per slot,
+ *  sampled only from slots which ran for their full length,
+ *  and every round of slots is divided between PHYs in proportion to their
+ *  yield. Each PHY gets at least a configured minimum of slots so that a PHY
+ *  which is quiet now is still sampled.
+ *
+ *  Scanning both primary PHYs in one scan would need no schedule, but
+ *  ri_radio_init selects a single primary PHY and the radio driver has no
+ *  combined LE 1M and LE Coded modulation.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ruuvi_driver_error.h"
+
+/** @brief Primary PHYs scheduled by this module. */
+typedef enum
+{
+    APP_PHY_SCHED_1M = 0,   //!< LE 1M PHY, also used as primary PHY of LE 2M PHY.
+    APP_PHY_SCHED_CODED,    //!< LE Coded PHY.
+    APP_PHY_SCHED_NUM       //!< Number of PHYs.
+} app_phy_sched_phy_t;
+
+/** @brief Scheduler configuration. */
+typedef struct
+{
+    bool is_adaptive;     //!< False to alternate PHYs on every slot.
+    uint8_t round_slots;  //!< Slots divided between PHYs in one round.
+    uint8_t min_slots;    //!< Minimum slots of a PHY in one round.
+} app_phy_sched_cfg_t;
+
+/** @brief Statistics of one PHY. */
+typedef struct
+{
+    uint32_t slots;       //!< Number of completed slots.
+    uint32_t cut_slots;   //!< Number of slots cut short, not used in yield average.
+    uint32_t packets;     //!< Number of packets received in all slots.
+    uint16_t yield_x16;   //!< Average packets per slot, multiplied by 16.
+    uint8_t alloc_slots;  //!< Slots allocated on latest switch to this PHY.
+} app_phy_sched_phy_stats_t;
+
+/** @brief Statistics of all PHYs. */
+typedef struct
+{
+    app_phy_sched_phy_stats_t phy[APP_PHY_SCHED_NUM]; //!< Indexed by app_phy_sched_phy_t.
+    uint32_t switches; //!< Number of PHY switches.
+} app_phy_sched_stats_t;
+
+/**
+ * @brief Configure the scheduler.
+ *
+ * Takes effect at next PHY switch.
+ *
+ * @param[in] p_cfg New configuration.
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_NULL if p_cfg is NULL.
+ * @retval RD_ERROR_INVALID_PARAM if min_slots is 0 or round_slots is less than
+ *                                two times min_slots.
+ */
+rd_status_t app_phy_sched_configure (const app_phy_sched_cfg_t * const p_cfg);
+
+/**
+ * @brief Get current configuration.
+ *
+ * @param[out] p_cfg Current configuration.
+ */
+void app_phy_sched_config_get (app_phy_sched_cfg_t * const p_cfg);
+
+/**
+ * @brief Count a packet received in current slot.
+ *
+ * Safe to call from interrupt context.
+ */
+void app_phy_sched_on_rx (void);
+
+/**
+ * @brief Mark current slot as run for its full length.
+ *
+ * Call right before app_phy_sched_next_is_coded() when the slot ends on scan
+ * timeout. Slots ended without this, e.g. by reconfiguration, are cut short and
+ * their packets do not update the yield average.
+ */
+void app_phy_sched_slot_complete (void);
+
+/**
+ * @brief End current slot and select PHY of the next slot.
+ *
+ * @param[in] is_current_coded True if the slot which ended was on LE Coded PHY.
+ * @param[in] is_coded_enabled True if LE Coded PHY is enabled.
+ * @param[in] is_1m_enabled True if LE 1M PHY or LE 2M PHY is enabled.
+ * @return True if next slot should be on LE Coded PHY, false for LE 1M PHY.
+ */
+bool app_phy_sched_next_is_coded (const bool is_current_coded,
+                                  const bool is_coded_enabled,
+                                  const bool is_1m_enabled);
+
+/**
+ * @brief Get statistics of scheduled PHYs.
+ *
+ * @param[out] p_stats Statistics.
+ */
+void app_phy_sched_stats_get (app_phy_sched_stats_t * const p_stats);
+
+/** @brief Reset yield history and statistics, configuration is kept. */
+void app_phy_sched_reset (void);
+
+/** @} */
+#endif
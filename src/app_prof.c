@@ -0,0 +1,210 @@
+/**
+ * @addtogroup APP_PROF
+ * @{
+ */
+/**
+ *  @file app_prof.c
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Hot path profiling.
+ */
+#include "app_config.h"
+#include "app_prof.h"
+#include <stddef.h>
+#include <string.h>
+#include "ruuvi_interface_scheduler.h"
+#include "ruuvi_interface_timer.h"
+#if !APP_PROF_HOST
+#include "nrf.h"
+#endif
+#if !defined(CEEDLING) && !defined(SONAR)
+#include "nrf_log.h"
+#else
+#define NRF_LOG_INFO(fmt, ...)
+#endif
+
+#if APP_PROF_HOST
+static app_prof_clock_fp_t m_clock = NULL;
+#endif
+static ri_timer_id_t m_log_timer = NULL;
+
+// Written by context of site: everything but m_reset_req.
+static volatile uint32_t m_start[APP_PROF_NUM];
+static volatile uint32_t m_count[APP_PROF_NUM];
+static volatile uint64_t m_total[APP_PROF_NUM];
+static volatile uint32_t m_min[APP_PROF_NUM];
+static volatile uint32_t m_max[APP_PROF_NUM];
+static volatile uint8_t m_reset_done[APP_PROF_NUM];
+// Written by reader. Site restarts its statistics when request is not done.
+static volatile uint8_t m_reset_req[APP_PROF_NUM];
+
+static const char * const m_site_names[APP_PROF_NUM] =
+{
+    [APP_PROF_SCAN_ISR] = "on_scan_isr",
+    [APP_PROF_REPEAT_ADV] = "repeat_adv",
+    [APP_PROF_SEND_BROADCAST] = "send_broadcast",
+    [APP_PROF_ENCODE] = "encode",
+    [APP_PROF_PARSER] = "uart_parser"
+};
+
+uint32_t app_prof_cycles (void)
+{
+#if APP_PROF_HOST
+    return (NULL != m_clock) ? m_clock() : 0U;
+#else
+    return DWT->CYCCNT;
+#endif
+}
+
+#if APP_PROF_HOST
+void app_prof_clock_set (const app_prof_clock_fp_t clock)
+{
+    m_clock = clock;
+}
+#endif
+
+static void on_log_evt (void * p_data, uint16_t data_len)
+{
+    (void) p_data;
+    (void) data_len;
+    app_prof_log (false);
+}
+
+static void log_timer_isr (void * const p_context)
+{
+    (void) p_context;
+    (void) ri_scheduler_event_put (NULL, 0U, &on_log_evt);
+}
+
+rd_status_t app_prof_init (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+#if !APP_PROF_HOST
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    app_prof_clear();
+
+    if ( (0U != APP_PROF_LOG_INTERVAL_MS) && (NULL == m_log_timer))
+    {
+        err_code |= ri_timer_create (&m_log_timer, RI_TIMER_MODE_REPEATED, &log_timer_isr);
+
+        if (RD_SUCCESS == err_code)
+        {
+            err_code |= ri_timer_start (m_log_timer, APP_PROF_LOG_INTERVAL_MS, NULL);
+        }
+    }
+
+    return err_code;
+}
+
+void app_prof_start (const app_prof_site_t site)
+{
+    if (site < APP_PROF_NUM)
+    {
+        m_start[site] = app_prof_cycles();
+    }
+}
+
+void app_prof_stop (const app_prof_site_t site)
+{
+    if (site < APP_PROF_NUM)
+    {
+        const uint32_t cycles = app_prof_cycles() - m_start[site];
+        const uint8_t reset_req = m_reset_req[site];
+
+        if (reset_req != m_reset_done[site])
+        {
+            m_total[site] = 0U;
+            m_count[site] = 0U;
+            m_min[site] = UINT32_MAX;
+            m_max[site] = 0U;
+            m_reset_done[site] = reset_req;
+        }
+
+        // Total before count, reader retries if count changes.
+        m_total[site] += cycles;
+        m_count[site]++;
+
+        if (cycles < m_min[site])
+        {
+            m_min[site] = cycles;
+        }
+
+        if (cycles > m_max[site])
+        {
+            m_max[site] = cycles;
+        }
+    }
+}
+
+static void site_get (const app_prof_site_t site, app_prof_stats_t * const p_stats)
+{
+    uint32_t count;
+    uint64_t total;
+
+    do
+    {
+        count = m_count[site];
+        total = m_total[site];
+        p_stats->min_cycles = m_min[site];
+        p_stats->max_cycles = m_max[site];
+    } while (count != m_count[site]);
+
+    if (m_reset_req[site] != m_reset_done[site])
+    {
+        // Reset is applied on next run of site.
+        count = 0U;
+        p_stats->min_cycles = UINT32_MAX;
+        p_stats->max_cycles = 0U;
+    }
+
+    p_stats->count = count;
+    p_stats->avg_cycles = (0U != count) ? (uint32_t) (total / count) : 0U;
+}
+
+void app_prof_get (app_prof_stats_t p_stats[APP_PROF_NUM], const bool reset)
+{
+    for (size_t ii = 0; ii < APP_PROF_NUM; ii++)
+    {
+        site_get ( (app_prof_site_t) ii, &p_stats[ii]);
+
+        if (reset)
+        {
+            m_reset_req[ii] = (uint8_t) (m_reset_done[ii] + 1U);
+        }
+    }
+}
+
+void app_prof_log (const bool reset)
+{
+    app_prof_stats_t stats[APP_PROF_NUM];
+    app_prof_get (stats, reset);
+
+    for (size_t ii = 0; ii < APP_PROF_NUM; ii++)
+    {
+        NRF_LOG_INFO ("prof: %s: n=%u, min=%u, avg=%u, max=%u", m_site_names[ii],
+                      stats[ii].count, stats[ii].min_cycles, stats[ii].avg_cycles,
+                      stats[ii].max_cycles);
+    }
+
+    (void) m_site_names;
+}
+
+void app_prof_clear (void)
+{
+    for (size_t ii = 0; ii < APP_PROF_NUM; ii++)
+    {
+        m_start[ii] = 0U;
+        m_count[ii] = 0U;
+        m_total[ii] = 0U;
+        m_min[ii] = UINT32_MAX;
+        m_max[ii] = 0U;
+        m_reset_done[ii] = 0U;
+        m_reset_req[ii] = 0U;
+    }
+}
+
+/** @} */
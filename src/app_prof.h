@@ -0,0 +1,134 @@
+#ifndef APP_PROF_H
+#define APP_PROF_H
+
+/**
+ * @defgroup APP_PROF Hot path profiling.
+ * @{
+ */
+/**
+ *  @file app_prof.h
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Count CPU cycles spent in the functions which forward advertisements.
+ *
+ *  Profiled sites are bracketed with APP_PROF_START and APP_PROF_STOP, which
+ *  compile to nothing unless APP_PROF_ENABLED is set, e.g. by `make profile`.
+ *  On target cycles are read from DWT CYCCNT. On host, where there is no cycle
+ *  counter, a stand-in clock is set with app_prof_clock_set.
+ *
+ *  Each site must be started and stopped in one interrupt context, sites may
+ *  nest. The measurement includes a call overhead of a few cycles, and cycles
+ *  of any interrupt taken while the site runs.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "app_config.h"
+#include "ruuvi_driver_error.h"
+
+/** @brief Profiled sites, in the order they are reported. */
+typedef enum
+{
+    APP_PROF_SCAN_ISR = 0,      //!< on_scan_isr.
+    APP_PROF_REPEAT_ADV,        //!< repeat_adv.
+    APP_PROF_SEND_BROADCAST,    //!< app_uart_send_broadcast.
+    APP_PROF_ENCODE,            //!< Encoding of advertisement report.
+    APP_PROF_PARSER,            //!< app_uart_parser.
+    APP_PROF_NUM                //!< Number of sites.
+} app_prof_site_t;
+
+/** @brief Cycle statistics of a site. */
+typedef struct
+{
+    uint32_t count;       //!< Number of completed runs.
+    uint32_t min_cycles;  //!< Shortest run, UINT32_MAX if none.
+    uint32_t avg_cycles;  //!< Average run, 0 if none.
+    uint32_t max_cycles;  //!< Longest run.
+} app_prof_stats_t;
+
+#if (defined (CEEDLING) || !defined (__arm__))
+/** @brief Built for host, cycles come from a stand-in clock. */
+#   define APP_PROF_HOST (1U)
+#else
+#   define APP_PROF_HOST (0U)
+#endif
+
+#if APP_PROF_ENABLED
+#   define APP_PROF_START(site) app_prof_start (site)
+#   define APP_PROF_STOP(site)  app_prof_stop (site)
+#else
+#   define APP_PROF_START(site)
+#   define APP_PROF_STOP(site)
+#endif
+
+/**
+ * @brief Start cycle counter and log timer.
+ *
+ * Statistics are logged every APP_PROF_LOG_INTERVAL_MS if it is not 0.
+ * Requires timers and scheduler.
+ *
+ * @retval RD_SUCCESS on success.
+ * @return Error code from timer otherwise.
+ */
+rd_status_t app_prof_init (void);
+
+/**
+ * @brief Read cycle counter.
+ *
+ * @return Cycles since app_prof_init, wrapping at 2^32.
+ */
+uint32_t app_prof_cycles (void);
+
+/**
+ * @brief Mark start of a run of a site.
+ *
+ * @param[in] site Site which starts.
+ */
+void app_prof_start (const app_prof_site_t site);
+
+/**
+ * @brief Record a run of a site which was started with app_prof_start.
+ *
+ * @param[in] site Site which stops.
+ */
+void app_prof_stop (const app_prof_site_t site);
+
+/**
+ * @brief Get statistics of all sites since boot or previous reset.
+ *
+ * @param[out] p_stats Statistics indexed by app_prof_site_t.
+ * @param[in] reset True to restart statistics after read.
+ */
+void app_prof_get (app_prof_stats_t p_stats[APP_PROF_NUM], const bool reset);
+
+/**
+ * @brief Log statistics of all sites.
+ *
+ * Goes to RTT in builds which log to RTT.
+ *
+ * @param[in] reset True to restart statistics after logging.
+ */
+void app_prof_log (const bool reset);
+
+/**
+ * @brief Clear all statistics.
+ *
+ * Not safe while sites run, for initialization.
+ */
+void app_prof_clear (void);
+
+#if APP_PROF_HOST
+/** @brief Stand-in for cycle counter. */
+typedef uint32_t (*app_prof_clock_fp_t) (void);
+
+/**
+ * @brief Set stand-in for cycle counter on host.
+ *
+ * @param[in] clock Function returning cycles, NULL to read 0.
+ */
+void app_prof_clock_set (const app_prof_clock_fp_t clock);
+#endif
+
+/** @} */
+#endif // APP_PROF_H
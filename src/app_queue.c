@@ -0,0 +1,121 @@
+/**
+ * @addtogroup APP_QUEUE
+ * @{
+ */
+/**
+ *  @file app_queue.c
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Queue fill level telemetry.
+ */
+#include "app_config.h"
+#include "app_queue.h"
+#include <stddef.h>
+#include <string.h>
+
+static uint16_t m_capacity[APP_QUEUE_NUM] = {[APP_QUEUE_SCHED] = RI_SCHEDULER_LENGTH};
+static uint16_t m_level[APP_QUEUE_NUM];
+static uint16_t m_high_water[APP_QUEUE_NUM];
+static volatile uint32_t m_full[APP_QUEUE_NUM];   //!< Counts since boot.
+static uint32_t m_full_baseline[APP_QUEUE_NUM];    //!< Counts at latest reset.
+static volatile uint32_t m_sched_put[APP_QUEUE_SRC_NUM];  //!< Written by source.
+static uint32_t m_sched_done[APP_QUEUE_SRC_NUM];          //!< Written by main loop.
+
+void app_queue_capacity_set (const app_queue_id_t id, const uint16_t capacity)
+{
+    if (id < APP_QUEUE_NUM)
+    {
+        m_capacity[id] = capacity;
+    }
+}
+
+void app_queue_level_record (const app_queue_id_t id, const uint16_t level)
+{
+    if (id < APP_QUEUE_NUM)
+    {
+        m_level[id] = level;
+
+        if (level > m_high_water[id])
+        {
+            m_high_water[id] = level;
+        }
+    }
+}
+
+void app_queue_full_record (const app_queue_id_t id)
+{
+    if (id < APP_QUEUE_NUM)
+    {
+        // Scan and UART interrupts both record the scheduler queue.
+        (void) __atomic_fetch_add (&m_full[id], 1U, __ATOMIC_RELAXED);
+    }
+}
+
+void app_queue_sched_put (const app_queue_src_t src)
+{
+    if (src < APP_QUEUE_SRC_NUM)
+    {
+        (void) __atomic_fetch_add (&m_sched_put[src], 1U, __ATOMIC_RELAXED);
+    }
+}
+
+void app_queue_sched_done (const app_queue_src_t src)
+{
+    if (src < APP_QUEUE_SRC_NUM)
+    {
+        uint32_t level = 0U;
+
+        for (size_t ii = 0; ii < APP_QUEUE_SRC_NUM; ii++)
+        {
+            level += m_sched_put[ii] - m_sched_done[ii];
+        }
+
+        app_queue_level_record (APP_QUEUE_SCHED,
+                                (level > UINT16_MAX) ? UINT16_MAX : (uint16_t) level);
+
+        // Event which was not counted when put is ignored.
+        if (m_sched_done[src] != m_sched_put[src])
+        {
+            m_sched_done[src]++;
+        }
+    }
+}
+
+void app_queue_stats_get (app_queue_stats_t p_stats[APP_QUEUE_NUM], const bool reset)
+{
+    for (size_t ii = 0; ii < APP_QUEUE_NUM; ii++)
+    {
+        const uint32_t full = m_full[ii];
+        p_stats[ii].capacity = m_capacity[ii];
+        p_stats[ii].level = m_level[ii];
+        p_stats[ii].high_water = m_high_water[ii];
+        p_stats[ii].full = full - m_full_baseline[ii];
+
+        if (reset)
+        {
+            m_high_water[ii] = m_level[ii];
+            m_full_baseline[ii] = full;
+        }
+    }
+}
+
+void app_queue_clear (void)
+{
+    for (size_t ii = 0; ii < APP_QUEUE_NUM; ii++)
+    {
+        m_full[ii] = 0U;
+    }
+
+    for (size_t ii = 0; ii < APP_QUEUE_SRC_NUM; ii++)
+    {
+        m_sched_put[ii] = 0U;
+    }
+
+    memset (m_level, 0, sizeof (m_level));
+    memset (m_high_water, 0, sizeof (m_high_water));
+    memset (m_full_baseline, 0, sizeof (m_full_baseline));
+    memset (m_sched_done, 0, sizeof (m_sched_done));
+}
+
+/** @} */
@@ -0,0 +1,113 @@
+#ifndef APP_QUEUE_H
+#define APP_QUEUE_H
+
+/**
+ * @defgroup APP_QUEUE Queue fill level telemetry.
+ * @{
+ */
+/**
+ *  @file app_queue.h
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Track high-water marks and overflows of the scheduler queue, UART RX
+ *  buffer and frames queued to the UART driver, so that buffers can be sized
+ *  from field data.
+ *
+ *  Scheduler fill level is counted from events put by interrupts, which are
+ *  the ones that arrive in bursts. Events put from the main loop are not
+ *  counted. Each source of events has its own counters, written by one
+ *  context only, and the fill level is sampled in the main loop when an event
+ *  is handled.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @brief Tracked queues, in the order they are reported. */
+typedef enum
+{
+    APP_QUEUE_SCHED = 0,  //!< Scheduler event queue.
+    APP_QUEUE_UART_RX,    //!< UART RX reassembly buffer, in bytes.
+    APP_QUEUE_UART_TX,    //!< Frames accepted by UART driver and not yet sent.
+    APP_QUEUE_NUM         //!< Number of queues.
+} app_queue_id_t;
+
+/** @brief Interrupts which put events to scheduler. */
+typedef enum
+{
+    APP_QUEUE_SRC_SCAN = 0, //!< Scan interrupt.
+    APP_QUEUE_SRC_UART,     //!< UART interrupt.
+    APP_QUEUE_SRC_NUM       //!< Number of sources.
+} app_queue_src_t;
+
+/** @brief Fill level statistics of a queue. */
+typedef struct
+{
+    uint16_t capacity;    //!< Entries queue can hold, 0 if not known.
+    uint16_t level;       //!< Latest recorded fill level.
+    uint16_t high_water;  //!< Highest recorded fill level.
+    uint32_t full;        //!< Entries rejected because queue was full.
+} app_queue_stats_t;
+
+/**
+ * @brief Set capacity of a queue.
+ *
+ * @param[in] id Queue.
+ * @param[in] capacity Entries queue can hold.
+ */
+void app_queue_capacity_set (const app_queue_id_t id, const uint16_t capacity);
+
+/**
+ * @brief Record fill level of a queue. Call from main loop.
+ *
+ * @param[in] id Queue.
+ * @param[in] level Entries in queue.
+ */
+void app_queue_level_record (const app_queue_id_t id, const uint16_t level);
+
+/**
+ * @brief Record an entry rejected by a full queue.
+ *
+ * Safe to call from interrupt context.
+ *
+ * @param[in] id Queue.
+ */
+void app_queue_full_record (const app_queue_id_t id);
+
+/**
+ * @brief Record an event put to scheduler from an interrupt.
+ *
+ * Safe to call from interrupt context.
+ *
+ * @param[in] src Interrupt which put the event.
+ */
+void app_queue_sched_put (const app_queue_src_t src);
+
+/**
+ * @brief Record handling of an event put by app_queue_sched_put.
+ *
+ * Call from the event handler. Samples scheduler fill level.
+ *
+ * @param[in] src Interrupt which put the event.
+ */
+void app_queue_sched_done (const app_queue_src_t src);
+
+/**
+ * @brief Get statistics of all queues.
+ *
+ * @param[out] p_stats Statistics, indexed by app_queue_id_t.
+ * @param[in] reset True to restart high-water marks from current level and
+ *                  full counts from zero after read.
+ */
+void app_queue_stats_get (app_queue_stats_t p_stats[APP_QUEUE_NUM], const bool reset);
+
+/**
+ * @brief Clear all statistics and counters.
+ *
+ * Not safe while queues are in use, for initialization.
+ */
+void app_queue_clear (void);
+
+/** @} */
+#endif
@@ -0,0 +1,57 @@
+/**
+ * @addtogroup APP_STATS
+ * @{
+ */
+/**
+ *  @file app_stats.c
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Runtime statistics.
+ */
+#include "app_stats.h"
+#include <stddef.h>
+#include <string.h>
+
+static volatile uint32_t m_counters[APP_STATS_NUM]; //!< Counts since boot.
+static uint32_t m_baseline[APP_STATS_NUM];          //!< Counts at latest reset.
+
+void app_stats_add (const app_stats_id_t id, const uint32_t count)
+{
+    if (id < APP_STATS_NUM)
+    {
+        // Scan interrupt and main context count some statistics, e.g. drops.
+        (void) __atomic_fetch_add (&m_counters[id], count, __ATOMIC_RELAXED);
+    }
+}
+
+void app_stats_inc (const app_stats_id_t id)
+{
+    app_stats_add (id, 1U);
+}
+
+void app_stats_get (app_stats_t * const p_stats, const bool reset)
+{
+    for (size_t ii = 0; ii < APP_STATS_NUM; ii++)
+    {
+        const uint32_t count = m_counters[ii];
+        p_stats->counters[ii] = count - m_baseline[ii];
+
+        if (reset)
+        {
+            m_baseline[ii] = count;
+        }
+    }
+}
+
+void app_stats_clear (void)
+{
+    for (size_t ii = 0; ii < APP_STATS_NUM; ii++)
+    {
+        m_counters[ii] = 0U;
+    }
+
+    memset (m_baseline, 0, sizeof (m_baseline));
+}
+
+/** @} */
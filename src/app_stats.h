@@ -0,0 +1,81 @@
+#ifndef APP_STATS_H
+#define APP_STATS_H
+
+/**
+ * @defgroup APP_STATS Runtime statistics.
+ * @{
+ */
+/**
+ *  @file app_stats.h
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Counters of packets and UART frames through the gateway.
+ *
+ *  Counters only ever grow and may be incremented from interrupt context.
+ *  Reading with reset stores a baseline which is subtracted from later reads,
+ *  so a reset never writes a counter which an interrupt might be incrementing.
+ *  Counters wrap around at 2^32.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @brief Counters, in the order they are reported. */
+typedef enum
+{
+    APP_STATS_RX_1M = 0,        //!< Advertisements received on LE 1M PHY.
+    APP_STATS_RX_2M,            //!< Extended advertisements received on LE 2M PHY.
+    APP_STATS_RX_CODED,         //!< Advertisements received on LE Coded PHY.
+    APP_STATS_FLTR_MANUF_ID,    //!< Advertisements discarded by manufacturer filter.
+    APP_STATS_FLTR_TOO_LONG,    //!< Advertisements too long for a UART frame.
+    APP_STATS_DROP_SCHED_FULL,  //!< Events lost because scheduler queue was full.
+    APP_STATS_DROP_UART_BUSY,   //!< Frames UART driver did not accept.
+    APP_STATS_ENCODE_ERRORS,    //!< Frames which could not be encoded.
+    APP_STATS_TX_FRAMES,        //!< Frames sent to UART.
+    APP_STATS_TX_BYTES,         //!< Bytes sent to UART.
+    APP_STATS_RX_FRAMES,        //!< Commands decoded from UART.
+    APP_STATS_DECODE_ERRORS,    //!< Runs of corrupted UART data discarded.
+    APP_STATS_NUM               //!< Number of counters.
+} app_stats_id_t;
+
+/** @brief Snapshot of all counters. */
+typedef struct
+{
+    uint32_t counters[APP_STATS_NUM]; //!< Counters indexed by app_stats_id_t.
+} app_stats_t;
+
+/**
+ * @brief Add to a counter.
+ *
+ * Safe to call from any context, the addition is atomic.
+ *
+ * @param[in] id Counter.
+ * @param[in] count Value to add.
+ */
+void app_stats_add (const app_stats_id_t id, const uint32_t count);
+
+/**
+ * @brief Increment a counter by one.
+ *
+ * @param[in] id Counter.
+ */
+void app_stats_inc (const app_stats_id_t id);
+
+/**
+ * @brief Get counters since boot or previous reset.
+ *
+ * @param[out] p_stats Counters.
+ * @param[in] reset True to restart counting from zero after read.
+ */
+void app_stats_get (app_stats_t * const p_stats, const bool reset);
+
+/**
+ * @brief Clear all counters.
+ *
+ * Not safe while counters are being incremented, for initialization.
+ */
+void app_stats_clear (void);
+
+/** @} */
+#endif
@@ -0,0 +1,66 @@
+/**
+ * @addtogroup APP_TRACE
+ * @{
+ */
+/**
+ *  @file app_trace.c
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Binary event trace.
+ */
+#include "app_config.h"
+#include "app_trace.h"
+#include <string.h>
+#include "ruuvi_interface_rtc.h"
+
+_Static_assert ( (0U != APP_TRACE_LENGTH)
+                 && (0U == (APP_TRACE_LENGTH & (APP_TRACE_LENGTH - 1U))),
+                 "Trace length must be a power of two.");
+_Static_assert (APP_TRACE_LENGTH <= UINT8_MAX, "Trace is read in chunks of uint8_t.");
+
+static app_trace_event_t m_events[APP_TRACE_LENGTH];
+static volatile uint32_t m_next_seq;
+
+void app_trace_record (const app_trace_id_t id, const uint8_t arg0, const uint16_t arg1)
+{
+    // Reserve slot atomically, interrupt may record between reserving and writing.
+    const uint32_t seq = __atomic_fetch_add (&m_next_seq, 1U, __ATOMIC_RELAXED);
+    app_trace_event_t * const p_event = &m_events[seq & (APP_TRACE_LENGTH - 1U)];
+    p_event->time_ms = (uint32_t) ri_rtc_millis();
+    p_event->id = (uint8_t) id;
+    p_event->arg0 = arg0;
+    p_event->arg1 = arg1;
+}
+
+uint8_t app_trace_read (const uint32_t seq, uint32_t * const p_first,
+                        app_trace_event_t * const p_events, const uint8_t max_events)
+{
+    const uint32_t next = m_next_seq;
+    const uint32_t kept = (next < APP_TRACE_LENGTH) ? next : APP_TRACE_LENGTH;
+    const uint32_t oldest = next - kept;
+    const uint32_t first = ( (uint32_t) (seq - oldest) <= kept) ? seq : oldest;
+    const uint32_t available = next - first;
+    const uint8_t count = (available < max_events) ? (uint8_t) available : max_events;
+
+    for (uint8_t ii = 0; ii < count; ii++)
+    {
+        p_events[ii] = m_events[ (first + ii) & (APP_TRACE_LENGTH - 1U)];
+    }
+
+    *p_first = first;
+    return count;
+}
+
+uint32_t app_trace_next_seq (void)
+{
+    return m_next_seq;
+}
+
+void app_trace_clear (void)
+{
+    memset (m_events, 0, sizeof (m_events));
+    m_next_seq = 0U;
+}
+
+/** @} */
@@ -0,0 +1,92 @@
+#ifndef APP_TRACE_H
+#define APP_TRACE_H
+
+/**
+ * @defgroup APP_TRACE Binary event trace.
+ * @{
+ */
+/**
+ *  @file app_trace.h
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Fixed-size ring of recent internal events, kept in release builds where
+ *  logging is compiled out and read over UART with APP_UART_EXT_GET_TRACE.
+ *
+ *  Every event gets a sequence number from a counter which never resets.
+ *  The ring keeps the latest APP_TRACE_LENGTH events, so a reader asking for
+ *  an older sequence number gets the oldest event still kept and can tell how
+ *  many were overwritten.
+ *
+ *  Events may be recorded from any interrupt context. An event recorded while
+ *  the ring is being read may be read half-written.
+ */
+
+#include <stdint.h>
+#include "app_config.h"
+
+/** @brief Size of an event on UART. */
+#define APP_TRACE_EVENT_SIZE (8U)
+
+/** @brief Event identifiers, arguments in parentheses. */
+typedef enum
+{
+    APP_TRACE_NONE = 0,         //!< No event.
+    APP_TRACE_SCAN_START,       //!< Scan started (ri_radio_modulation_t, channel bits).
+    APP_TRACE_SCAN_TIMEOUT,     //!< Scan slot ended (0 by driver, 1 by scan timer, 0).
+    APP_TRACE_PHY_SWITCH,       //!< Radio initialized on other PHY (new, previous modulation).
+    APP_TRACE_ENQUEUE_FAIL,     //!< Queue was full (app_queue_id_t, 0).
+    APP_TRACE_TX_START,         //!< Frame accepted by UART driver (command, length).
+    APP_TRACE_TX_DONE,          //!< UART reported frame sent (0, frames still in driver).
+    APP_TRACE_CMD_RX,           //!< Command decoded from UART (command, payload length).
+    APP_TRACE_WDT_STARVE,       //!< Watchdog not fed (bitmask of late app_wdt_src_t, 0).
+    APP_TRACE_ID_NUM            //!< Number of identifiers.
+} app_trace_id_t;
+
+/** @brief Recorded event. */
+typedef struct
+{
+    uint32_t time_ms;  //!< RTC time truncated to 32 bits.
+    uint8_t id;        //!< app_trace_id_t.
+    uint8_t arg0;      //!< First argument.
+    uint16_t arg1;     //!< Second argument.
+} app_trace_event_t;
+
+/**
+ * @brief Record an event.
+ *
+ * @param[in] id Event identifier.
+ * @param[in] arg0 First argument.
+ * @param[in] arg1 Second argument.
+ */
+void app_trace_record (const app_trace_id_t id, const uint8_t arg0, const uint16_t arg1);
+
+/**
+ * @brief Read kept events starting from a sequence number.
+ *
+ * @param[in] seq Sequence number of first event to read. Older events than
+ *                the oldest one kept are read from the oldest one kept.
+ * @param[out] p_first Sequence number of first event read.
+ * @param[out] p_events Events, oldest first.
+ * @param[in] max_events Size of p_events.
+ * @return Number of events read, 0 if there are no events from seq on.
+ */
+uint8_t app_trace_read (const uint32_t seq, uint32_t * const p_first,
+                        app_trace_event_t * const p_events, const uint8_t max_events);
+
+/**
+ * @brief Get sequence number of next event.
+ *
+ * @return Number of events recorded since boot, wrapping at 2^32.
+ */
+uint32_t app_trace_next_seq (void);
+
+/**
+ * @brief Forget all events.
+ *
+ * Not safe while events are being recorded, for initialization.
+ */
+void app_trace_clear (void);
+
+/** @} */
+#endif // APP_TRACE_H
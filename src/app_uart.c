@@ -15,31 +15,35 @@
 #include <string.h>
 #include "ble_gap.h"
 #include "app_ble.h"
-#include "main.h"
+#include "app_capture.h"
+#include "app_ch_sched.h"
+#include "app_latency.h"
+#include "app_log.h"
+#include "app_phy_sched.h"
+#include "app_prof.h"
+#include "app_queue.h"
+#include "app_stats.h"
+#include "app_trace.h"
+#include "app_uart_ext.h"
+#include "app_uart_rx.h"
+#include "app_wdt.h"
 #include "ruuvi_boards.h"
 #include "ruuvi_driver_error.h"
 #include "ruuvi_endpoint_ca_uart.h"
 #include "ruuvi_interface_communication.h"
 #include "ruuvi_interface_communication_radio.h"
 #include "ruuvi_interface_communication_ble_advertising.h"
-#include "ruuvi_interface_watchdog.h"
+#include "ruuvi_interface_rtc.h"
 #include "ruuvi_interface_scheduler.h"
+#include "ruuvi_interface_timer.h"
 #include "ruuvi_interface_communication_uart.h"
-#include "ruuvi_library_ringbuffer.h"
-#include "ruuvi_interface_yield.h"
 #include "ruuvi_task_led.h"
 #if !defined(CEEDLING) && !defined(SONAR)
 #include "nrf_log.h"
 #else
-#define NRF_LOG_DEBUG(fmt, ...)
-#define NRF_LOG_INFO(fmt, ...)
 #define NRF_LOG_ERROR(fmt, ...)
-#define NRF_LOG_HEXDUMP_INFO(data, len)
 #endif
 
-#define APP_UART_RING_BUFFER_MAX_LEN     (128U) //!< Ring buffer len       
-#define APP_UART_RING_DEQ_BUFFER_MAX_LEN (APP_UART_RING_BUFFER_MAX_LEN >>1) //!< Decode buffer len
-
 /*!
  * @brief UART response type enum
  */
@@ -48,70 +52,60 @@ typedef enum
     APP_UART_RESP_TYPE_NONE = 0,  //!< No response
     APP_UART_RESP_TYPE_ACK,       //!< Ack response
     APP_UART_RESP_TYPE_DEVICE_ID, //!< Device ID response
+    APP_UART_RESP_TYPE_EXT,       //!< Response to gateway-specific command
 } app_uart_resp_type_e;
 
-#ifndef CEEDLING
-static bool app_uart_ringbuffer_lock_dummy (volatile uint32_t * const flag, bool lock);
-#endif
-
 static ri_comm_channel_t m_uart; //!< UART communication interface.
-static uint8_t buffer_data[APP_UART_RING_BUFFER_MAX_LEN] = {0};
-static bool buffer_wlock = false;
-static bool buffer_rlock = false;
 
 static bool g_flag_uart_tx_in_progress;
 static app_uart_resp_type_e g_resp_type;
 static re_ca_uart_cmd_t g_resp_ack_cmd;
 static bool g_resp_ack_state;
 static re_ca_uart_payload_t m_uart_payload;
+static app_uart_ext_frame_t m_ext_request;  //!< Received gateway-specific command.
+static app_uart_ext_frame_t m_ext_response; //!< Pending gateway-specific response.
+static ri_timer_id_t m_poll_timer = NULL;  //!< Re-polls configuration until ESP32 answers.
+static uint32_t m_poll_interval_ms;        //!< Current configuration polling interval.
+static app_uart_boot_stats_t m_boot_stats; //!< Boot handshake statistics.
+static uint16_t m_tx_in_flight;            //!< Frames in UART driver.
+/** @brief Send advertisement reports with reception time. */
+static bool m_is_adv_timestamp_enabled = (0U != APP_UART_ADV_TIMESTAMP_ENABLED);
+/** @brief Send advertisement reports with sequence number. */
+static bool m_is_adv_seq_enabled = (0U != APP_UART_ADV_SEQ_ENABLED);
+static bool m_is_capture_enabled;          //!< Send captures instead of reports.
+// Sequence counters are updated also from scan interrupt.
+static volatile uint32_t m_adv_seq;        //!< Sequence number of next advertisement.
+static volatile uint32_t m_adv_seq_dropped; //!< Sequenced advertisements not sent.
+static ri_timer_id_t m_heartbeat_timer = NULL; //!< Sends heartbeat frames.
+static uint32_t m_heartbeat_interval_ms;   //!< Heartbeat interval, 0 if stopped.
+static uint32_t m_reset_reason;            //!< Reported in heartbeats.
 
 #ifndef CEEDLING
 static
 #endif
 volatile bool m_uart_ack = false;
 
-static rl_ringbuffer_t m_uart_ring_buffer =
-    (rl_ringbuffer_t)
-{
-    .head = 0,
-    .tail = 0,
-    .block_size = sizeof (uint8_t),
-    .storage_size = sizeof (buffer_data),
-    .index_mask = (sizeof (buffer_data) / sizeof (uint8_t)) - 1,
-    .storage = buffer_data,
-    .lock = &app_uart_ringbuffer_lock_dummy,
-    .writelock = &buffer_wlock,
-    .readlock  = &buffer_rlock
-};
-
 #ifndef CEEDLING
 static
 #endif
 void app_uart_init_globs (void)
 {
-    buffer_wlock = false;
-    buffer_rlock = false;
     g_flag_uart_tx_in_progress = false;
     g_resp_type = APP_UART_RESP_TYPE_NONE;
     g_resp_ack_cmd = (re_ca_uart_cmd_t)0;
     g_resp_ack_state = false;
     m_uart_ack = false;
-    m_uart_ring_buffer.head = 0;
-    m_uart_ring_buffer.tail = 0;
-}
-
-/** Dummy function to lock/unlock buffer */
-#ifndef CEEDLING
-static
-#endif
-bool app_uart_ringbuffer_lock_dummy (volatile uint32_t * const flag, bool lock)
-{
-    bool * p_bool = (bool *) flag;
-
-    if (*p_bool == lock) { return false; }
-
-    *p_bool = lock;
-    return true;
+    m_poll_interval_ms = APP_UART_POLL_INTERVAL_MIN_MS;
+    memset (&m_boot_stats, 0, sizeof (m_boot_stats));
+    app_uart_rx_clear();
+    m_tx_in_flight = 0;
+    m_is_adv_timestamp_enabled = (0U != APP_UART_ADV_TIMESTAMP_ENABLED);
+    m_is_adv_seq_enabled = (0U != APP_UART_ADV_SEQ_ENABLED);
+    m_is_capture_enabled = false;
+    m_adv_seq = 0;
+    m_adv_seq_dropped = 0;
+    m_heartbeat_interval_ms = 0;
+    m_reset_reason = 0;
 }
 
 static rd_status_t app_uart_send_msg (ri_comm_message_t * const p_msg)
@@ -122,6 +116,24 @@ static rd_status_t app_uart_send_msg (ri_comm_message_t * const p_msg)
     if (RD_SUCCESS != err_code)
     {
         g_flag_uart_tx_in_progress = false;
+        app_stats_inc (APP_STATS_DROP_UART_BUSY);
+        app_queue_full_record (APP_QUEUE_UART_TX);
+        app_trace_record (APP_TRACE_ENQUEUE_FAIL, (uint8_t) APP_QUEUE_UART_TX, 0U);
+    }
+    else
+    {
+        if (0U == m_tx_in_flight)
+        {
+            app_wdt_arm (APP_WDT_UART_TX, APP_WDT_UART_TX_TIMEOUT_MS);
+        }
+
+        m_tx_in_flight++;
+        app_queue_level_record (APP_QUEUE_UART_TX, m_tx_in_flight);
+        app_latency_on_frame_queued();
+        app_stats_inc (APP_STATS_TX_FRAMES);
+        app_stats_add (APP_STATS_TX_BYTES, p_msg->data_length);
+        // Command follows STX and length in both CA UART and gateway frames.
+        app_trace_record (APP_TRACE_TX_START, p_msg->data[2], p_msg->data_length);
     }
 
     return err_code;
@@ -174,21 +186,37 @@ static rd_status_t app_uart_send_ack (const re_ca_uart_cmd_t cmd, const bool is_
     }
     else
     {
+        app_stats_inc (APP_STATS_ENCODE_ERRORS);
         err_code |= RD_ERROR_INVALID_DATA;
     }
 
     return err_code;
 }
 
-#ifndef CEEDLING
-static
-#endif
-void app_uart_on_evt_tx_finish (void * p_data, uint16_t data_len)
+static rd_status_t app_uart_send_ext (void)
 {
-    (void)p_data;
-    (void)data_len;
-    g_flag_uart_tx_in_progress = false;
+    rd_status_t err_code = RD_SUCCESS;
+    ri_comm_message_t msg;
+    memset (&msg, 0, sizeof (msg));
+    msg.data_length = sizeof (msg.data);
+    err_code |= app_uart_ext_encode (msg.data, &msg.data_length, &m_ext_response);
+    msg.repeat_count = 1;
+
+    if (RD_SUCCESS == err_code)
+    {
+        err_code |= app_uart_send_msg (&msg);
+    }
+    else
+    {
+        app_stats_inc (APP_STATS_ENCODE_ERRORS);
+    }
+
+    return err_code;
+}
 
+/** @brief Send response requested while a frame was being sent, if any. */
+static void app_uart_send_pending_response (void)
+{
     switch (g_resp_type)
     {
         case APP_UART_RESP_TYPE_NONE:
@@ -197,12 +225,68 @@ void app_uart_on_evt_tx_finish (void * p_data, uint16_t data_len)
         case APP_UART_RESP_TYPE_ACK:
             g_resp_type = APP_UART_RESP_TYPE_NONE;
             app_uart_send_ack (g_resp_ack_cmd, g_resp_ack_state);
-            return;
+            break;
 
         case APP_UART_RESP_TYPE_DEVICE_ID:
             g_resp_type = APP_UART_RESP_TYPE_NONE;
             app_uart_send_device_id();
-            return;
+            break;
+
+        case APP_UART_RESP_TYPE_EXT:
+            g_resp_type = APP_UART_RESP_TYPE_NONE;
+            app_uart_send_ext();
+            break;
+    }
+}
+
+/**
+ * @brief Handle RI_COMM_SENT of UART driver: account the sent frame and send
+ *        pending response.
+ *
+ * Scheduled only from app_uart_isr, once per frame sent.
+ */
+#ifndef CEEDLING
+static
+#endif
+void app_uart_on_evt_tx_finish (void * p_data, uint16_t data_len)
+{
+    (void)p_data;
+    (void)data_len;
+    g_flag_uart_tx_in_progress = false;
+    app_queue_sched_done (APP_QUEUE_SRC_UART);
+
+    if (m_tx_in_flight > 0U)
+    {
+        m_tx_in_flight--;
+    }
+
+    if (0U == m_tx_in_flight)
+    {
+        app_wdt_disarm (APP_WDT_UART_TX);
+    }
+    else
+    {
+        app_wdt_checkin (APP_WDT_UART_TX);
+    }
+
+    app_trace_record (APP_TRACE_TX_DONE, 0U, m_tx_in_flight);
+
+    app_latency_on_frame_sent();
+    app_uart_send_pending_response();
+}
+
+#ifndef CEEDLING
+static
+#endif
+void app_uart_on_evt_send_ext (void * p_data, uint16_t data_len)
+{
+    (void)p_data;
+    (void)data_len;
+    g_resp_type = APP_UART_RESP_TYPE_EXT;
+
+    if (!g_flag_uart_tx_in_progress)
+    {
+        app_uart_send_pending_response();
     }
 }
 
@@ -217,7 +301,7 @@ void app_uart_on_evt_send_device_id (void * p_data, uint16_t data_len)
 
     if (!g_flag_uart_tx_in_progress)
     {
-        ri_scheduler_event_put (NULL, (uint16_t)0, app_uart_on_evt_tx_finish);
+        app_uart_send_pending_response();
     }
 }
 
@@ -232,7 +316,7 @@ void app_uart_on_evt_send_ack (void * p_data, uint16_t data_len)
 
     if (!g_flag_uart_tx_in_progress)
     {
-        ri_scheduler_event_put (NULL, (uint16_t)0, app_uart_on_evt_tx_finish);
+        app_uart_send_pending_response();
     }
 }
 
@@ -324,243 +408,719 @@ rd_status_t app_uart_apply_config (void * v_uart_payload)
 
     return err_code;
 }
-#if 0
-#ifndef CEEDLING
-static
-#endif
-void app_uart_repeat_send (void * p_data, uint16_t data_len)
+
+static rd_status_t app_uart_ext_put_sched_stats (app_uart_ext_frame_t * const p_resp)
 {
     rd_status_t err_code = RD_SUCCESS;
-    ri_comm_message_t msg = {0};
-    msg.repeat_count = 1;
-    msg.data_length = data_len;
-    memcpy (msg.data, p_data, data_len);
-    err_code |= app_uart_send_msg (&msg);
+    app_phy_sched_stats_t phy_stats;
+    app_ch_sched_stats_t ch_stats;
+    app_phy_sched_stats_get (&phy_stats);
+    app_ch_sched_stats_get (&ch_stats);
 
-    if (RE_SUCCESS != err_code)
+    for (size_t phy = 0; phy < APP_PHY_SCHED_NUM; phy++)
     {
-        err_code |= ri_scheduler_event_put (msg.data, (uint16_t) msg.data_length,
-                                            app_uart_repeat_send);
+        err_code |= app_uart_ext_put_u32 (p_resp, phy_stats.phy[phy].slots);
+        err_code |= app_uart_ext_put_u32 (p_resp, phy_stats.phy[phy].packets);
+        err_code |= app_uart_ext_put_u16 (p_resp, phy_stats.phy[phy].yield_x16);
+        err_code |= app_uart_ext_put_u8 (p_resp, phy_stats.phy[phy].alloc_slots);
     }
 
-    if (RD_SUCCESS == err_code)
+    err_code |= app_uart_ext_put_u32 (p_resp, phy_stats.switches);
+
+    for (size_t ch = 0; ch < APP_CH_SCHED_NUM; ch++)
     {
-        ri_watchdog_feed();
+        err_code |= app_uart_ext_put_u32 (p_resp, ch_stats.ch[ch].slots);
+        err_code |= app_uart_ext_put_u32 (p_resp, ch_stats.ch[ch].packets);
+        err_code |= app_uart_ext_put_u16 (p_resp, ch_stats.ch[ch].yield_x16);
+        err_code |= app_uart_ext_put_u8 (p_resp, ch_stats.ch[ch].alloc_slots);
     }
+
+    err_code |= app_uart_ext_put_u32 (p_resp, ch_stats.rounds);
+    return err_code;
 }
-#endif
 
-#ifndef CEEDLING
-static
-#endif
-void app_uart_parser (void * p_data, uint16_t data_len)
+static rd_status_t app_uart_ext_set_sched (const app_uart_ext_frame_t * const p_req)
 {
     rd_status_t err_code = RD_SUCCESS;
-    uint8_t dequeue_data[APP_UART_RING_DEQ_BUFFER_MAX_LEN] = {0};
-    rl_status_t status = RL_SUCCESS;
-    size_t index = 0;
-    memset (&m_uart_payload, 0, sizeof (m_uart_payload));
-    err_code = re_ca_uart_decode ((uint8_t *) p_data, &m_uart_payload);
 
-    if (RD_SUCCESS == err_code)
+    if (6U != p_req->len)
     {
-        do
-        {
-            uint8_t * p_dequeue_data = NULL;
-            status = rl_ringbuffer_dequeue (&m_uart_ring_buffer,
-                                            &p_dequeue_data);
-
-            if (NULL != p_dequeue_data)
-            {
-                dequeue_data[index++] = *p_dequeue_data;
-            }
-        } while (RL_SUCCESS == status);
+        err_code |= RD_ERROR_INVALID_LENGTH;
     }
     else
     {
-        do
+        const app_phy_sched_cfg_t phy_cfg =
         {
-            status = rl_ringbuffer_queue (&m_uart_ring_buffer,
-                                          (void *) ((uint8_t *) p_data + index),
-                                          sizeof (uint8_t));
-            index++;
-        } while ((RL_SUCCESS == status) && (index < data_len));
-
-        index = 0;
-
-        do
+            .is_adaptive = (0U != p_req->payload[0]),
+            .round_slots = p_req->payload[1],
+            .min_slots = p_req->payload[2]
+        };
+        const app_ch_sched_cfg_t ch_cfg =
         {
-            uint8_t * p_dequeue_data = NULL;
-            status = rl_ringbuffer_dequeue (&m_uart_ring_buffer,
-                                            &p_dequeue_data);
-
-            if (NULL != p_dequeue_data)
-            {
-                dequeue_data[index++] = *p_dequeue_data;
-            }
-        } while (RL_SUCCESS == status);
-
-        memset (&m_uart_payload, 0, sizeof (m_uart_payload));
-        err_code = re_ca_uart_decode ((uint8_t *) dequeue_data, &m_uart_payload);
-
-        if (RD_SUCCESS != err_code)
+            .is_adaptive = (0U != p_req->payload[3]),
+            .round_slots = p_req->payload[4],
+            .min_slots = p_req->payload[5]
+        };
+        app_phy_sched_cfg_t old_phy_cfg;
+        app_phy_sched_config_get (&old_phy_cfg);
+        err_code |= app_phy_sched_configure (&phy_cfg);
+
+        if (RD_SUCCESS == err_code)
         {
-            size_t len = index;
-            index = 0;
+            err_code |= app_ch_sched_configure (&ch_cfg);
 
-            do
+            if (RD_SUCCESS != err_code)
             {
-                status = rl_ringbuffer_queue (&m_uart_ring_buffer, (void *) (dequeue_data + index),
-                                              sizeof (uint8_t));
-                index++;
-            } while ((RL_SUCCESS == status) && (index < len));
+                // Apply both or neither.
+                (void) app_phy_sched_configure (&old_phy_cfg);
+            }
         }
     }
 
-    if (RD_SUCCESS == err_code)
+    return err_code;
+}
+
+static rd_status_t app_uart_ext_put_stats (const app_uart_ext_frame_t * const p_req,
+        app_uart_ext_frame_t * const p_resp)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    app_stats_t stats;
+    const bool reset = (p_req->len > 0U)
+                       && (0U != (p_req->payload[0] & APP_UART_EXT_STATS_FLAG_RESET));
+    app_stats_get (&stats, reset);
+    err_code |= app_uart_ext_put_u8 (p_resp, (uint8_t) APP_STATS_NUM);
+
+    for (size_t ii = 0; ii < APP_STATS_NUM; ii++)
     {
-        if (RE_CA_UART_GET_DEVICE_ID == m_uart_payload.cmd)
-        {
-            ri_scheduler_event_put (NULL, (uint16_t) 0, app_uart_on_evt_send_device_id);
-        }
-        else if (RE_CA_UART_LED_CTRL == m_uart_payload.cmd)
-        {
-            (void) rt_led_blink_stop (RB_LED_ACTIVITY);
+        err_code |= app_uart_ext_put_u32 (p_resp, stats.counters[ii]);
+    }
 
-            if (0 != m_uart_payload.params.led_ctrl_param.time_interval_ms)
-            {
-                (void) rt_led_blink_once (RB_LED_ACTIVITY,
-                                          m_uart_payload.params.led_ctrl_param.time_interval_ms);
-            }
+    return err_code;
+}
 
-            g_resp_ack_cmd = m_uart_payload.cmd;
-            g_resp_ack_state = true;
-            ri_scheduler_event_put (NULL, (uint16_t) 0, app_uart_on_evt_send_ack);
-        }
-        else
-        {
-            g_resp_ack_cmd = m_uart_payload.cmd;
+static rd_status_t app_uart_ext_put_commit_stats (app_uart_ext_frame_t * const p_resp)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    app_ble_commit_stats_t stats;
+    app_ble_commit_stats_get (&stats);
+    err_code |= app_uart_ext_put_u32 (p_resp, stats.commits);
+    err_code |= app_uart_ext_put_u32 (p_resp, stats.aborts);
+    err_code |= app_uart_ext_put_u32 (p_resp, stats.restarts);
+    err_code |= app_uart_ext_put_u32 (p_resp, stats.last_downtime_ms);
+    err_code |= app_uart_ext_put_u32 (p_resp, stats.max_downtime_ms);
+    err_code |= app_uart_ext_put_u32 (p_resp, stats.total_downtime_ms);
+    return err_code;
+}
 
-            if (RD_SUCCESS == app_uart_apply_config (&m_uart_payload))
-            {
-                g_resp_ack_state = true;
-            }
-            else
-            {
-                g_resp_ack_state = false;
-            }
+static rd_status_t app_uart_ext_put_latency (const app_uart_ext_frame_t * const p_req,
+        app_uart_ext_frame_t * const p_resp)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    app_latency_hist_t hist;
+    const bool reset = (p_req->len > 0U)
+                       && (0U != (p_req->payload[0] & APP_UART_EXT_STATS_FLAG_RESET));
+    app_latency_get (&hist, reset);
+    err_code |= app_uart_ext_put_u8 (p_resp, (uint8_t) APP_LATENCY_BUCKETS);
+    err_code |= app_uart_ext_put_u32 (p_resp, hist.count);
+    err_code |= app_uart_ext_put_u32 (p_resp, hist.max_ms);
+    err_code |= app_uart_ext_put_u32 (p_resp, hist.lost);
+
+    for (size_t ii = 0; ii < APP_LATENCY_BUCKETS; ii++)
+    {
+        err_code |= app_uart_ext_put_u32 (p_resp, hist.buckets[ii]);
+    }
 
-            ri_scheduler_event_put (NULL, (uint16_t) 0, app_uart_on_evt_send_ack);
+    return err_code;
+}
 
-            if (RE_CA_UART_SET_ALL == m_uart_payload.cmd)
-            {
-                m_uart_ack = true;
-                err_code |= app_ble_scan_start(); // Applies new scanning settings.
+static rd_status_t app_uart_ext_put_queues (const app_uart_ext_frame_t * const p_req,
+        app_uart_ext_frame_t * const p_resp)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    app_queue_stats_t stats[APP_QUEUE_NUM];
+    const bool reset = (p_req->len > 0U)
+                       && (0U != (p_req->payload[0] & APP_UART_EXT_STATS_FLAG_RESET));
+    app_queue_stats_get (stats, reset);
+    err_code |= app_uart_ext_put_u8 (p_resp, (uint8_t) APP_QUEUE_NUM);
 
-                if (RD_SUCCESS == err_code)
-                {
-                    ri_watchdog_feed();
-                }
-            }
-        }
+    for (size_t ii = 0; ii < APP_QUEUE_NUM; ii++)
+    {
+        err_code |= app_uart_ext_put_u16 (p_resp, stats[ii].capacity);
+        err_code |= app_uart_ext_put_u16 (p_resp, stats[ii].high_water);
+        err_code |= app_uart_ext_put_u32 (p_resp, stats[ii].full);
     }
+
+    return err_code;
 }
 
-#ifndef CEEDLING
-static
-#endif
-rd_status_t app_uart_isr (ri_comm_evt_t evt,
-                          void * p_data, size_t data_len)
+static rd_status_t app_uart_ext_set_adv_timestamp (const app_uart_ext_frame_t * const p_req)
 {
     rd_status_t err_code = RD_SUCCESS;
 
-    switch (evt)
+    if (1U != p_req->len)
     {
-        case RI_COMM_SENT:
-            err_code |= ri_scheduler_event_put (NULL, (uint16_t)0, app_uart_on_evt_tx_finish);
-            break;
+        err_code |= RD_ERROR_INVALID_LENGTH;
+    }
+    else
+    {
+        m_is_adv_timestamp_enabled = (0U != p_req->payload[0]);
+    }
 
-        case RI_COMM_RECEIVED:
-            err_code |= ri_scheduler_event_put (p_data, (uint16_t) data_len, app_uart_parser);
-            break;
+    return err_code;
+}
 
-        default:
-            // No action needed on connect/disconnect events.
-            break;
+static rd_status_t app_uart_ext_set_adv_seq (const app_uart_ext_frame_t * const p_req)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (1U != p_req->len)
+    {
+        err_code |= RD_ERROR_INVALID_LENGTH;
+    }
+    else
+    {
+        m_is_adv_seq_enabled = (0U != p_req->payload[0]);
     }
 
-    RD_ERROR_CHECK (err_code, ~RD_ERROR_FATAL);
     return err_code;
 }
 
-/** @brief convert baudrate from board definition for driver. */
-static ri_uart_baudrate_t rb_to_ri_baud (const uint32_t rb_baud)
+static rd_status_t app_uart_ext_set_capture (const app_uart_ext_frame_t * const p_req)
 {
-    ri_uart_baudrate_t baud;
+    rd_status_t err_code = RD_SUCCESS;
 
-    switch (rb_baud)
+    if (1U != p_req->len)
     {
-        case RB_UART_BAUDRATE_9600:
-            baud = RI_UART_BAUD_9600;
-            break;
+        err_code |= RD_ERROR_INVALID_LENGTH;
+    }
+    else
+    {
+        m_is_capture_enabled = (0U != p_req->payload[0]);
+    }
 
-        case RB_UART_BAUDRATE_115200:
-            baud = RI_UART_BAUD_115200;
-            break;
+    return err_code;
+}
 
-        default:
-            baud = RI_UART_BAUD_115200;
-            break;
+static rd_status_t app_uart_ext_put_sync (const app_uart_ext_frame_t * const p_req,
+        app_uart_ext_frame_t * const p_resp)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (8U != p_req->len)
+    {
+        err_code |= RD_ERROR_INVALID_LENGTH;
+    }
+    else
+    {
+        const uint32_t dongle_ms = (uint32_t) ri_rtc_millis();
+        err_code |= app_uart_ext_put_u32 (p_resp, app_uart_ext_get_u32 (p_req, 0U));
+        err_code |= app_uart_ext_put_u32 (p_resp, app_uart_ext_get_u32 (p_req, 4U));
+        err_code |= app_uart_ext_put_u32 (p_resp, dongle_ms);
     }
 
-    return baud;
+    return err_code;
 }
 
-static void setup_uart_init (ri_uart_init_t * const p_init)
+static rd_status_t app_uart_ext_put_seq_status (app_uart_ext_frame_t * const p_resp)
 {
-    // Ruuvi board pin definitions are compatible with
-    // Ruuvi driver pin definitions.
-#if APP_USBUART_ENABLED
-    p_init->hwfc_enabled = RB_UART_USB_HWFC_ENABLED;
-    p_init->parity_enabled = RB_UART_USB_PARITY_ENABLED;
-    p_init->cts = RB_UART_USB_CTS_PIN;
-    p_init->rts = RB_UART_USB_RTS_PIN;
-    p_init->tx = RB_UART_USB_TX_PIN;
-    p_init->rx = RB_UART_USB_RX_PIN;
-    p_init->baud = rb_to_ri_baud (RB_UART_BAUDRATE);
-#else
-    p_init->hwfc_enabled = RB_HWFC_ENABLED;
-    p_init->parity_enabled = RB_PARITY_ENABLED;
-    p_init->cts  = RB_UART_CTS_PIN;
-    p_init->rts  = RB_UART_RTS_PIN;
-    p_init->tx   = RB_UART_TX_PIN;
-    p_init->rx   = RB_UART_RX_PIN;
-    p_init->baud = rb_to_ri_baud (RB_UART_BAUDRATE);
-#endif
+    rd_status_t err_code = RD_SUCCESS;
+    err_code |= app_uart_ext_put_u32 (p_resp, m_adv_seq);
+    err_code |= app_uart_ext_put_u32 (p_resp, m_adv_seq_dropped);
+    return err_code;
 }
 
-rd_status_t app_uart_init (void)
+static rd_status_t app_uart_ext_put_prof (const app_uart_ext_frame_t * const p_req,
+        app_uart_ext_frame_t * const p_resp)
 {
     rd_status_t err_code = RD_SUCCESS;
-    ri_uart_init_t config = { 0 };
-    app_uart_init_globs();
-    setup_uart_init (&config);
-    err_code |= ri_uart_init (&m_uart);
+    app_prof_stats_t stats[APP_PROF_NUM];
+    const bool reset = (p_req->len > 0U)
+                       && (0U != (p_req->payload[0] & APP_UART_EXT_STATS_FLAG_RESET));
+    app_prof_get (stats, reset);
+    err_code |= app_uart_ext_put_u8 (p_resp, (uint8_t) APP_PROF_NUM);
 
-    if (RD_SUCCESS == err_code)
+    for (size_t ii = 0; ii < APP_PROF_NUM; ii++)
     {
-        m_uart.on_evt = app_uart_isr;
-        err_code |= ri_uart_config (&config);
+        err_code |= app_uart_ext_put_u32 (p_resp, stats[ii].count);
+        err_code |= app_uart_ext_put_u32 (p_resp, stats[ii].min_cycles);
+        err_code |= app_uart_ext_put_u32 (p_resp, stats[ii].avg_cycles);
+        err_code |= app_uart_ext_put_u32 (p_resp, stats[ii].max_cycles);
     }
 
     return err_code;
 }
 
-static re_ca_uart_ble_phy_e re_ca_uart_encode_ble_phy (const uint8_t phy)
+static rd_status_t app_uart_ext_put_trace (const app_uart_ext_frame_t * const p_req,
+        app_uart_ext_frame_t * const p_resp)
 {
-    re_ca_uart_ble_phy_e encoded_phy = RE_CA_UART_BLE_PHY_NOT_SET;
-
-    switch (phy)
+    rd_status_t err_code = RD_SUCCESS;
+    app_trace_event_t events[ (APP_UART_EXT_PAYLOAD_MAX_LEN - 9U) / APP_TRACE_EVENT_SIZE];
+    uint32_t first = 0;
+    const uint32_t next = app_trace_next_seq();
+    const uint8_t count = app_trace_read (app_uart_ext_get_u32 (p_req, 0U), &first,
+                                          events, (uint8_t) (sizeof (events) / sizeof (events[0])));
+    err_code |= app_uart_ext_put_u32 (p_resp, next);
+    err_code |= app_uart_ext_put_u32 (p_resp, first);
+    err_code |= app_uart_ext_put_u8 (p_resp, count);
+
+    for (uint8_t ii = 0; ii < count; ii++)
+    {
+        err_code |= app_uart_ext_put_u32 (p_resp, events[ii].time_ms);
+        err_code |= app_uart_ext_put_u8 (p_resp, events[ii].id);
+        err_code |= app_uart_ext_put_u8 (p_resp, events[ii].arg0);
+        err_code |= app_uart_ext_put_u16 (p_resp, events[ii].arg1);
+    }
+
+    return err_code;
+}
+
+static rd_status_t app_uart_heartbeat_interval_set (const uint32_t interval_ms)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if ( (0U != interval_ms) && (interval_ms < APP_UART_HEARTBEAT_INTERVAL_MIN_MS))
+    {
+        err_code |= RD_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        if (0U != m_heartbeat_interval_ms)
+        {
+            err_code |= ri_timer_stop (m_heartbeat_timer);
+        }
+
+        m_heartbeat_interval_ms = 0U;
+
+        if ( (RD_SUCCESS == err_code) && (0U != interval_ms))
+        {
+            err_code |= ri_timer_start (m_heartbeat_timer, interval_ms, NULL);
+
+            if (RD_SUCCESS == err_code)
+            {
+                m_heartbeat_interval_ms = interval_ms;
+            }
+        }
+    }
+
+    return err_code;
+}
+
+static rd_status_t app_uart_ext_set_heartbeat (const app_uart_ext_frame_t * const p_req)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (4U != p_req->len)
+    {
+        err_code |= RD_ERROR_INVALID_LENGTH;
+    }
+    else
+    {
+        err_code |= app_uart_heartbeat_interval_set (app_uart_ext_get_u32 (p_req, 0U));
+    }
+
+    return err_code;
+}
+
+static rd_status_t app_uart_ext_set_timing (const app_uart_ext_frame_t * const p_req)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (8U != p_req->len)
+    {
+        err_code |= RD_ERROR_INVALID_LENGTH;
+    }
+    else
+    {
+        const app_ble_scan_timing_t timing =
+        {
+            .interval_ms = app_uart_ext_get_u16 (p_req, 0U),
+            .window_ms = app_uart_ext_get_u16 (p_req, 2U),
+            .timeout_ms = app_uart_ext_get_u32 (p_req, 4U)
+        };
+        err_code |= app_ble_config_begin();
+
+        if (RD_SUCCESS == err_code)
+        {
+            err_code |= app_ble_scan_timing_set (&timing);
+
+            if (RD_SUCCESS == err_code)
+            {
+                err_code |= app_ble_config_commit();
+            }
+            else
+            {
+                (void) app_ble_config_abort();
+            }
+        }
+    }
+
+    return err_code;
+}
+
+/**
+ * @brief Process a gateway-specific command and schedule the response.
+ *
+ * @param[in] p_req Decoded command.
+ */
+static void app_uart_ext_process (const app_uart_ext_frame_t * const p_req)
+{
+    bool is_known = true;
+    app_trace_record (APP_TRACE_CMD_RX, p_req->cmd, p_req->len);
+    memset (&m_ext_response, 0, sizeof (m_ext_response));
+    m_ext_response.cmd = p_req->cmd;
+
+    switch (p_req->cmd)
+    {
+        case APP_UART_EXT_GET_SCAN_STATS:
+            (void) app_uart_ext_put_sched_stats (&m_ext_response);
+            break;
+
+        case APP_UART_EXT_SET_SCAN_SCHED:
+            (void) app_uart_ext_put_u8 (&m_ext_response,
+                                        (RD_SUCCESS == app_uart_ext_set_sched (p_req)) ? 0U : 1U);
+            break;
+
+        case APP_UART_EXT_GET_STATS:
+            (void) app_uart_ext_put_stats (p_req, &m_ext_response);
+            break;
+
+        case APP_UART_EXT_GET_LATENCY:
+            (void) app_uart_ext_put_latency (p_req, &m_ext_response);
+            break;
+
+        case APP_UART_EXT_GET_QUEUES:
+            (void) app_uart_ext_put_queues (p_req, &m_ext_response);
+            break;
+
+        case APP_UART_EXT_SET_ADV_TIMESTAMP:
+            (void) app_uart_ext_put_u8 (&m_ext_response,
+                                        (RD_SUCCESS == app_uart_ext_set_adv_timestamp (p_req)) ? 0U : 1U);
+            break;
+
+        case APP_UART_EXT_SYNC_TIME:
+            // Malformed request is answered with empty payload.
+            (void) app_uart_ext_put_sync (p_req, &m_ext_response);
+            break;
+
+        case APP_UART_EXT_GET_SEQ_STATUS:
+            (void) app_uart_ext_put_seq_status (&m_ext_response);
+            break;
+
+        case APP_UART_EXT_GET_PROF:
+            (void) app_uart_ext_put_prof (p_req, &m_ext_response);
+            break;
+
+        case APP_UART_EXT_GET_TRACE:
+            (void) app_uart_ext_put_trace (p_req, &m_ext_response);
+            break;
+
+        case APP_UART_EXT_SET_HEARTBEAT:
+            (void) app_uart_ext_put_u8 (&m_ext_response,
+                                        (RD_SUCCESS == app_uart_ext_set_heartbeat (p_req)) ? 0U : 1U);
+            break;
+
+        case APP_UART_EXT_SET_SCAN_TIMING:
+            (void) app_uart_ext_put_u8 (&m_ext_response,
+                                        (RD_SUCCESS == app_uart_ext_set_timing (p_req)) ? 0U : 1U);
+            break;
+
+        case APP_UART_EXT_SET_CAPTURE:
+            (void) app_uart_ext_put_u8 (&m_ext_response,
+                                        (RD_SUCCESS == app_uart_ext_set_capture (p_req)) ? 0U : 1U);
+            break;
+
+        case APP_UART_EXT_GET_COMMIT_STATS:
+            (void) app_uart_ext_put_commit_stats (&m_ext_response);
+            break;
+
+        case APP_UART_EXT_SET_ADV_SEQ:
+            (void) app_uart_ext_put_u8 (&m_ext_response,
+                                        (RD_SUCCESS == app_uart_ext_set_adv_seq (p_req)) ? 0U : 1U);
+            break;
+
+        default:
+            is_known = false;
+            break;
+    }
+
+    if (is_known)
+    {
+        ri_scheduler_event_put (NULL, (uint16_t) 0, app_uart_on_evt_send_ext);
+    }
+}
+
+#if 0
+#ifndef CEEDLING
+static
+#endif
+void app_uart_repeat_send (void * p_data, uint16_t data_len)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    ri_comm_message_t msg = {0};
+    msg.repeat_count = 1;
+    msg.data_length = data_len;
+    memcpy (msg.data, p_data, data_len);
+    err_code |= app_uart_send_msg (&msg);
+
+    if (RE_SUCCESS != err_code)
+    {
+        err_code |= ri_scheduler_event_put (msg.data, (uint16_t) msg.data_length,
+                                            app_uart_repeat_send);
+    }
+}
+#endif
+
+/** @brief Check if command changes scan configuration in app_uart_apply_config. */
+static bool app_uart_is_config_cmd (const re_ca_uart_cmd_t cmd)
+{
+    bool is_config = false;
+
+    switch (cmd)
+    {
+        case RE_CA_UART_SET_FLTR_TAGS:
+        case RE_CA_UART_SET_FLTR_ID:
+        case RE_CA_UART_SET_CODED_PHY:
+        case RE_CA_UART_SET_SCAN_1MB_PHY:
+        case RE_CA_UART_SET_SCAN_2MB_PHY:
+        case RE_CA_UART_SET_CH_37:
+        case RE_CA_UART_SET_CH_38:
+        case RE_CA_UART_SET_CH_39:
+        case RE_CA_UART_SET_ALL:
+            is_config = true;
+            break;
+
+        default:
+            break;
+    }
+
+    return is_config;
+}
+
+/** @brief Handle a decoded Ruuvi CA UART endpoint command. */
+static void app_uart_ca_process (void)
+{
+    app_stats_inc (APP_STATS_RX_FRAMES);
+    app_trace_record (APP_TRACE_CMD_RX, (uint8_t) m_uart_payload.cmd, 0U);
+
+    if (RE_CA_UART_GET_DEVICE_ID == m_uart_payload.cmd)
+    {
+        ri_scheduler_event_put (NULL, (uint16_t) 0, app_uart_on_evt_send_device_id);
+    }
+    else if (RE_CA_UART_LED_CTRL == m_uart_payload.cmd)
+    {
+        (void) rt_led_blink_stop (RB_LED_ACTIVITY);
+
+        if (0 != m_uart_payload.params.led_ctrl_param.time_interval_ms)
+        {
+            (void) rt_led_blink_once (RB_LED_ACTIVITY,
+                                      m_uart_payload.params.led_ctrl_param.time_interval_ms);
+        }
+
+        g_resp_ack_cmd = m_uart_payload.cmd;
+        g_resp_ack_state = true;
+        ri_scheduler_event_put (NULL, (uint16_t) 0, app_uart_on_evt_send_ack);
+    }
+    else if (!app_uart_is_config_cmd (m_uart_payload.cmd))
+    {
+        g_resp_ack_cmd = m_uart_payload.cmd;
+        g_resp_ack_state = false;
+        ri_scheduler_event_put (NULL, (uint16_t) 0, app_uart_on_evt_send_ack);
+    }
+    else
+    {
+        rd_status_t err_code = app_ble_config_begin();
+        g_resp_ack_cmd = m_uart_payload.cmd;
+
+        if (RD_SUCCESS == err_code)
+        {
+            err_code |= app_uart_apply_config (&m_uart_payload);
+
+            if (RD_SUCCESS == err_code)
+            {
+                // Restarts scanning only if the effective settings changed.
+                err_code |= app_ble_config_commit();
+            }
+            else
+            {
+                // Partially applied command must not reach the radio.
+                (void) app_ble_config_abort();
+            }
+        }
+
+        g_resp_ack_state = (RD_SUCCESS == err_code);
+        ri_scheduler_event_put (NULL, (uint16_t) 0, app_uart_on_evt_send_ack);
+
+        // Configuration is polled again until it has been applied.
+        if ( (RE_CA_UART_SET_ALL == m_uart_payload.cmd) && (RD_SUCCESS == err_code))
+        {
+            if (!m_uart_ack)
+            {
+                m_boot_stats.config_ms = (uint32_t) ri_rtc_millis();
+                m_boot_stats.is_configured = true;
+            }
+
+            m_uart_ack = true;
+        }
+    }
+}
+
+/**
+ * @brief Handle a complete frame received over UART, gateway-specific or
+ *        Ruuvi CA UART endpoint command.
+ *
+ * @param[in] p_frame Frame from STX to ETX.
+ * @param[in] len Bytes in frame.
+ * @return True if frame decoded.
+ */
+#ifndef CEEDLING
+static
+#endif
+bool app_uart_on_frame (const uint8_t * const p_frame, const size_t len)
+{
+    bool is_valid = false;
+
+    if (RD_SUCCESS == app_uart_ext_decode (p_frame, len, &m_ext_request))
+    {
+        app_stats_inc (APP_STATS_RX_FRAMES);
+        app_uart_ext_process (&m_ext_request);
+        is_valid = true;
+    }
+    else
+    {
+        memset (&m_uart_payload, 0, sizeof (m_uart_payload));
+
+        if (RE_SUCCESS == re_ca_uart_decode (p_frame, &m_uart_payload))
+        {
+            app_uart_ca_process();
+            is_valid = true;
+        }
+    }
+
+    return is_valid;
+}
+
+#ifndef CEEDLING
+static
+#endif
+void app_uart_parser (void * p_data, uint16_t data_len)
+{
+    APP_PROF_START (APP_PROF_PARSER);
+    app_queue_sched_done (APP_QUEUE_SRC_UART);
+    app_uart_rx_put ( (const uint8_t *) p_data, data_len, &app_uart_on_frame);
+    APP_PROF_STOP (APP_PROF_PARSER);
+}
+
+#ifndef CEEDLING
+static
+#endif
+rd_status_t app_uart_isr (ri_comm_evt_t evt,
+                          void * p_data, size_t data_len)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    switch (evt)
+    {
+        case RI_COMM_SENT:
+            err_code |= ri_scheduler_event_put (NULL, (uint16_t)0, app_uart_on_evt_tx_finish);
+            break;
+
+        case RI_COMM_RECEIVED:
+            err_code |= ri_scheduler_event_put (p_data, (uint16_t) data_len, app_uart_parser);
+            break;
+
+        default:
+            // No action needed on connect/disconnect events.
+            break;
+    }
+
+    if (RD_SUCCESS != err_code)
+    {
+        app_stats_inc (APP_STATS_DROP_SCHED_FULL);
+        app_queue_full_record (APP_QUEUE_SCHED);
+        app_trace_record (APP_TRACE_ENQUEUE_FAIL, (uint8_t) APP_QUEUE_SCHED, 0U);
+    }
+    else if ( (RI_COMM_SENT == evt) || (RI_COMM_RECEIVED == evt))
+    {
+        app_queue_sched_put (APP_QUEUE_SRC_UART);
+    }
+    else
+    {
+        // No event was put.
+    }
+
+    RD_ERROR_CHECK (err_code, ~RD_ERROR_FATAL);
+    return err_code;
+}
+
+/** @brief convert baudrate from board definition for driver. */
+static ri_uart_baudrate_t rb_to_ri_baud (const uint32_t rb_baud)
+{
+    ri_uart_baudrate_t baud;
+
+    switch (rb_baud)
+    {
+        case RB_UART_BAUDRATE_9600:
+            baud = RI_UART_BAUD_9600;
+            break;
+
+        case RB_UART_BAUDRATE_115200:
+            baud = RI_UART_BAUD_115200;
+            break;
+
+        default:
+            baud = RI_UART_BAUD_115200;
+            break;
+    }
+
+    return baud;
+}
+
+static void setup_uart_init (ri_uart_init_t * const p_init)
+{
+    // Ruuvi board pin definitions are compatible with
+    // Ruuvi driver pin definitions.
+#if APP_USBUART_ENABLED
+    p_init->hwfc_enabled = RB_UART_USB_HWFC_ENABLED;
+    p_init->parity_enabled = RB_UART_USB_PARITY_ENABLED;
+    p_init->cts = RB_UART_USB_CTS_PIN;
+    p_init->rts = RB_UART_USB_RTS_PIN;
+    p_init->tx = RB_UART_USB_TX_PIN;
+    p_init->rx = RB_UART_USB_RX_PIN;
+    p_init->baud = rb_to_ri_baud (RB_UART_BAUDRATE);
+#else
+    p_init->hwfc_enabled = RB_HWFC_ENABLED;
+    p_init->parity_enabled = RB_PARITY_ENABLED;
+    p_init->cts  = RB_UART_CTS_PIN;
+    p_init->rts  = RB_UART_RTS_PIN;
+    p_init->tx   = RB_UART_TX_PIN;
+    p_init->rx   = RB_UART_RX_PIN;
+    p_init->baud = rb_to_ri_baud (RB_UART_BAUDRATE);
+#endif
+}
+
+rd_status_t app_uart_init (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    ri_uart_init_t config = { 0 };
+    app_uart_init_globs();
+    app_queue_capacity_set (APP_QUEUE_UART_RX, APP_UART_RX_BUFFER_LEN);
+    setup_uart_init (&config);
+    err_code |= ri_uart_init (&m_uart);
+
+    if (RD_SUCCESS == err_code)
+    {
+        m_uart.on_evt = app_uart_isr;
+        err_code |= ri_uart_config (&config);
+    }
+
+    return err_code;
+}
+
+static re_ca_uart_ble_phy_e re_ca_uart_encode_ble_phy (const uint8_t phy)
+{
+    re_ca_uart_ble_phy_e encoded_phy = RE_CA_UART_BLE_PHY_NOT_SET;
+
+    switch (phy)
     {
         case BLE_GAP_PHY_AUTO:
             encoded_phy = RE_CA_UART_BLE_PHY_AUTO;
@@ -586,6 +1146,115 @@ static re_ca_uart_ble_phy_e re_ca_uart_encode_ble_phy (const uint8_t phy)
     return encoded_phy;
 }
 
+_Static_assert ( (21U + RE_CA_UART_ADV_BYTES) <= APP_UART_EXT_PAYLOAD_MAX_LEN,
+                 "Timestamped advertisement report must fit in one frame.");
+
+/**
+ * @brief Encode advertisement report with sequence number and optionally
+ *        reception time.
+ *
+ * Reception time is taken from the advertisement being handled, or current
+ * time if not known.
+ *
+ * @param[in,out] p_msg Message to encode to, data_length is size of buffer on input.
+ * @param[in] p_adv Advertisement to encode.
+ * @param[in] seq Sequence number of advertisement.
+ * @param[in] is_timestamped True to encode APP_UART_EXT_ADV_RPRT_TS,
+ *                           false to encode APP_UART_EXT_ADV_RPRT_SEQ.
+ * @return RD_SUCCESS on success, error code from encoder otherwise.
+ */
+static rd_status_t app_uart_encode_adv_seq (ri_comm_message_t * const p_msg,
+        const re_ca_uart_ble_adv_t * const p_adv, const uint32_t seq,
+        const bool is_timestamped)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    app_uart_ext_frame_t frame = {.len = 0};
+    uint32_t rx_ms = 0;
+    err_code |= app_uart_ext_put_u32 (&frame, seq);
+
+    if (is_timestamped)
+    {
+        frame.cmd = APP_UART_EXT_ADV_RPRT_TS;
+
+        if (!app_latency_rx_ms_get (&rx_ms))
+        {
+            rx_ms = (uint32_t) ri_rtc_millis();
+        }
+
+        err_code |= app_uart_ext_put_u32 (&frame, rx_ms);
+    }
+    else
+    {
+        frame.cmd = APP_UART_EXT_ADV_RPRT_SEQ;
+    }
+
+    for (size_t ii = 0; ii < sizeof (p_adv->mac); ii++)
+    {
+        err_code |= app_uart_ext_put_u8 (&frame, p_adv->mac[ii]);
+    }
+
+    err_code |= app_uart_ext_put_u8 (&frame, (uint8_t) p_adv->rssi_db);
+    err_code |= app_uart_ext_put_u8 (&frame, (uint8_t) p_adv->primary_phy);
+    err_code |= app_uart_ext_put_u8 (&frame, (uint8_t) p_adv->secondary_phy);
+    err_code |= app_uart_ext_put_u8 (&frame, p_adv->ch_index);
+    err_code |= app_uart_ext_put_u8 (&frame, p_adv->is_coded_phy ? 1U : 0U);
+    err_code |= app_uart_ext_put_u8 (&frame, (uint8_t) p_adv->tx_power);
+    err_code |= app_uart_ext_put_u8 (&frame, p_adv->adv_len);
+
+    for (size_t ii = 0; ii < p_adv->adv_len; ii++)
+    {
+        err_code |= app_uart_ext_put_u8 (&frame, p_adv->adv[ii]);
+    }
+
+    if (RD_SUCCESS == err_code)
+    {
+        err_code |= app_uart_ext_encode (p_msg->data, &p_msg->data_length, &frame);
+    }
+
+    return err_code;
+}
+
+/**
+ * @brief Send received advertisement as capture record.
+ *
+ * @param[in] p_scan Received advertisement.
+ * @return RD_SUCCESS if record was accepted by UART driver.
+ */
+static rd_status_t app_uart_send_capture (const ri_adv_scan_t * const p_scan)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    app_uart_ext_frame_t frame = {.cmd = APP_UART_EXT_CAPTURE, .len = 0};
+    ri_comm_message_t msg = {0};
+    size_t len = sizeof (frame.payload);
+    uint32_t rx_ms = 0;
+
+    if (!app_latency_rx_ms_get (&rx_ms))
+    {
+        rx_ms = (uint32_t) ri_rtc_millis();
+    }
+
+    err_code |= app_capture_encode (frame.payload, &len, rx_ms, p_scan);
+    frame.len = (uint8_t) len;
+    msg.data_length = sizeof (msg.data);
+    msg.repeat_count = 1;
+
+    if (RD_SUCCESS == err_code)
+    {
+        err_code |= app_uart_ext_encode (msg.data, &msg.data_length, &frame);
+    }
+
+    if (RD_SUCCESS == err_code)
+    {
+        err_code |= app_uart_send_msg (&msg);
+    }
+    else
+    {
+        app_stats_inc (APP_STATS_ENCODE_ERRORS);
+    }
+
+    return err_code;
+}
+
 rd_status_t app_uart_send_broadcast (const ri_adv_scan_t * const scan)
 {
     re_ca_uart_payload_t adv = {0};
@@ -594,11 +1263,16 @@ rd_status_t app_uart_send_broadcast (const ri_adv_scan_t * const scan)
     rd_status_t err_code = RD_SUCCESS;
     re_status_t re_code = RE_SUCCESS;
     uint16_t manuf_id;
+    APP_PROF_START (APP_PROF_SEND_BROADCAST);
 
     if (NULL == scan)
     {
         err_code |= RD_ERROR_NULL;
     }
+    else if (m_is_capture_enabled)
+    {
+        err_code |= app_uart_send_capture (scan);
+    }
     else if (RE_CA_UART_ADV_BYTES >= scan->data_len)
     {
         memcpy (adv.params.adv.mac, scan->addr, sizeof (adv.params.adv.mac));
@@ -630,56 +1304,77 @@ rd_status_t app_uart_send_broadcast (const ri_adv_scan_t * const scan)
 
         if (flag_discard)
         {
+            app_stats_inc (APP_STATS_FLTR_MANUF_ID);
             err_code |= RD_ERROR_INVALID_DATA;
-            NRF_LOG_DEBUG ("app_uart_send_broadcast: discard: manufacturer_id=0x%04x: addr=%s: len=%d",
-                           manuf_id,
-                           mac_addr_to_str (scan->addr).buf,
-                           scan->data_len,
-                           scan->primary_phy,
-                           scan->secondary_phy,
-                           scan->ch_index);
+            APP_LOG (RI_LOG_LEVEL_DEBUG, scan->addr, NULL, 0U,
+                     "app_uart_send_broadcast: discard: manufacturer_id=0x%04x: addr=%s: len=%d",
+                     manuf_id, scan->data_len);
         }
         else
         {
             _Static_assert (sizeof (msg.data) <= UINT8_MAX, "sizeof (msg) <= UINT8_MAX");
             msg.data_length = (uint8_t)sizeof (msg.data);
-            re_code = re_ca_uart_encode (msg.data, &msg.data_length, &adv);
+            const uint32_t seq = __atomic_fetch_add (&m_adv_seq, 1U, __ATOMIC_RELAXED);
+            APP_PROF_START (APP_PROF_ENCODE);
+
+            if (m_is_adv_timestamp_enabled || m_is_adv_seq_enabled)
+            {
+                re_code = (RD_SUCCESS == app_uart_encode_adv_seq (&msg, &adv.params.adv, seq,
+                           m_is_adv_timestamp_enabled))
+                          ? RE_SUCCESS : RE_ERROR_ENCODING;
+            }
+            else
+            {
+                re_code = re_ca_uart_encode (msg.data, &msg.data_length, &adv);
+            }
+
+            APP_PROF_STOP (APP_PROF_ENCODE);
+
             msg.repeat_count = 1;
 
             if (RE_SUCCESS == re_code)
             {
-                NRF_LOG_INFO ("app_uart_send_broadcast: addr=%s: len=%d, primary_phy=%d, secondary_phy=%d, chan=%d, tx_power=%d",
-                              mac_addr_to_str (scan->addr).buf,
-                              scan->data_len,
-                              scan->primary_phy,
-                              scan->secondary_phy,
-                              scan->ch_index,
-                              scan->tx_power);
-                //NRF_LOG_HEXDUMP_INFO (scan->data, scan->data_len);
-                NRF_LOG_INFO ("app_uart_send_broadcast: encoded: len=%d", msg.data_length);
-                NRF_LOG_HEXDUMP_INFO (msg.data, msg.data_length);
+                APP_LOG (RI_LOG_LEVEL_INFO, scan->addr, NULL, 0U,
+                         "app_uart_send_broadcast: addr=%s: len=%d, primary_phy=%d, secondary_phy=%d, chan=%d, tx_power=%d",
+                         scan->data_len, scan->primary_phy, scan->secondary_phy,
+                         scan->ch_index, scan->tx_power);
+                APP_LOG (RI_LOG_LEVEL_INFO, NULL, msg.data, msg.data_length,
+                         "app_uart_send_broadcast: encoded: len=%d", msg.data_length);
                 err_code |= app_uart_send_msg (&msg);
+
+                if ((RD_SUCCESS == err_code) && (!m_boot_stats.is_first_adv_sent))
+                {
+                    m_boot_stats.first_adv_ms = (uint32_t) ri_rtc_millis();
+                    m_boot_stats.is_first_adv_sent = true;
+                }
             }
             else
             {
                 NRF_LOG_ERROR ("%s: re_ca_uart_encode failed", __func__);
+                app_stats_inc (APP_STATS_ENCODE_ERRORS);
                 err_code |= RD_ERROR_INVALID_DATA;
             }
+
+            if (RD_SUCCESS != err_code)
+            {
+                (void) __atomic_fetch_add (&m_adv_seq_dropped, 1U, __ATOMIC_RELAXED);
+            }
         }
     }
     else
     {
-        NRF_LOG_ERROR ("%s: addr=%s: data len=%d > RE_CA_UART_ADV_BYTES (%d)",
-                       __func__,
-                       mac_addr_to_str (scan->addr).buf,
-                       scan->data_len, RE_CA_UART_ADV_BYTES);
+        APP_LOG (RI_LOG_LEVEL_ERROR, scan->addr, NULL, 0U,
+                 "app_uart_send_broadcast: addr=%s: data len=%d > RE_CA_UART_ADV_BYTES (%d)",
+                 scan->data_len, RE_CA_UART_ADV_BYTES);
+        app_stats_inc (APP_STATS_FLTR_TOO_LONG);
         err_code |= RD_ERROR_DATA_SIZE;
     }
 
+    APP_PROF_STOP (APP_PROF_SEND_BROADCAST);
     return err_code;
 }
 
-rd_status_t app_uart_poll_configuration (void)
+static rd_status_t app_uart_send_poll (void)
 {
     re_ca_uart_payload_t cfg = {0};
     ri_comm_message_t msg = {0};
@@ -688,24 +1383,168 @@ rd_status_t app_uart_poll_configuration (void)
     msg.data_length = sizeof (msg.data);
     cfg.cmd = RE_CA_UART_GET_ALL;
     re_code = re_ca_uart_encode (msg.data, &msg.data_length, &cfg);
-    msg.repeat_count = RI_COMM_MSG_REPEAT_FOREVER;
+    msg.repeat_count = 1;
 
     if (RE_SUCCESS == re_code)
     {
         err_code |= app_uart_send_msg (&msg);
+        m_boot_stats.polls++;
+    }
+    else
+    {
+        err_code |= RD_ERROR_INVALID_DATA;
+    }
+
+    return err_code;
+}
 
-        do
+#ifndef CEEDLING
+static
+#endif
+void app_uart_on_evt_poll_timeout (void * p_data, uint16_t data_len)
+{
+    (void)p_data;
+    (void)data_len;
+
+    if (!m_uart_ack)
+    {
+        // A failed poll is retried on next timeout.
+        (void) app_uart_send_poll();
+        m_poll_interval_ms *= 2U;
+
+        if (m_poll_interval_ms > APP_UART_POLL_INTERVAL_MAX_MS)
         {
-            ri_scheduler_execute();
-            ri_yield();
-        } while (!m_uart_ack);
+            m_poll_interval_ms = APP_UART_POLL_INTERVAL_MAX_MS;
+        }
+
+        (void) ri_timer_start (m_poll_timer, m_poll_interval_ms, NULL);
+    }
+}
+
+/** @brief Timer runs in interrupt context, defer polling to scheduler. */
+static void app_uart_poll_timer_isr (void * const p_context)
+{
+    (void)p_context;
+    (void) ri_scheduler_event_put (NULL, (uint16_t) 0, app_uart_on_evt_poll_timeout);
+}
+
+rd_status_t app_uart_poll_configuration (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    m_poll_interval_ms = APP_UART_POLL_INTERVAL_MIN_MS;
+
+    if (NULL == m_poll_timer)
+    {
+        err_code |= ri_timer_create (&m_poll_timer, RI_TIMER_MODE_SINGLE_SHOT,
+                                     &app_uart_poll_timer_isr);
+    }
+
+    if (NULL != m_poll_timer)
+    {
+        // A failed first poll is retried on timeout like later polls.
+        err_code |= ri_timer_start (m_poll_timer, m_poll_interval_ms, NULL);
+    }
+
+    err_code |= app_uart_send_poll();
+    return err_code;
+}
+
+static rd_status_t app_uart_put_heartbeat (app_uart_ext_frame_t * const p_frame)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    app_ble_restart_stats_t restarts;
+    app_stats_t stats;
+    app_queue_stats_t queues[APP_QUEUE_NUM];
+    app_ble_restart_stats_get (&restarts);
+    app_stats_get (&stats, false);
+    app_queue_stats_get (queues, false);
+    err_code |= app_uart_ext_put_u32 (p_frame, (uint32_t) ri_rtc_millis());
+    err_code |= app_uart_ext_put_u32 (p_frame, m_reset_reason);
+    err_code |= app_uart_ext_put_u8 (p_frame, (uint8_t) app_ble_modulation_get());
+    err_code |= app_uart_ext_put_u32 (p_frame, restarts.fast_restarts);
+    err_code |= app_uart_ext_put_u32 (p_frame, restarts.full_restarts);
+    err_code |= app_uart_ext_put_u32 (p_frame, stats.counters[APP_STATS_DROP_SCHED_FULL]);
+    err_code |= app_uart_ext_put_u32 (p_frame, stats.counters[APP_STATS_DROP_UART_BUSY]);
+    err_code |= app_uart_ext_put_u32 (p_frame, m_adv_seq);
+    err_code |= app_uart_ext_put_u32 (p_frame, m_adv_seq_dropped);
+    err_code |= app_uart_ext_put_u32 (p_frame, m_boot_stats.polls);
+    err_code |= app_uart_ext_put_u32 (p_frame, m_boot_stats.config_ms);
+    err_code |= app_uart_ext_put_u32 (p_frame, m_boot_stats.first_adv_ms);
+    err_code |= app_uart_ext_put_u8 (p_frame, (uint8_t) APP_QUEUE_NUM);
+
+    for (size_t ii = 0; ii < APP_QUEUE_NUM; ii++)
+    {
+        err_code |= app_uart_ext_put_u16 (p_frame, queues[ii].level);
+        err_code |= app_uart_ext_put_u16 (p_frame, queues[ii].high_water);
+    }
+
+    return err_code;
+}
+
+#ifndef CEEDLING
+static
+#endif
+void app_uart_on_evt_heartbeat (void * p_data, uint16_t data_len)
+{
+    (void) p_data;
+    (void) data_len;
+    app_uart_ext_frame_t frame = {.cmd = APP_UART_EXT_HEARTBEAT, .len = 0};
+    ri_comm_message_t msg = {0};
+    rd_status_t err_code = app_uart_put_heartbeat (&frame);
+    msg.data_length = sizeof (msg.data);
+    msg.repeat_count = 1;
+
+    if (RD_SUCCESS == err_code)
+    {
+        err_code |= app_uart_ext_encode (msg.data, &msg.data_length, &frame);
+    }
+
+    if (RD_SUCCESS == err_code)
+    {
+        // Next heartbeat is sent even if UART is busy now.
+        (void) app_uart_send_msg (&msg);
     }
     else
     {
-        err_code |= RD_ERROR_INVALID_DATA;
+        app_stats_inc (APP_STATS_ENCODE_ERRORS);
+    }
+}
+
+/** @brief Timer runs in interrupt context, defer heartbeat to scheduler. */
+static void app_uart_heartbeat_timer_isr (void * const p_context)
+{
+    (void) p_context;
+    (void) ri_scheduler_event_put (NULL, (uint16_t) 0, app_uart_on_evt_heartbeat);
+}
+
+rd_status_t app_uart_heartbeat_init (const uint32_t reset_reason)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    m_reset_reason = reset_reason;
+
+    if (NULL == m_heartbeat_timer)
+    {
+        err_code |= ri_timer_create (&m_heartbeat_timer, RI_TIMER_MODE_REPEATED,
+                                     &app_uart_heartbeat_timer_isr);
+    }
+
+    if ( (RD_SUCCESS == err_code) && (0U != APP_UART_HEARTBEAT_INTERVAL_MS))
+    {
+        err_code |= app_uart_heartbeat_interval_set (APP_UART_HEARTBEAT_INTERVAL_MS);
     }
 
     return err_code;
 }
 
+void app_uart_boot_stats_get (app_uart_boot_stats_t * const p_stats)
+{
+    *p_stats = m_boot_stats;
+}
+
+void app_uart_adv_seq_drop (void)
+{
+    (void) __atomic_fetch_add (&m_adv_seq, 1U, __ATOMIC_RELAXED);
+    (void) __atomic_fetch_add (&m_adv_seq_dropped, 1U, __ATOMIC_RELAXED);
+}
+
 /** @} */
@@ -19,14 +19,26 @@
 #include "ruuvi_driver_error.h"
 #include "ruuvi_interface_communication_ble_advertising.h"
 
+/** @brief Statistics of the configuration handshake after boot. */
+typedef struct
+{
+    uint32_t polls;          //!< Number of GET_ALL polls sent.
+    uint32_t config_ms;      //!< Time from boot to first SET_ALL from ESP32.
+    uint32_t first_adv_ms;   //!< Time from boot to first forwarded advertisement.
+    bool is_configured;      //!< True if config_ms is valid.
+    bool is_first_adv_sent;  //!< True if first_adv_ms is valid.
+} app_uart_boot_stats_t;
+
 #ifdef CEEDLING
 // Assist function for unit tests.
 void app_uart_init_globs (void);
-bool app_uart_ringbuffer_lock_dummy (volatile uint32_t * const flag, bool lock);
+bool app_uart_on_frame (const uint8_t * const p_frame, const size_t len);
 void app_uart_parser (void * p_data, uint16_t data_len);
 void app_uart_on_evt_send_device_id (void * p_data, uint16_t data_len);
 void app_uart_on_evt_send_ack (void * p_data, uint16_t data_len);
 void app_uart_on_evt_tx_finish (void * p_data, uint16_t data_len);
+void app_uart_on_evt_poll_timeout (void * p_data, uint16_t data_len);
+void app_uart_on_evt_heartbeat (void * p_data, uint16_t data_len);
 #if 0
 void app_uart_repeat_send (void * p_data, uint16_t data_len);
 #endif
@@ -66,11 +78,46 @@ rd_status_t app_uart_send_broadcast (const ri_adv_scan_t * const scan);
  * @brief Poll scanning configuration through UART.
  *
  * The format is defined by ruuvi.endpoints.c/
+ * Does not block, scanning can run with the current configuration while
+ * waiting for the reply. Poll is repeated with exponential backoff from
+ * @ref APP_UART_POLL_INTERVAL_MIN_MS to @ref APP_UART_POLL_INTERVAL_MAX_MS
+ * until SET_ALL is received, and the received configuration is applied
+ * to the running scan.
  *
  * @retval RD_SUCCESS If encoding and queuing data to UART was successful.
  * @retval RD_ERROR_INVALID_DATA If poll cannot be encoded for any reason.
+ * @return Error code from timer if polling cannot be repeated.
  */
 rd_status_t app_uart_poll_configuration (void);
 
+/**
+ * @brief Start sending heartbeat frames.
+ *
+ * APP_UART_EXT_HEARTBEAT is sent every @ref APP_UART_HEARTBEAT_INTERVAL_MS,
+ * host can change the interval with APP_UART_EXT_SET_HEARTBEAT.
+ *
+ * @param[in] reset_reason Reason of latest reset, reported in heartbeats.
+ * @retval RD_SUCCESS on success.
+ * @return Error code from timer otherwise.
+ */
+rd_status_t app_uart_heartbeat_init (const uint32_t reset_reason);
+
+/**
+ * @brief Get statistics of the configuration handshake after boot.
+ *
+ * @param[out] p_stats Statistics.
+ */
+void app_uart_boot_stats_get (app_uart_boot_stats_t * const p_stats);
+
+/**
+ * @brief Account an advertisement dropped before it reached app_uart.
+ *
+ * The advertisement takes the next sequence number and is counted as
+ * dropped, so that it shows in APP_UART_EXT_GET_SEQ_STATUS. Call only for
+ * advertisements which pass the manufacturer filter, filtered advertisements
+ * never take a sequence number. Safe to call from interrupt context.
+ */
+void app_uart_adv_seq_drop (void);
+
 /** @} */
 #endif
@@ -0,0 +1,191 @@
+/**
+ * @addtogroup APP_UART_EXT
+ * @{
+ */
+/**
+ *  @file app_uart_ext.c
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Gateway-specific UART commands.
+ */
+#include "app_uart_ext.h"
+#include <string.h>
+#include "ruuvi_endpoint_ca_uart.h"
+
+#define APP_UART_EXT_STX_IDX     (0U) //!< Index of STX.
+#define APP_UART_EXT_LEN_IDX     (1U) //!< Index of payload length.
+#define APP_UART_EXT_CMD_IDX     (2U) //!< Index of command.
+#define APP_UART_EXT_PAYLOAD_IDX (3U) //!< Index of payload.
+#define APP_UART_EXT_CRC_INIT    (0xFFFFU) //!< CRC-16/CCITT-FALSE initial value.
+#define APP_UART_EXT_CRC_POLY    (0x1021U) //!< CRC-16/CCITT-FALSE polynomial.
+
+uint16_t app_uart_ext_crc16 (const uint8_t * const p_data, const size_t len)
+{
+    uint16_t crc = APP_UART_EXT_CRC_INIT;
+
+    for (size_t ii = 0; ii < len; ii++)
+    {
+        crc ^= (uint16_t) ( (uint16_t) p_data[ii] << 8U);
+
+        for (uint8_t bit = 0; bit < 8U; bit++)
+        {
+            if (0U != (crc & 0x8000U))
+            {
+                crc = (uint16_t) ( (uint16_t) (crc << 1U) ^ APP_UART_EXT_CRC_POLY);
+            }
+            else
+            {
+                crc = (uint16_t) (crc << 1U);
+            }
+        }
+    }
+
+    return crc;
+}
+
+rd_status_t app_uart_ext_encode (uint8_t * const p_buffer, uint8_t * const p_len,
+                                 const app_uart_ext_frame_t * const p_frame)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if ( (NULL == p_buffer) || (NULL == p_len) || (NULL == p_frame))
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if ( (p_frame->len > APP_UART_EXT_PAYLOAD_MAX_LEN)
+              || ( (size_t) p_frame->len + APP_UART_EXT_OVERHEAD > *p_len))
+    {
+        err_code |= RD_ERROR_DATA_SIZE;
+    }
+    else
+    {
+        const size_t crc_idx = APP_UART_EXT_PAYLOAD_IDX + p_frame->len;
+        p_buffer[APP_UART_EXT_STX_IDX] = RE_CA_UART_STX;
+        p_buffer[APP_UART_EXT_LEN_IDX] = p_frame->len;
+        p_buffer[APP_UART_EXT_CMD_IDX] = p_frame->cmd;
+        memcpy (&p_buffer[APP_UART_EXT_PAYLOAD_IDX], p_frame->payload, p_frame->len);
+        const uint16_t crc = app_uart_ext_crc16 (&p_buffer[APP_UART_EXT_LEN_IDX],
+                             crc_idx - APP_UART_EXT_LEN_IDX);
+        p_buffer[crc_idx] = (uint8_t) (crc & 0xFFU);
+        p_buffer[crc_idx + 1U] = (uint8_t) (crc >> 8U);
+        p_buffer[crc_idx + 2U] = RE_CA_UART_ETX;
+        *p_len = (uint8_t) (crc_idx + 3U);
+    }
+
+    return err_code;
+}
+
+rd_status_t app_uart_ext_decode (const uint8_t * const p_buffer, const size_t len,
+                                 app_uart_ext_frame_t * const p_frame)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if ( (NULL == p_buffer) || (NULL == p_frame))
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if ( (len < APP_UART_EXT_OVERHEAD)
+              || (RE_CA_UART_STX != p_buffer[APP_UART_EXT_STX_IDX])
+              || (p_buffer[APP_UART_EXT_CMD_IDX] < APP_UART_EXT_CMD_FIRST))
+    {
+        err_code |= RD_ERROR_NOT_FOUND;
+    }
+    else
+    {
+        const size_t payload_len = p_buffer[APP_UART_EXT_LEN_IDX];
+        const size_t crc_idx = APP_UART_EXT_PAYLOAD_IDX + payload_len;
+
+        if ( (payload_len > APP_UART_EXT_PAYLOAD_MAX_LEN)
+                || ( (crc_idx + 3U) > len)
+                || (RE_CA_UART_ETX != p_buffer[crc_idx + 2U]))
+        {
+            err_code |= RD_ERROR_INVALID_DATA;
+        }
+        else
+        {
+            const uint16_t crc = (uint16_t) (p_buffer[crc_idx]
+                                             | ( (uint16_t) p_buffer[crc_idx + 1U] << 8U));
+
+            if (crc != app_uart_ext_crc16 (&p_buffer[APP_UART_EXT_LEN_IDX],
+                                           crc_idx - APP_UART_EXT_LEN_IDX))
+            {
+                err_code |= RD_ERROR_INVALID_DATA;
+            }
+            else
+            {
+                p_frame->cmd = p_buffer[APP_UART_EXT_CMD_IDX];
+                p_frame->len = (uint8_t) payload_len;
+                memcpy (p_frame->payload, &p_buffer[APP_UART_EXT_PAYLOAD_IDX], payload_len);
+            }
+        }
+    }
+
+    return err_code;
+}
+
+rd_status_t app_uart_ext_put_u8 (app_uart_ext_frame_t * const p_frame,
+                                 const uint8_t value)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (p_frame->len >= APP_UART_EXT_PAYLOAD_MAX_LEN)
+    {
+        err_code |= RD_ERROR_DATA_SIZE;
+    }
+    else
+    {
+        p_frame->payload[p_frame->len] = value;
+        p_frame->len++;
+    }
+
+    return err_code;
+}
+
+rd_status_t app_uart_ext_put_u16 (app_uart_ext_frame_t * const p_frame,
+                                  const uint16_t value)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    err_code |= app_uart_ext_put_u8 (p_frame, (uint8_t) (value & 0xFFU));
+    err_code |= app_uart_ext_put_u8 (p_frame, (uint8_t) (value >> 8U));
+    return err_code;
+}
+
+rd_status_t app_uart_ext_put_u32 (app_uart_ext_frame_t * const p_frame,
+                                  const uint32_t value)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    err_code |= app_uart_ext_put_u16 (p_frame, (uint16_t) (value & 0xFFFFU));
+    err_code |= app_uart_ext_put_u16 (p_frame, (uint16_t) (value >> 16U));
+    return err_code;
+}
+
+uint16_t app_uart_ext_get_u16 (const app_uart_ext_frame_t * const p_frame,
+                               const size_t offset)
+{
+    uint16_t value = 0U;
+
+    if ( (offset + 2U) <= p_frame->len)
+    {
+        value = (uint16_t) (p_frame->payload[offset]
+                            | ( (uint16_t) p_frame->payload[offset + 1U] << 8U));
+    }
+
+    return value;
+}
+
+uint32_t app_uart_ext_get_u32 (const app_uart_ext_frame_t * const p_frame,
+                               const size_t offset)
+{
+    uint32_t value = 0U;
+
+    if ( (offset + 4U) <= p_frame->len)
+    {
+        value = (uint32_t) app_uart_ext_get_u16 (p_frame, offset)
+                | ( (uint32_t) app_uart_ext_get_u16 (p_frame, offset + 2U) << 16U);
+    }
+
+    return value;
+}
+
+/** @} */
@@ -0,0 +1,294 @@
+#ifndef APP_UART_EXT_H
+#define APP_UART_EXT_H
+
+/**
+ * @defgroup APP_UART_EXT Gateway-specific UART commands.
+ * @{
+ */
+/**
+ *  @file app_uart_ext.h
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Encode and decode UART frames of commands which are specific to the
+ *  gateway nRF firmware and therefore not part of ruuvi.endpoints.c.
+ *
+ *  Frames use the framing of Ruuvi CA UART endpoint:
+ *  STX | LEN | CMD | PAYLOAD | CRC16 | ETX, where LEN is the length of
+ *  PAYLOAD and CRC16 is CRC-16/CCITT-FALSE of LEN, CMD and PAYLOAD in
+ *  little-endian byte order. Command codes start at APP_UART_EXT_CMD_FIRST
+ *  so they do not collide with endpoint commands. Payload is packed binary,
+ *  multi-byte fields in little-endian byte order.
+ *
+ *  A response to a command has the same command code.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ruuvi_driver_error.h"
+#include "ruuvi_interface_communication.h"
+
+#define APP_UART_EXT_CMD_FIRST  (0xA0U) //!< First command code of gateway commands.
+#define APP_UART_EXT_OVERHEAD   (6U)    //!< STX, LEN, CMD, CRC16, ETX.
+/** @brief Maximum payload which fits in one UART message. */
+#define APP_UART_EXT_PAYLOAD_MAX_LEN (RI_COMM_MESSAGE_MAX_LENGTH - APP_UART_EXT_OVERHEAD)
+
+/** @brief Gateway-specific commands. */
+typedef enum
+{
+    /**
+     * @brief Get scan scheduler statistics.
+     *
+     * Request has no payload. Response has per-PHY statistics of 1M and coded
+     * PHY: slots u32, packets u32, yield_x16 u16, alloc_slots u8; then PHY
+     * switches u32; then per-channel statistics of channels 37, 38, 39 with
+     * the same layout as PHYs; then channel rounds u32.
+     */
+    APP_UART_EXT_GET_SCAN_STATS = APP_UART_EXT_CMD_FIRST,
+    /**
+     * @brief Configure scan schedulers.
+     *
+     * Payload: PHY is_adaptive u8, round_slots u8, min_slots u8,
+     * channel is_adaptive u8, round_slots u8, min_slots u8.
+     * Response payload is a single status byte, 0 on success.
+     */
+    APP_UART_EXT_SET_SCAN_SCHED,
+    /**
+     * @brief Configure scan timing.
+     *
+     * Payload: scan interval ms u16, scan window ms u16, scan slot timeout
+     * ms u32. See app_ble_scan_timing_t.
+     * Response payload is a single status byte, 0 on success.
+     */
+    APP_UART_EXT_SET_SCAN_TIMING,
+    /**
+     * @brief Get runtime statistics.
+     *
+     * Optional payload: flags u8, APP_UART_EXT_STATS_FLAG_RESET to restart
+     * counting after read. Response payload: number of counters u8, then
+     * counters u32 in order of app_stats_id_t.
+     */
+    APP_UART_EXT_GET_STATS,
+    /**
+     * @brief Get latency histogram from radio reception to UART transmission.
+     *
+     * Optional payload: flags u8, APP_UART_EXT_STATS_FLAG_RESET to clear
+     * histogram after read. Response payload: number of buckets u8, count u32,
+     * max_ms u32, lost u32, then buckets u32. See app_latency_hist_t.
+     */
+    APP_UART_EXT_GET_LATENCY,
+    /**
+     * @brief Get fill level telemetry of queues.
+     *
+     * Optional payload: flags u8, APP_UART_EXT_STATS_FLAG_RESET to restart
+     * after read. Response payload: number of queues u8, then for each queue
+     * in order of app_queue_id_t: capacity u16, high-water mark u16,
+     * full count u32.
+     */
+    APP_UART_EXT_GET_QUEUES,
+    /**
+     * @brief Advertisement report with sequence number and reception time,
+     *        sent instead of RE_CA_UART_ADV_RPRT2 while enabled by
+     *        APP_UART_EXT_SET_ADV_TIMESTAMP.
+     *
+     * Payload: sequence number u32, reception time u32 in milliseconds of
+     * dongle RTC, MAC address
+     * 6 bytes, RSSI i8, primary PHY u8, secondary PHY u8, channel u8,
+     * is coded PHY u8, TX power i8, data length u8, data. PHYs and TX power
+     * are encoded as in RE_CA_UART_ADV_RPRT2.
+     */
+    APP_UART_EXT_ADV_RPRT_TS,
+    /**
+     * @brief Enable or disable reception times in advertisement reports.
+     *
+     * Payload: enable u8. Response payload is a single status byte, 0 on success.
+     */
+    APP_UART_EXT_SET_ADV_TIMESTAMP,
+    /**
+     * @brief Synchronize host time with dongle RTC.
+     *
+     * Payload: host time u64 in any unit, echoed back. Response payload:
+     * host time u64, dongle RTC time u32 in milliseconds when the command was
+     * handled. Host can map dongle time to its own from the midpoint of the
+     * round trip.
+     */
+    APP_UART_EXT_SYNC_TIME,
+    /**
+     * @brief Get advertisement sequence status.
+     *
+     * Every advertisement which passes filters is given the next sequence
+     * number before encoding, whether or not it reaches UART. Advertisements
+     * lost to a full scheduler in scan interrupt are given a sequence number
+     * too and counted as dropped. Response payload: next sequence number u32,
+     * count of sequenced advertisements dropped before UART transmission u32. Both count from boot and wrap at 2^32.
+     * All advertisements sequenced before the response precede it on UART,
+     * so gaps in received sequence numbers below next sequence number which
+     * are not explained by the drop count were lost on UART.
+     */
+    APP_UART_EXT_GET_SEQ_STATUS,
+    /**
+     * @brief Get CPU cycle statistics of forwarding functions.
+     *
+     * Payload: optional flags u8, APP_UART_EXT_STATS_FLAG_RESET to restart
+     * statistics after read. Response payload: number of sites u8, then per
+     * app_prof_site_t count u32, min u32, average u32 and max cycles u32.
+     * Counts are 0 unless firmware was built with APP_PROF_ENABLED.
+     */
+    APP_UART_EXT_GET_PROF,
+    /**
+     * @brief Read binary event trace, see app_trace.h.
+     *
+     * Payload: optional sequence number u32 of first event to read, 0 if
+     * omitted. Response payload: next sequence number u32, sequence number of
+     * first event read u32, number of events u8, then per event time u32 in
+     * milliseconds, app_trace_id_t u8, first argument u8 and second argument
+     * u16. Host reads from the first sequence number plus number of events
+     * until it reaches the next sequence number.
+     */
+    APP_UART_EXT_GET_TRACE,
+    /**
+     * @brief Periodic health report sent by dongle without request.
+     *
+     * Payload: uptime u32 in milliseconds, reset reason u32 (RESETREAS of
+     * nRF52), ri_radio_modulation_t of radio u8, fast scan restarts u32,
+     * full scan restarts u32, events lost to full scheduler u32, frames
+     * refused by UART driver u32, next advertisement sequence number u32,
+     * sequenced advertisements dropped u32, configuration polls sent u32,
+     * time from boot to configuration u32 and time from boot to first
+     * forwarded advertisement u32 in milliseconds, 0 until it happens,
+     * number of queues u8, then per app_queue_id_t level u16 and high water
+     * mark u16. Drop counts and high water marks are since boot or latest
+     * reset by a statistics command.
+     */
+    APP_UART_EXT_HEARTBEAT,
+    /**
+     * @brief Set heartbeat interval.
+     *
+     * Payload: interval u32 in milliseconds, 0 to stop heartbeats. Response
+     * payload is a single status byte, 0 on success.
+     */
+    APP_UART_EXT_SET_HEARTBEAT,
+    /**
+     * @brief Enable or disable capture of received advertisements.
+     *
+     * Payload: enable u8. While enabled, every advertisement given by the
+     * scanner is sent as APP_UART_EXT_CAPTURE instead of an advertisement
+     * report, whether or not it passes the manufacturer filter. Response
+     * payload is a single status byte, 0 on success.
+     */
+    APP_UART_EXT_SET_CAPTURE,
+    /**
+     * @brief Captured advertisement sent by dongle without request.
+     *
+     * Payload: one record, see app_capture.h.
+     */
+    APP_UART_EXT_CAPTURE,
+    /**
+     * @brief Get statistics of scan configuration transactions.
+     *
+     * Response payload: committed transactions u32, discarded transactions
+     * u32, commits which reconfigured the radio u32, then latest, longest and
+     * total radio downtime of reconfigurations u32 in milliseconds. Counts
+     * are since boot.
+     */
+    APP_UART_EXT_GET_COMMIT_STATS,
+    /**
+     * @brief Advertisement report with sequence number, sent instead of
+     *        RE_CA_UART_ADV_RPRT2 while enabled by APP_UART_EXT_SET_ADV_SEQ
+     *        and timestamps are disabled.
+     *
+     * Payload: sequence number u32, then as in APP_UART_EXT_ADV_RPRT_TS after
+     * reception time.
+     */
+    APP_UART_EXT_ADV_RPRT_SEQ,
+    /**
+     * @brief Enable or disable sequence numbered advertisement reports.
+     *
+     * Payload: enable u8. Response payload is a single status byte, 0 on success.
+     */
+    APP_UART_EXT_SET_ADV_SEQ,
+} app_uart_ext_cmd_t;
+
+/** @brief Flag of statistics commands to reset after read. */
+#define APP_UART_EXT_STATS_FLAG_RESET (0x01U)
+
+/** @brief Decoded frame. */
+typedef struct
+{
+    uint8_t cmd;                                   //!< Command code.
+    uint8_t len;                                   //!< Length of payload.
+    uint8_t payload[APP_UART_EXT_PAYLOAD_MAX_LEN]; //!< Payload.
+} app_uart_ext_frame_t;
+
+/**
+ * @brief Encode frame.
+ *
+ * @param[out] p_buffer Buffer to encode to.
+ * @param[in,out] p_len In: size of buffer. Out: length of encoded frame.
+ * @param[in] p_frame Frame to encode.
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_NULL if any pointer is NULL.
+ * @retval RD_ERROR_DATA_SIZE if frame does not fit in buffer.
+ */
+rd_status_t app_uart_ext_encode (uint8_t * const p_buffer, uint8_t * const p_len,
+                                 const app_uart_ext_frame_t * const p_frame);
+
+/**
+ * @brief Decode frame.
+ *
+ * @param[in] p_buffer Received data, starting with STX.
+ * @param[in] len Length of received data.
+ * @param[out] p_frame Decoded frame.
+ * @retval RD_SUCCESS if data has a valid gateway command frame.
+ * @retval RD_ERROR_NULL if any pointer is NULL.
+ * @retval RD_ERROR_NOT_FOUND if data is not a gateway command frame.
+ * @retval RD_ERROR_INVALID_DATA if frame is incomplete or corrupted.
+ */
+rd_status_t app_uart_ext_decode (const uint8_t * const p_buffer, const size_t len,
+                                 app_uart_ext_frame_t * const p_frame);
+
+/**
+ * @brief Append a byte to payload.
+ *
+ * @param[in,out] p_frame Frame to append to.
+ * @param[in] value Value to append.
+ * @retval RD_SUCCESS on success.
+ * @retval RD_ERROR_DATA_SIZE if payload is full.
+ */
+rd_status_t app_uart_ext_put_u8 (app_uart_ext_frame_t * const p_frame,
+                                 const uint8_t value);
+
+/** @copydoc app_uart_ext_put_u8 */
+rd_status_t app_uart_ext_put_u16 (app_uart_ext_frame_t * const p_frame,
+                                  const uint16_t value);
+
+/** @copydoc app_uart_ext_put_u8 */
+rd_status_t app_uart_ext_put_u32 (app_uart_ext_frame_t * const p_frame,
+                                  const uint32_t value);
+
+/**
+ * @brief Read a little-endian value from payload.
+ *
+ * @param[in] p_frame Frame to read from.
+ * @param[in] offset Index of first byte of value in payload.
+ * @return Value, 0 if value does not fit in payload.
+ */
+uint16_t app_uart_ext_get_u16 (const app_uart_ext_frame_t * const p_frame,
+                               const size_t offset);
+
+/** @copydoc app_uart_ext_get_u16 */
+uint32_t app_uart_ext_get_u32 (const app_uart_ext_frame_t * const p_frame,
+                               const size_t offset);
+
+/**
+ * @brief Calculate CRC-16/CCITT-FALSE.
+ *
+ * @param[in] p_data Data.
+ * @param[in] len Length of data.
+ * @return CRC of data.
+ */
+uint16_t app_uart_ext_crc16 (const uint8_t * const p_data, const size_t len);
+
+/** @} */
+#endif
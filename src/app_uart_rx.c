@@ -0,0 +1,129 @@
+/**
+ * @addtogroup APP_UART_RX
+ * @{
+ */
+/**
+ *  @file app_uart_rx.c
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ */
+#include "app_uart_rx.h"
+#include "app_queue.h"
+#include "app_stats.h"
+#include "app_uart_ext.h"
+#include <string.h>
+#include "ruuvi_endpoint_ca_uart.h"
+
+#define APP_UART_RX_STX_IDX (0U) //!< Index of STX.
+#define APP_UART_RX_LEN_IDX (1U) //!< Index of payload length.
+
+static uint8_t m_buffer[APP_UART_RX_BUFFER_LEN]; //!< Start of incomplete frame.
+static size_t m_len;                             //!< Bytes in m_buffer.
+static bool m_is_discarding;                     //!< Previous byte was discarded.
+
+/** @brief Discard a byte, counting each run of discarded bytes once. */
+static size_t rx_discard (const size_t index)
+{
+    if (!m_is_discarding)
+    {
+        app_stats_inc (APP_STATS_DECODE_ERRORS);
+        m_is_discarding = true;
+    }
+
+    return index + 1U;
+}
+
+/**
+ * @brief Handle complete frames in data.
+ *
+ * @param[in] p_data Received bytes.
+ * @param[in] len Number of bytes.
+ * @param[in] on_frame Handler of complete frames.
+ * @return Number of bytes handled or discarded, the rest start an
+ *         incomplete frame.
+ */
+static size_t rx_parse (const uint8_t * const p_data, const size_t len,
+                        const app_uart_rx_frame_fp_t on_frame)
+{
+    size_t index = 0;
+    bool is_incomplete = false;
+
+    while ( (index < len) && !is_incomplete)
+    {
+        const size_t left = len - index;
+
+        if (RE_CA_UART_STX != p_data[index + APP_UART_RX_STX_IDX])
+        {
+            index = rx_discard (index);
+        }
+        else if (left <= APP_UART_RX_LEN_IDX)
+        {
+            is_incomplete = true;
+        }
+        else
+        {
+            const size_t frame_len = (size_t) p_data[index + APP_UART_RX_LEN_IDX]
+                                     + APP_UART_EXT_OVERHEAD;
+
+            if (frame_len > APP_UART_RX_BUFFER_LEN)
+            {
+                index = rx_discard (index);
+            }
+            else if (left < frame_len)
+            {
+                is_incomplete = true;
+            }
+            else if ( (RE_CA_UART_ETX == p_data[index + frame_len - 1U])
+                      && on_frame (&p_data[index], frame_len))
+            {
+                index += frame_len;
+                m_is_discarding = false;
+            }
+            else
+            {
+                index = rx_discard (index);
+            }
+        }
+    }
+
+    return index;
+}
+
+void app_uart_rx_put (const uint8_t * const p_data, const size_t len,
+                      const app_uart_rx_frame_fp_t on_frame)
+{
+    size_t index = 0;
+
+    if (0U == m_len)
+    {
+        index = rx_parse (p_data, len, on_frame);
+    }
+
+    // Incomplete frame is shorter than buffer, so every round copies something.
+    while (index < len)
+    {
+        const size_t space = sizeof (m_buffer) - m_len;
+        const size_t count = ( (len - index) < space) ? (len - index) : space;
+        memcpy (&m_buffer[m_len], &p_data[index], count);
+        m_len += count;
+        index += count;
+        const size_t used = rx_parse (m_buffer, m_len, on_frame);
+        memmove (m_buffer, &m_buffer[used], m_len - used);
+        m_len -= used;
+    }
+
+    app_queue_level_record (APP_QUEUE_UART_RX, (uint16_t) m_len);
+}
+
+size_t app_uart_rx_pending (void)
+{
+    return m_len;
+}
+
+void app_uart_rx_clear (void)
+{
+    m_len = 0;
+    m_is_discarding = false;
+}
+
+/** @} */
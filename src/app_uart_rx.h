@@ -0,0 +1,70 @@
+#ifndef APP_UART_RX_H
+#define APP_UART_RX_H
+
+/**
+ * @defgroup APP_UART_RX UART frame reassembly.
+ * @{
+ */
+/**
+ *  @file app_uart_rx.h
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Split bytes received over UART into frames, however they are divided
+ *  between receive events.
+ *
+ *  CA UART commands and gateway-specific commands share the frame layout
+ *  STX, LEN, CMD, LEN bytes of payload, CRC16, ETX. A frame starts at STX
+ *  and its length is known from LEN, so every complete frame is handed to
+ *  the frame handler once and bytes of an incomplete frame are kept for the
+ *  next receive event. Bytes outside frames and frames the handler rejects
+ *  are discarded one byte at a time, so a valid frame following corrupted
+ *  data is found at its own STX.
+ *
+ *  Frames longer than APP_UART_RX_BUFFER_LEN are rejected, so an incomplete
+ *  frame always fits in the buffer and received bytes are never dropped.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "app_config.h"
+
+/**
+ * @brief Handle a complete frame.
+ *
+ * @param[in] p_frame Frame from STX to ETX.
+ * @param[in] len Bytes in frame.
+ * @retval true Frame was valid and has been handled.
+ * @retval false Frame was not valid, its first byte is discarded.
+ */
+typedef bool (*app_uart_rx_frame_fp_t) (const uint8_t * const p_frame, const size_t len);
+
+/**
+ * @brief Add received bytes and handle frames they complete.
+ *
+ * Frames are parsed directly from p_data while nothing is buffered, only an
+ * incomplete frame at the end is copied.
+ *
+ * @param[in] p_data Received bytes.
+ * @param[in] len Number of received bytes.
+ * @param[in] on_frame Handler of complete frames, called in order of
+ *                     reception.
+ */
+void app_uart_rx_put (const uint8_t * const p_data, const size_t len,
+                      const app_uart_rx_frame_fp_t on_frame);
+
+/**
+ * @brief Get number of bytes kept for an incomplete frame.
+ *
+ * @return Bytes in buffer.
+ */
+size_t app_uart_rx_pending (void);
+
+/**
+ * @brief Discard buffered bytes.
+ */
+void app_uart_rx_clear (void);
+
+/** @} */
+#endif // APP_UART_RX_H
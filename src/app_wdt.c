@@ -0,0 +1,132 @@
+/**
+ * @addtogroup APP_WDT
+ * @{
+ */
+/**
+ *  @file app_wdt.c
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Watchdog supervisor.
+ */
+#include "app_config.h"
+#include "app_wdt.h"
+#include <stddef.h>
+#include "app_trace.h"
+#include "ruuvi_interface_rtc.h"
+#include "ruuvi_interface_scheduler.h"
+#include "ruuvi_interface_timer.h"
+#include "ruuvi_interface_watchdog.h"
+#if !defined(CEEDLING) && !defined(SONAR)
+#include "nrf_log.h"
+#else
+#define NRF_LOG_WARNING(fmt, ...)
+#endif
+
+_Static_assert (APP_WDT_CHECK_INTERVAL_MS < APP_WDT_INTERVAL_MS,
+                "Watchdog must be fed more often than it expires.");
+_Static_assert (APP_WDT_NUM <= 8U, "Late subsystems are reported as uint8_t bitmask.");
+
+static ri_timer_id_t m_check_timer = NULL;
+static volatile uint32_t m_checkin_ms[APP_WDT_NUM];
+static volatile uint32_t m_timeout_ms[APP_WDT_NUM];
+static volatile bool m_is_armed[APP_WDT_NUM];
+
+static uint32_t now_ms (void)
+{
+    return (uint32_t) ri_rtc_millis();
+}
+
+static void on_check_evt (void * p_data, uint16_t data_len)
+{
+    (void) p_data;
+    (void) data_len;
+    (void) app_wdt_check();
+}
+
+static void check_timer_isr (void * const p_context)
+{
+    (void) p_context;
+    (void) ri_scheduler_event_put (NULL, 0U, &on_check_evt);
+}
+
+rd_status_t app_wdt_init (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    for (size_t ii = 0; ii < APP_WDT_NUM; ii++)
+    {
+        m_is_armed[ii] = false;
+        m_checkin_ms[ii] = 0U;
+        m_timeout_ms[ii] = 0U;
+    }
+
+    if (NULL == m_check_timer)
+    {
+        err_code |= ri_timer_create (&m_check_timer, RI_TIMER_MODE_REPEATED,
+                                     &check_timer_isr);
+    }
+
+    if (RD_SUCCESS == err_code)
+    {
+        err_code |= ri_timer_start (m_check_timer, APP_WDT_CHECK_INTERVAL_MS, NULL);
+    }
+
+    return err_code;
+}
+
+void app_wdt_arm (const app_wdt_src_t src, const uint32_t timeout_ms)
+{
+    if (src < APP_WDT_NUM)
+    {
+        // Deadline before arming, check may run in between.
+        m_checkin_ms[src] = now_ms();
+        m_timeout_ms[src] = timeout_ms;
+        m_is_armed[src] = true;
+    }
+}
+
+void app_wdt_disarm (const app_wdt_src_t src)
+{
+    if (src < APP_WDT_NUM)
+    {
+        m_is_armed[src] = false;
+    }
+}
+
+void app_wdt_checkin (const app_wdt_src_t src)
+{
+    if (src < APP_WDT_NUM)
+    {
+        m_checkin_ms[src] = now_ms();
+    }
+}
+
+uint8_t app_wdt_check (void)
+{
+    const uint32_t now = now_ms();
+    uint8_t late = 0U;
+
+    for (size_t ii = 0; ii < APP_WDT_NUM; ii++)
+    {
+        // Subtraction handles wrap of truncated time.
+        if (m_is_armed[ii] && ( (uint32_t) (now - m_checkin_ms[ii]) > m_timeout_ms[ii]))
+        {
+            late |= (uint8_t) (1U << ii);
+        }
+    }
+
+    if (0U == late)
+    {
+        (void) ri_watchdog_feed();
+    }
+    else
+    {
+        NRF_LOG_WARNING ("Watchdog starved, late subsystems: 0x%02X", late);
+        app_trace_record (APP_TRACE_WDT_STARVE, late, 0U);
+    }
+
+    return late;
+}
+
+/** @} */
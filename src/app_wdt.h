@@ -0,0 +1,81 @@
+#ifndef APP_WDT_H
+#define APP_WDT_H
+
+/**
+ * @defgroup APP_WDT Watchdog supervisor.
+ * @{
+ */
+/**
+ *  @file app_wdt.h
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Feeds the watchdog only while every supervised subsystem shows progress.
+ *
+ *  A repeated timer schedules a liveness check every APP_WDT_CHECK_INTERVAL_MS.
+ *  The check runs in main loop, so a stalled main loop starves the watchdog
+ *  within APP_WDT_INTERVAL_MS. Other subsystems are supervised while armed:
+ *  an armed subsystem must check in within the timeout given when arming, or
+ *  the watchdog is starved and an APP_TRACE_WDT_STARVE event names the late
+ *  subsystems.
+ *
+ *  Arming and checking in may be done from interrupt context.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "app_config.h"
+#include "ruuvi_driver_error.h"
+
+/** @brief Supervised subsystems. */
+typedef enum
+{
+    APP_WDT_SCAN = 0,  //!< Scan slots complete, armed again on every slot start.
+    APP_WDT_UART_TX,   //!< UART reports frames sent, armed while frames are in driver.
+    APP_WDT_NUM        //!< Number of subsystems.
+} app_wdt_src_t;
+
+/**
+ * @brief Start supervising.
+ *
+ * Requires watchdog, timers, RTC and scheduler initialized. All subsystems
+ * start disarmed.
+ *
+ * @retval RD_SUCCESS Check timer started.
+ * @return Error code from timer driver.
+ */
+rd_status_t app_wdt_init (void);
+
+/**
+ * @brief Require subsystem to check in within timeout from now on.
+ *
+ * @param[in] src Subsystem.
+ * @param[in] timeout_ms Longest allowed time between check-ins.
+ */
+void app_wdt_arm (const app_wdt_src_t src, const uint32_t timeout_ms);
+
+/**
+ * @brief Stop supervising subsystem, e.g. when it is idle on purpose.
+ *
+ * @param[in] src Subsystem.
+ */
+void app_wdt_disarm (const app_wdt_src_t src);
+
+/**
+ * @brief Report progress of subsystem.
+ *
+ * @param[in] src Subsystem.
+ */
+void app_wdt_checkin (const app_wdt_src_t src);
+
+/**
+ * @brief Check liveness of armed subsystems and feed watchdog if all are alive.
+ *
+ * Called from main loop by check timer.
+ *
+ * @return Bitmask of late subsystems, 0 if watchdog was fed.
+ */
+uint8_t app_wdt_check (void);
+
+/** @} */
+#endif // APP_WDT_H
@@ -25,14 +25,178 @@
  */
 
 /** @brief If watchdog is not fed at this interval or faster, reboot.
+ * Watchdog is fed by app_wdt at APP_WDT_CHECK_INTERVAL_MS while every
+ * supervised subsystem is alive, so this only has to cover a stalled main loop.
+ * */
+#ifndef APP_WDT_INTERVAL_MS
+#   define APP_WDT_INTERVAL_MS (8U*1000U)
+#endif
+
+/** @brief Interval of checking subsystem liveness and feeding watchdog. */
+#ifndef APP_WDT_CHECK_INTERVAL_MS
+#   define APP_WDT_CHECK_INTERVAL_MS (1000U)
+#endif
+
+/** @brief Scan slot must end and the next one start at this interval or faster,
+ * extended by scan slot length when slots are timed by application.
+ * Forwarded advertisements do not count, a scan stuck on one PHY is detected.
  * When only "LE 2M PHY" and "LE Coded PHY" is enabled and they don't receive
  * any packets, then for the first 21 seconds it will wait for packets
- * on "LE Coded PHY", then it will switch to "LE 2M PHY" and wait for packets
- * for the second 21 seconds.
- * So, the minimum watchdog timeout should be 42 seconds.
+ * on "LE Coded PHY", then it will switch to "LE 2M PHY" and restart scanning.
  * */
-#ifndef APP_WDT_INTERVAL_MS
-#   define APP_WDT_INTERVAL_MS (42U*1000U)
+#ifndef APP_WDT_SCAN_TIMEOUT_MS
+#   define APP_WDT_SCAN_TIMEOUT_MS (25U*1000U)
+#endif
+
+/** @brief UART must report a frame sent at this interval or faster while
+ *         frames are in the driver. */
+#ifndef APP_WDT_UART_TX_TIMEOUT_MS
+#   define APP_WDT_UART_TX_TIMEOUT_MS (2U*1000U)
+#endif
+
+/** @brief First interval of re-polling configuration from ESP32 after boot. */
+#ifndef APP_UART_POLL_INTERVAL_MIN_MS
+#   define APP_UART_POLL_INTERVAL_MIN_MS (1000U)
+#endif
+
+/** @brief Polling interval is doubled on every poll up to this limit. */
+#ifndef APP_UART_POLL_INTERVAL_MAX_MS
+#   define APP_UART_POLL_INTERVAL_MAX_MS (16U*1000U)
+#endif
+
+/**
+ * @brief Divide scan time between LE Coded PHY and LE 1M PHY by packet yield.
+ *
+ * If disabled, PHYs alternate on every scan timeout.
+ */
+#ifndef APP_PHY_SCHED_ADAPTIVE_ENABLED
+#   define APP_PHY_SCHED_ADAPTIVE_ENABLED (1U)
+#endif
+
+/** @brief Scan slots divided between PHYs in one adaptive scheduling round. */
+#ifndef APP_PHY_SCHED_ROUND_SLOTS
+#   define APP_PHY_SCHED_ROUND_SLOTS (8U)
+#endif
+
+/** @brief Minimum scan slots of each enabled PHY in one round. */
+#ifndef APP_PHY_SCHED_MIN_SLOTS
+#   define APP_PHY_SCHED_MIN_SLOTS (1U)
+#endif
+
+/**
+ * @brief Leave primary channels with low packet yield out of some scan slots.
+ *
+ * If disabled, all enabled channels are scanned on every slot.
+ */
+#ifndef APP_CH_SCHED_ADAPTIVE_ENABLED
+#   define APP_CH_SCHED_ADAPTIVE_ENABLED (0U)
+#endif
+
+/** @brief Scan slots in one adaptive channel scheduling round. */
+#ifndef APP_CH_SCHED_ROUND_SLOTS
+#   define APP_CH_SCHED_ROUND_SLOTS (4U)
+#endif
+
+/** @brief Minimum scan slots of each enabled channel in one round. */
+#ifndef APP_CH_SCHED_MIN_SLOTS
+#   define APP_CH_SCHED_MIN_SLOTS (1U)
+#endif
+
+/**
+ * @brief Default period of scan duty cycle.
+ *
+ * Scanning runs for APP_BLE_SCAN_WINDOW_MS of every APP_BLE_SCAN_INTERVAL_MS
+ * and the radio is idle for the rest of the interval. Window equal to interval
+ * scans continuously.
+ */
+#ifndef APP_BLE_SCAN_INTERVAL_MS
+#   define APP_BLE_SCAN_INTERVAL_MS (1000U)
+#endif
+
+/** @brief Default scan time in every scan interval. */
+#ifndef APP_BLE_SCAN_WINDOW_MS
+#   define APP_BLE_SCAN_WINDOW_MS (1000U)
+#endif
+
+/**
+ * @brief Default length of a scan slot on one PHY and set of channels.
+ *
+ * 0 runs each slot until scan timeout of the radio driver.
+ */
+#ifndef APP_BLE_SCAN_TIMEOUT_MS
+#   define APP_BLE_SCAN_TIMEOUT_MS (0U)
+#endif
+
+/**
+ * @brief Length of a scan slot of duty cycled scan without slot length.
+ *
+ * Every resumed scan window restarts the scan timeout of the radio driver,
+ * so the application ends slots of a duty cycled scan itself.
+ */
+#ifndef APP_BLE_SCAN_DUTY_SLOT_MS
+#   define APP_BLE_SCAN_DUTY_SLOT_MS (20U*1000U)
+#endif
+
+/** @brief Shortest accepted scan window. */
+#ifndef APP_BLE_SCAN_WINDOW_MIN_MS
+#   define APP_BLE_SCAN_WINDOW_MIN_MS (10U)
+#endif
+
+/**
+ * @brief Send APP_UART_EXT_ADV_RPRT_TS with reception time instead of
+ *        RE_CA_UART_ADV_RPRT2 until host changes it.
+ */
+#ifndef APP_UART_ADV_TIMESTAMP_ENABLED
+#   define APP_UART_ADV_TIMESTAMP_ENABLED (0U)
+#endif
+
+/**
+ * @brief Send APP_UART_EXT_ADV_RPRT_SEQ with sequence number instead of
+ *        RE_CA_UART_ADV_RPRT2 until host changes it. Timestamped reports
+ *        take precedence, they carry the sequence number too.
+ */
+#ifndef APP_UART_ADV_SEQ_ENABLED
+#   define APP_UART_ADV_SEQ_ENABLED (0U)
+#endif
+
+/**
+ * @brief Interval of APP_UART_EXT_HEARTBEAT frames after boot, 0 to send none
+ *        until host sets an interval.
+ */
+#ifndef APP_UART_HEARTBEAT_INTERVAL_MS
+#   define APP_UART_HEARTBEAT_INTERVAL_MS (0U)
+#endif
+
+/** @brief Shortest heartbeat interval host may set. */
+#ifndef APP_UART_HEARTBEAT_INTERVAL_MIN_MS
+#   define APP_UART_HEARTBEAT_INTERVAL_MIN_MS (100U)
+#endif
+
+/**
+ * @brief Bytes of UART RX reassembly buffer, also the longest command frame
+ *        accepted from host.
+ */
+#ifndef APP_UART_RX_BUFFER_LEN
+#   define APP_UART_RX_BUFFER_LEN (128U)
+#endif
+
+/** @brief Number of events kept in binary trace, power of two. */
+#ifndef APP_TRACE_LENGTH
+#   define APP_TRACE_LENGTH (64U)
+#endif
+
+/**
+ * @brief Count CPU cycles of advertisement forwarding, see app_prof.h.
+ *
+ * Set by `make profile`, adds a few cycles to every profiled function.
+ */
+#ifndef APP_PROF_ENABLED
+#   define APP_PROF_ENABLED (0U)
+#endif
+
+/** @brief Interval of logging cycle statistics when profiling, 0 to not log. */
+#ifndef APP_PROF_LOG_INTERVAL_MS
+#   define APP_PROF_LOG_INTERVAL_MS (10000U)
 #endif
 
 /** @brief Enable/disable NFC tag functionality. */
@@ -116,9 +280,17 @@
 
 /**
  * @brief Enable Ruuvi Flash interface on boards with enough RAM & Flash
+ *
+ * Stores the last applied scan configuration in pages reserved for application data.
+ * FLASH of ruuvigw_nrf.ld runs to the end of nRF52811 flash and leaves no pages
+ * for FDS, so the configuration is stored only on the pca10040 and pca10059 boards.
  */
 #ifndef RI_FLASH_ENABLED
-#   define RI_FLASH_ENABLED (0U)
+#   if defined(BOARD_RUUVIGW_NRF) && !defined(CEEDLING)
+#       define RI_FLASH_ENABLED (0U)
+#   else
+#       define RI_FLASH_ENABLED (RB_APP_PAGES > 0U)
+#   endif
 #endif
 
 /** @brief Enable Ruuvi led tasks. */
@@ -146,6 +318,11 @@
 #    define RI_RADIO_ENABLED (1U)
 #endif
 
+/** @brief Enable RTC interface, used to timestamp radio and UART events. */
+#ifndef RI_RTC_ENABLED
+#    define RI_RTC_ENABLED (1U)
+#endif
+
 /** @brief Enable Scheduler interface. */
 #ifndef RI_SCHEDULER_ENABLED
 #   define RI_SCHEDULER_ENABLED (1U)
@@ -166,13 +343,24 @@
 #endif
 
 
+/**
+ * @brief Timers created by the application: LED blink of rt_led, scan timeout,
+ *        configuration poll, heartbeat, watchdog check and profiler log of
+ *        profile builds. Update when a module creates a timer.
+ */
+#define APP_TIMER_USERS (5U + ((APP_PROF_ENABLED && (0U != APP_PROF_LOG_INTERVAL_MS)) ? 1U : 0U))
+
 /**
  * @brief Enable Ruuvi Timer interface.
  */
 #ifndef RI_TIMER_ENABLED
 #   define RI_TIMER_ENABLED (1U)
-/** @brief Each instance reserves RAM, runs on same physical timer. */
-#   define RI_TIMER_MAX_INSTANCES (5U)
+/**
+ * @brief Each instance reserves about 32 bytes of RAM, runs on same physical timer.
+ *
+ * One spare instance so that a new timer user fails at build, not at boot.
+ */
+#   define RI_TIMER_MAX_INSTANCES (APP_TIMER_USERS + 1U)
 #endif
 
 /** @brief Enable Ruuvi UART interface */
@@ -208,6 +396,16 @@
 #   endif
 #endif
 
+/** @brief Format logs of forwarding path when idle instead of in place, see app_log.h. */
+#ifndef APP_LOG_DEFERRED_ENABLED
+#   define APP_LOG_DEFERRED_ENABLED (RI_LOG_ENABLED)
+#endif
+
+/** @brief Bytes of deferred log records kept until main loop is idle. */
+#ifndef APP_LOG_BUFFER_LEN
+#   define APP_LOG_BUFFER_LEN (1024U)
+#endif
+
 /** @brief Disable LIS2DH12 code explicitly */
 #define RI_LIS2DH12_ENABLED 0
 /** @brief Disable BME280 code explicitly */
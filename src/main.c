@@ -7,7 +7,6 @@
  *  Application main.
  */
 
-#include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include "app_config.h"
@@ -15,6 +14,7 @@
 #include "ruuvi_interface_communication_ble_advertising.h"
 #include "ruuvi_interface_gpio.h"
 #include "ruuvi_interface_log.h"
+#include "ruuvi_interface_rtc.h"
 #include "ruuvi_interface_scheduler.h"
 #include "ruuvi_interface_timer.h"
 #include "ruuvi_interface_watchdog.h"
@@ -23,8 +23,13 @@
 #include "ruuvi_endpoint_ca_uart.h"
 #include "main.h"
 #include "app_ble.h"
+#include "app_flash.h"
+#include "app_log.h"
+#include "app_prof.h"
 #include "app_uart.h"
+#include "app_wdt.h"
 #if !defined(CEEDLING) && !defined(SONAR)
+#include "nrf.h"
 #include "nrf_log.h"
 #else
 #define NRF_LOG_INFO(fmt, ...)
@@ -33,23 +38,8 @@
 
 #define LED_ON_TIME_AFTER_REBOOT_MS (4000U)  //!< Turn on LED for 4 seconds after reboot
 
-/**
- * @brief Convert MAC address to string.
- *
- * @param[in] p_mac Pointer to array of 6 bytes with MAC address.
- *
- * @return MAC address as string.
- */
-mac_addr_str_t mac_addr_to_str (const uint8_t * const p_mac)
-{
-    mac_addr_str_t mac_addr_str = {0};
-#if RI_LOG_ENABLED
-    snprintf (mac_addr_str.buf, sizeof (mac_addr_str.buf),
-              "%02x:%02x:%02x:%02x:%02x:%02x",
-              p_mac[0], p_mac[1], p_mac[2], p_mac[3], p_mac[4], p_mac[5]);
-#endif
-    return mac_addr_str;
-}
+_Static_assert (RI_TIMER_MAX_INSTANCES >= APP_TIMER_USERS,
+                "Every timer of APP_TIMER_USERS needs an instance.");
 
 /**
  * @brief Configure LEDs as outputs, turn them off.
@@ -72,9 +62,28 @@ void on_wdt (void)
     // No action required
 }
 
+/**
+ * @brief Read and clear reason of latest reset.
+ *
+ * RESETREAS accumulates until cleared, and must be read before SoftDevice
+ * takes over the POWER peripheral.
+ *
+ * @return RESETREAS bits, 0 on host.
+ */
+static uint32_t reset_reason_take (void)
+{
+    uint32_t reason = 0U;
+#if !defined(CEEDLING) && !defined(SONAR)
+    reason = NRF_POWER->RESETREAS;
+    NRF_POWER->RESETREAS = reason;
+#endif
+    return reason;
+}
+
 static void setup (void)
 {
     rd_status_t err_code = RD_SUCCESS;
+    const uint32_t reset_reason = reset_reason_take();
     err_code |= ri_log_init (APP_LOG_LEVEL);
     ri_log (RI_LOG_LEVEL_INFO, "Log initialized\n");
     NRF_LOG_INFO ("RI_COMM_BLE_PAYLOAD_MAX_LENGTH=%d", RI_COMM_BLE_PAYLOAD_MAX_LENGTH);
@@ -88,19 +97,36 @@ static void setup (void)
     err_code |= ri_watchdog_init (APP_WDT_INTERVAL_MS, on_wdt);
     err_code |= ri_yield_init();
     err_code |= ri_timer_init();
+    err_code |= ri_rtc_init();
     err_code |= ri_scheduler_init();
+    // Requires watchdog, timers, RTC and scheduler
+    err_code |= app_wdt_init();
     err_code |= ri_gpio_init();
+#if APP_PROF_ENABLED
+    // Requires timers and scheduler
+    err_code |= app_prof_init();
+#endif
     // Requires GPIO
     err_code |= leds_init();
     // Requires timers
     err_code |= ri_yield_low_power_enable (true);
     // Requires LEDs
     err_code |= app_uart_init();
+    // Requires UART and timers
+    err_code |= app_uart_heartbeat_init (reset_reason);
+
+    // Resume with the configuration used before reset, if any.
+    if (RD_SUCCESS == app_flash_init())
+    {
+        (void) app_ble_config_restore();
+    }
+
 #if defined(RUUVI_GW_NRF_POLL_CONFIG_DISABLED) && RUUVI_GW_NRF_POLL_CONFIG_DISABLED
     // Set default configuration by updating macro `RB_BLE_DEFAULT_...` in app_ble.c
     NRF_LOG_INFO ("Use default settings as the initial configuration");
 #else
-    NRF_LOG_INFO ("Waiting for receiving the initial configuration via UART");
+    // Scanning starts with the default configuration while waiting for the reply.
+    NRF_LOG_INFO ("Polling the initial configuration via UART");
     err_code |= app_uart_poll_configuration();
 #endif
     RD_ERROR_CHECK (err_code, ~RD_ERROR_FATAL);
@@ -126,6 +152,8 @@ int main (void)
     do
     {
         ri_scheduler_execute();
+        app_log_process();
+        app_flash_process();
         ri_yield();
     } while (LOOP_FOREVER);
 
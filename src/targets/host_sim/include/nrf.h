@@ -0,0 +1,29 @@
+#ifndef SIM_NRF_H
+#define SIM_NRF_H
+
+/**
+ * @addtogroup HOST_SIM
+ * @{
+ */
+/**
+ *  @file nrf.h
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Registers of nRF52 used by application, backed by RAM on host.
+ */
+
+#include <stdint.h>
+
+/** @brief POWER peripheral. */
+typedef struct
+{
+    volatile uint32_t RESETREAS; //!< Reset reason, 0 after power-on reset.
+} NRF_POWER_Type;
+
+extern NRF_POWER_Type sim_nrf_power;
+
+#define NRF_POWER (&sim_nrf_power)
+
+/** @} */
+#endif // SIM_NRF_H
@@ -0,0 +1,27 @@
+#ifndef SIM_NRF_LOG_H
+#define SIM_NRF_LOG_H
+
+/**
+ * @addtogroup HOST_SIM
+ * @{
+ */
+/**
+ *  @file nrf_log.h
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Nordic log macros printed to stderr with virtual time, level set by SIM_LOG.
+ */
+
+#include "sim.h"
+
+#define NRF_LOG_ERROR(...)   sim_log (1U, __VA_ARGS__)
+#define NRF_LOG_WARNING(...) sim_log (2U, __VA_ARGS__)
+#define NRF_LOG_INFO(...)    sim_log (3U, __VA_ARGS__)
+#define NRF_LOG_DEBUG(...)   sim_log (4U, __VA_ARGS__)
+#define NRF_LOG_HEXDUMP_INFO(p_data, len)  sim_log_hex (3U, (p_data), (uint32_t) (len))
+#define NRF_LOG_HEXDUMP_DEBUG(p_data, len) sim_log_hex (4U, (p_data), (uint32_t) (len))
+#define NRF_LOG_PUSH(p_str) (p_str)
+
+/** @} */
+#endif // SIM_NRF_LOG_H
@@ -0,0 +1,268 @@
+/**
+ * @addtogroup HOST_SIM
+ * @{
+ */
+/**
+ *  @file parser_bench.c
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Throughput of UART command reassembly and decoding.
+ *
+ *  A stream of gateway command frames is given to app_uart_rx_put in the
+ *  chunks the UART driver could deliver: whole stream, fixed sizes, one
+ *  frame per event and random sizes, with and without corrupted frames.
+ *  Every valid frame must be handled exactly once and in order, else the
+ *  program exits with an error.
+ *
+ *  Time is host wall time, the longest single call includes the cost of
+ *  reading the clock and any preemption of the process. Cycles on the
+ *  target are counted by APP_PROF_PARSER in a profile build.
+ *
+ *  Usage: parser_bench [result.json]
+ */
+#include "app_stats.h"
+#include "app_uart_ext.h"
+#include "app_uart_rx.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ruuvi_endpoint_ca_uart.h"
+
+#define BENCH_FRAMES       (2000U)   //!< Frames in stream.
+#define BENCH_STREAM_LEN   (131072U) //!< Bytes reserved for stream.
+#define BENCH_PASSES       (50U)     //!< Times stream is parsed per case.
+#define BENCH_CORRUPT_NTH  (16U)     //!< Every nth frame is corrupted.
+#define BENCH_RANDOM_MAX   (64U)     //!< Largest random chunk.
+#define BENCH_CHUNK_FRAME  (-1)      //!< Split after each frame.
+#define BENCH_CHUNK_RANDOM (-2)      //!< Split at random.
+
+/** @brief One way of splitting the stream. */
+typedef struct
+{
+    const char * p_name; //!< Name in results.
+    int chunk;           //!< Bytes per put, 0 for whole stream or BENCH_CHUNK_*.
+    bool is_corrupted;   //!< Every BENCH_CORRUPT_NTH frame is corrupted.
+} bench_case_t;
+
+static const bench_case_t m_cases[] =
+{
+    {"whole", 0, false},
+    {"chunk_1", 1, false},
+    {"chunk_2", 2, false},
+    {"chunk_3", 3, false},
+    {"chunk_8", 8, false},
+    {"chunk_16", 16, false},
+    {"chunk_64", 64, false},
+    {"per_frame", BENCH_CHUNK_FRAME, false},
+    {"random", BENCH_CHUNK_RANDOM, false},
+    {"random_corrupted", BENCH_CHUNK_RANDOM, true}
+};
+
+static uint8_t m_stream[BENCH_STREAM_LEN];
+static size_t m_stream_len;
+static size_t m_frame_end[BENCH_FRAMES];
+static uint32_t m_expected;    //!< Identifier of next valid frame.
+static bool m_is_corrupted;    //!< Stream has corrupted frames.
+static uint64_t m_handled;     //!< Valid frames handled.
+static uint64_t m_mismatches;  //!< Frames lost, duplicated or reordered.
+static uint32_t m_random;
+
+static uint32_t random_next (void)
+{
+    m_random = (m_random * 1103515245U) + 12345U;
+    return m_random >> 8U;
+}
+
+static uint64_t now_ns (void)
+{
+    struct timespec ts;
+    (void) clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ( (uint64_t) ts.tv_sec * 1000000000U) + (uint64_t) ts.tv_nsec;
+}
+
+static bool is_skipped (const uint32_t id)
+{
+    return m_is_corrupted && ( (BENCH_CORRUPT_NTH - 1U) == (id % BENCH_CORRUPT_NTH));
+}
+
+/** @brief Check that frames arrive once and in order, like app_uart_on_frame. */
+static bool on_frame (const uint8_t * const p_frame, const size_t len)
+{
+    app_uart_ext_frame_t frame;
+    const bool is_valid = (RD_SUCCESS == app_uart_ext_decode (p_frame, len, &frame));
+
+    if (is_valid)
+    {
+        while (is_skipped (m_expected))
+        {
+            m_expected++;
+        }
+
+        m_mismatches += (app_uart_ext_get_u32 (&frame, 0U) != m_expected) ? 1U : 0U;
+        m_expected++;
+        m_handled++;
+    }
+
+    return is_valid;
+}
+
+/**
+ * @brief Build stream of frames with 4 to 40 bytes of payload.
+ *
+ * Payloads are random, so they contain STX and ETX bytes. A byte of every
+ * skipped frame is changed if frames are corrupted. Zeros at the end
+ * complete any frame corrupted data claims to start.
+ */
+static void stream_build (const bool is_corrupted)
+{
+    m_random = 1U;
+    m_stream_len = 0;
+    m_is_corrupted = is_corrupted;
+
+    for (uint32_t id = 0; id < BENCH_FRAMES; id++)
+    {
+        app_uart_ext_frame_t frame = {.cmd = APP_UART_EXT_SYNC_TIME};
+        uint8_t len = RI_COMM_MESSAGE_MAX_LENGTH;
+        const uint32_t extra = random_next() % 37U;
+        (void) app_uart_ext_put_u32 (&frame, id);
+
+        for (uint32_t ii = 0; ii < extra; ii++)
+        {
+            (void) app_uart_ext_put_u8 (&frame, (uint8_t) random_next());
+        }
+
+        (void) app_uart_ext_encode (&m_stream[m_stream_len], &len, &frame);
+
+        if (is_skipped (id))
+        {
+            m_stream[m_stream_len + (random_next() % len)] ^=
+                (uint8_t) ( (random_next() % 255U) + 1U);
+        }
+
+        m_stream_len += len;
+        m_frame_end[id] = m_stream_len;
+    }
+
+    memset (&m_stream[m_stream_len], 0, APP_UART_RX_BUFFER_LEN);
+    m_stream_len += APP_UART_RX_BUFFER_LEN;
+}
+
+static size_t chunk_next (const bench_case_t * const p_case, const size_t start,
+                          size_t * const p_frame)
+{
+    size_t end = m_stream_len;
+
+    if (BENCH_CHUNK_FRAME == p_case->chunk)
+    {
+        end = (*p_frame < BENCH_FRAMES) ? m_frame_end[*p_frame] : m_stream_len;
+        (*p_frame)++;
+    }
+    else if (BENCH_CHUNK_RANDOM == p_case->chunk)
+    {
+        end = start + 1U + (random_next() % BENCH_RANDOM_MAX);
+    }
+    else if (0 < p_case->chunk)
+    {
+        end = start + (size_t) p_case->chunk;
+    }
+    else
+    {
+        // Whole stream in one put.
+    }
+
+    return (end < m_stream_len) ? end : m_stream_len;
+}
+
+/** @brief Parse stream, print and write results, return true if no frame was lost. */
+static bool bench_run (const bench_case_t * const p_case, FILE * const p_result,
+                       const bool is_first)
+{
+    uint64_t total_ns = 0;
+    uint64_t worst_ns = 0;
+    uint64_t puts = 0;
+    app_stats_t stats;
+    stream_build (p_case->is_corrupted);
+    m_handled = 0;
+    m_mismatches = 0;
+    app_stats_clear();
+
+    for (uint32_t pass = 0; pass < BENCH_PASSES; pass++)
+    {
+        size_t start = 0;
+        size_t frame = 0;
+        m_expected = 0;
+        app_uart_rx_clear();
+
+        while (start < m_stream_len)
+        {
+            const size_t end = chunk_next (p_case, start, &frame);
+            const uint64_t begin = now_ns();
+            app_uart_rx_put (&m_stream[start], end - start, &on_frame);
+            const uint64_t elapsed = now_ns() - begin;
+            total_ns += elapsed;
+            worst_ns = (elapsed > worst_ns) ? elapsed : worst_ns;
+            puts++;
+            start = end;
+        }
+
+        while (is_skipped (m_expected))
+        {
+            m_expected++;
+        }
+
+        m_mismatches += (BENCH_FRAMES != m_expected) ? 1U : 0U;
+        m_mismatches += (0U != app_uart_rx_pending()) ? 1U : 0U;
+    }
+
+    app_stats_get (&stats, false);
+    const uint64_t bytes = (uint64_t) m_stream_len * BENCH_PASSES;
+    const double seconds = (0U != total_ns) ? ( (double) total_ns / 1e9) : 1e-9;
+    printf ("%-18s%12.1f%12.0f%10" PRIu64 "%10" PRIu64 "%10" PRIu32 "\n", p_case->p_name,
+            (double) bytes / seconds / 1e6, (double) m_handled / seconds, worst_ns,
+            m_mismatches, stats.counters[APP_STATS_DECODE_ERRORS]);
+
+    if (NULL != p_result)
+    {
+        fprintf (p_result, "%s {\"case\": \"%s\", \"bytes_per_s\": %.0f, \"frames_per_s\": %.0f"
+                 ", \"ns_per_byte\": %.2f, \"worst_put_ns\": %" PRIu64 ", \"puts\": %" PRIu64
+                 ", \"frames\": %" PRIu64 ", \"mismatches\": %" PRIu64
+                 ", \"decode_errors\": %" PRIu32 "}", is_first ? "" : ",\n", p_case->p_name,
+                 (double) bytes / seconds, (double) m_handled / seconds,
+                 (double) total_ns / (double) bytes, worst_ns, puts, m_handled, m_mismatches,
+                 stats.counters[APP_STATS_DECODE_ERRORS]);
+    }
+
+    return (0U == m_mismatches);
+}
+
+int main (int argc, char ** argv)
+{
+    FILE * const p_result = (argc > 1) ? fopen (argv[1], "w") : NULL;
+    bool is_ok = true;
+    printf ("%-18s%12s%12s%10s%10s%10s\n", "case", "MB/s", "frames/s", "worst_ns",
+            "mismatch", "discards");
+
+    if (NULL != p_result)
+    {
+        fprintf (p_result, "{\"frames\": %u, \"passes\": %u, \"buffer_len\": %u, \"results\": [\n",
+                 BENCH_FRAMES, BENCH_PASSES, APP_UART_RX_BUFFER_LEN);
+    }
+
+    for (size_t ii = 0; ii < (sizeof (m_cases) / sizeof (m_cases[0])); ii++)
+    {
+        is_ok = bench_run (&m_cases[ii], p_result, 0U == ii) && is_ok;
+    }
+
+    if (NULL != p_result)
+    {
+        fprintf (p_result, "]}\n");
+        (void) fclose (p_result);
+    }
+
+    return is_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/** @} */
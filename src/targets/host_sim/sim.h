@@ -0,0 +1,141 @@
+#ifndef SIM_H
+#define SIM_H
+
+/**
+ * @defgroup HOST_SIM Host simulation of gateway drivers.
+ * @{
+ */
+/**
+ *  @file sim.h
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Linux implementation of the Ruuvi driver interfaces used by the
+ *  application, for running the real application code on a workstation.
+ *
+ *  Time is virtual. Timers, radio and UART post callouts which run in
+ *  "interrupt context" from ri_yield, when the main loop has run out of
+ *  scheduled work. With SIM_SPEED=0 the clock jumps to the next callout
+ *  and the firmware runs as fast as the host allows, otherwise virtual time
+ *  is paced against wall clock so that a host program can talk to the
+ *  pseudo-terminal UART.
+ *
+ *  Simulation is configured by environment variables, see sim_options_t.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @brief Simulation parameters, read from environment at startup. */
+typedef struct
+{
+    uint32_t speed;            //!< SIM_SPEED: virtual per wall second, 0 for no pacing.
+    uint64_t duration_ms;      //!< SIM_DURATION_MS: exit after virtual time, 0 to run forever.
+    uint32_t adv_rate;         //!< SIM_ADV_RATE: advertisements per second while scanning.
+    uint32_t adv_tags;         //!< SIM_ADV_TAGS: distinct advertisers.
+    uint32_t adv_coded_pct;    //!< SIM_ADV_CODED_PCT: share of advertisers on LE Coded.
+    uint32_t adv_foreign_pct;  //!< SIM_ADV_FOREIGN_PCT: share of non-Ruuvi advertisers.
+    uint32_t adv_len;          //!< SIM_ADV_LEN: payload bytes, over 31 is extended.
+    const char * p_replay;     //!< SIM_REPLAY: capture file to replay instead of tags.
+    uint32_t replay_speed;     //!< SIM_REPLAY_SPEED: recorded time per virtual time.
+    uint32_t scan_timeout_ms;  //!< SIM_SCAN_TIMEOUT_MS: scan timeout of radio driver.
+    uint32_t uart_baud;        //!< SIM_UART_BAUD: line rate for TX completion.
+    const char * p_uart_link;  //!< SIM_UART_LINK: symlink to create for pty slave.
+    bool is_uart_sink;         //!< SIM_UART_SINK: discard TX instead of writing pty.
+    bool is_config_reply;      //!< SIM_FILTER is set: answer configuration poll.
+    bool is_filter_enabled;    //!< SIM_FILTER: manufacturer filter in reply.
+    const char * p_result;     //!< SIM_RESULT: file to write JSON results at exit.
+    uint32_t log_level;        //!< SIM_LOG: 0 none, 1 error, 2 warning, 3 info, 4 debug.
+} sim_options_t;
+
+/** @brief Counters of virtual radio. */
+typedef struct
+{
+    uint64_t sent;        //!< Advertisements sent by tags.
+    uint64_t received;    //!< Advertisements given to application.
+    uint64_t not_scanning;//!< Sent while scan was stopped.
+    uint64_t other_phy;   //!< Sent on PHY scan was not on.
+    uint64_t other_ch;    //!< Sent on channel scan was not on.
+    uint64_t rejected;    //!< Application returned error.
+    uint64_t timeouts;    //!< Scan timeouts reported.
+} sim_radio_stats_t;
+
+/** @brief Counters of pty UART. */
+typedef struct
+{
+    uint64_t tx_frames;  //!< Frames accepted.
+    uint64_t tx_adv;     //!< Advertisement report frames accepted.
+    uint64_t tx_bytes;   //!< Bytes accepted.
+    uint64_t tx_busy;    //!< Frames refused, driver queue full.
+    uint64_t tx_lost;    //!< Bytes not written to pty.
+    uint64_t rx_bytes;   //!< Bytes given to application.
+} sim_uart_stats_t;
+
+/** @brief Callout, run from ri_yield when due. */
+typedef void (*sim_callout_fp_t) (void * p_context);
+
+/** @brief Callout slot. */
+typedef struct
+{
+    sim_callout_fp_t handler; //!< Function to call, NULL if slot is free.
+    void * p_context;         //!< Argument of handler.
+    uint64_t due_us;          //!< Virtual time to run at.
+    bool is_active;           //!< Callout is pending.
+} sim_callout_t;
+
+/** @brief Get simulation parameters. */
+const sim_options_t * sim_options (void);
+
+/** @brief Current virtual time in microseconds. */
+uint64_t sim_time_us (void);
+
+/**
+ * @brief Allocate a callout slot.
+ *
+ * @param[in] handler Function to call when due.
+ * @param[in] p_context Argument of handler.
+ * @return Slot, NULL if all are in use.
+ */
+sim_callout_t * sim_callout_create (const sim_callout_fp_t handler, void * const p_context);
+
+/** @brief Run callout after delay_us of virtual time, replacing pending run. */
+void sim_callout_start (sim_callout_t * const p_callout, const uint64_t delay_us);
+
+/** @brief Cancel pending run of callout. */
+void sim_callout_stop (sim_callout_t * const p_callout);
+
+/**
+ * @brief Register file descriptor to poll for input while waiting.
+ *
+ * @param[in] fd Descriptor, readable data calls on_readable from ri_yield.
+ * @param[in] on_readable Input handler.
+ */
+void sim_input_set (const int fd, const sim_callout_fp_t on_readable);
+
+/** @brief Print log line with virtual time if level is enabled. */
+void sim_log (const uint32_t level, const char * const p_fmt, ...);
+
+/** @brief Print hex dump with virtual time if level is enabled. */
+void sim_log_hex (const uint32_t level, const void * const p_data, const uint32_t len);
+
+/** @brief Print simulation counters, called at exit. */
+void sim_radio_summary (void);
+
+/** @brief Print simulation counters, called at exit. */
+void sim_uart_summary (void);
+
+/** @brief Get counters of virtual radio. */
+void sim_radio_stats_get (sim_radio_stats_t * const p_stats);
+
+/** @brief Get counters of pty UART. */
+void sim_uart_stats_get (sim_uart_stats_t * const p_stats);
+
+/**
+ * @brief Write results of run to SIM_RESULT as a JSON object, called at exit.
+ *
+ * @param[in] virtual_us Virtual time simulated.
+ */
+void sim_result_write (const uint64_t virtual_us);
+
+/** @} */
+#endif // SIM_H
@@ -0,0 +1,217 @@
+/**
+ * @addtogroup HOST_SIM
+ * @{
+ */
+/**
+ *  @file sim_board.c
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Board peripherals without behaviour worth simulating: GPIO, LEDs,
+ *  flash kept in RAM for the run, log and error handling.
+ */
+#include "app_config.h"
+#include "nrf.h"
+#include "sim.h"
+#include <stdlib.h>
+#include <string.h>
+#include "ruuvi_driver_error.h"
+#include "ruuvi_interface_flash.h"
+#include "ruuvi_interface_gpio.h"
+#include "ruuvi_interface_log.h"
+#include "ruuvi_interface_timer.h"
+#include "ruuvi_task_led.h"
+
+#define SIM_FLASH_RECORDS     (4U)
+#define SIM_FLASH_RECORD_SIZE (256U)
+
+/** @brief Flash record. */
+typedef struct
+{
+    bool is_used;                        //!< Record has been written.
+    uint32_t page_id;                    //!< File of record.
+    uint32_t record_id;                  //!< Key of record.
+    size_t size;                         //!< Bytes in data.
+    uint8_t data[SIM_FLASH_RECORD_SIZE]; //!< Content.
+} sim_flash_record_t;
+
+NRF_POWER_Type sim_nrf_power;
+
+static bool m_is_gpio_init;
+static sim_flash_record_t m_records[SIM_FLASH_RECORDS];
+
+rd_status_t ri_gpio_init (void)
+{
+    m_is_gpio_init = true;
+    return RD_SUCCESS;
+}
+
+bool ri_gpio_is_init (void)
+{
+    return m_is_gpio_init;
+}
+
+rd_status_t ri_gpio_configure (const ri_gpio_id_t pin, const ri_gpio_mode_t mode)
+{
+    (void) pin;
+    (void) mode;
+    return RD_SUCCESS;
+}
+
+rd_status_t ri_gpio_write (const ri_gpio_id_t pin, const ri_gpio_state_t state)
+{
+    (void) pin;
+    (void) state;
+    return RD_SUCCESS;
+}
+
+static void on_led_timer (void * p_context)
+{
+    (void) p_context;
+}
+
+rd_status_t rt_led_init (const ri_gpio_id_t * const leds,
+                         const ri_gpio_state_t * const active_states,
+                         const size_t num_leds)
+{
+    static ri_timer_id_t led_timer = NULL;
+    (void) leds;
+    (void) active_states;
+    (void) num_leds;
+    // Blink timer of rt_led counts against RI_TIMER_MAX_INSTANCES.
+    return (NULL == led_timer)
+           ? ri_timer_create (&led_timer, RI_TIMER_MODE_SINGLE_SHOT, &on_led_timer)
+           : RD_SUCCESS;
+}
+
+rd_status_t rt_led_blink_once (const ri_gpio_id_t led, const uint32_t interval)
+{
+    sim_log (4U, "sim: led %u on for %u ms", (unsigned) led, (unsigned) interval);
+    return RD_SUCCESS;
+}
+
+rd_status_t rt_led_blink_stop (const ri_gpio_id_t led)
+{
+    (void) led;
+    return RD_SUCCESS;
+}
+
+static sim_flash_record_t * record_find (const uint32_t page_id, const uint32_t record_id)
+{
+    sim_flash_record_t * p_record = NULL;
+
+    for (size_t ii = 0; (ii < SIM_FLASH_RECORDS) && (NULL == p_record); ii++)
+    {
+        if (m_records[ii].is_used && (page_id == m_records[ii].page_id)
+                && (record_id == m_records[ii].record_id))
+        {
+            p_record = &m_records[ii];
+        }
+    }
+
+    return p_record;
+}
+
+rd_status_t ri_flash_init (void)
+{
+    return RD_SUCCESS;
+}
+
+rd_status_t ri_flash_record_set (const uint32_t page_id, const uint32_t record_id,
+                                 const size_t data_size, const void * const data)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    sim_flash_record_t * p_record = record_find (page_id, record_id);
+
+    for (size_t ii = 0; (ii < SIM_FLASH_RECORDS) && (NULL == p_record); ii++)
+    {
+        if (!m_records[ii].is_used)
+        {
+            p_record = &m_records[ii];
+        }
+    }
+
+    if (NULL == p_record)
+    {
+        err_code |= RD_ERROR_NO_MEM;
+    }
+    else if (data_size > SIM_FLASH_RECORD_SIZE)
+    {
+        err_code |= RD_ERROR_DATA_SIZE;
+    }
+    else
+    {
+        p_record->is_used = true;
+        p_record->page_id = page_id;
+        p_record->record_id = record_id;
+        p_record->size = data_size;
+        memcpy (p_record->data, data, data_size);
+    }
+
+    return err_code;
+}
+
+rd_status_t ri_flash_record_get (const uint32_t page_id, const uint32_t record_id,
+                                 const size_t data_size, void * const data)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    const sim_flash_record_t * const p_record = record_find (page_id, record_id);
+
+    if (NULL == p_record)
+    {
+        err_code |= RD_ERROR_NOT_FOUND;
+    }
+    else if (data_size < p_record->size)
+    {
+        err_code |= RD_ERROR_DATA_SIZE;
+    }
+    else
+    {
+        memcpy (data, p_record->data, p_record->size);
+    }
+
+    return err_code;
+}
+
+rd_status_t ri_flash_gc_run (void)
+{
+    return RD_SUCCESS;
+}
+
+bool ri_flash_is_busy (void)
+{
+    // Records are copied when set.
+    return false;
+}
+
+rd_status_t ri_log_init (const ri_log_severity_t min_severity)
+{
+    (void) min_severity;
+    return RD_SUCCESS;
+}
+
+void ri_log (const ri_log_severity_t severity, const char * const message)
+{
+    const size_t len = strlen (message);
+    // Messages end in newline on target, log line adds its own.
+    sim_log ( (uint32_t) severity, "%.*s",
+              (int) ( ( (0U != len) && ('\n' == message[len - 1U])) ? (len - 1U) : len),
+              message);
+}
+
+void rd_error_check (const rd_status_t error, const rd_status_t non_fatal_mask,
+                     const char * p_file, const int line)
+{
+    if (RD_SUCCESS != error)
+    {
+        sim_log (1U, "sim: error 0x%08X at %s:%d", (unsigned) error, p_file, line);
+    }
+
+    // Target resets on fatal errors, host has nothing to resume.
+    if (0 != (error & ~non_fatal_mask))
+    {
+        abort();
+    }
+}
+
+/** @} */
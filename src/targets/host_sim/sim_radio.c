@@ -0,0 +1,466 @@
+/**
+ * @addtogroup HOST_SIM
+ * @{
+ */
+/**
+ *  @file sim_radio.c
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Virtual radio: a population of tags advertising Ruuvi RAWv2 data, and
+ *  optionally other manufacturers' data. Payloads longer than legacy 31
+ *  bytes are sent as extended advertisements.
+ *
+ *  Tags advertise whether or not the gateway scans. An advertisement is
+ *  received if scan runs on its PHY and channel, so the counters show what
+ *  scan scheduling costs.
+ *
+ *  With SIM_REPLAY the tags are replaced by a capture file, see
+ *  app_capture.h. Records are given to the scan handler at their recorded
+ *  times divided by SIM_REPLAY_SPEED, on any PHY and channel since the
+ *  capture already is what the scanner received. Unless SIM_DURATION_MS is
+ *  set the simulation ends shortly after the last record.
+ */
+#include "app_capture.h"
+#include "app_config.h"
+#include "sim.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ble_gap.h"
+#include "ruuvi_driver_error.h"
+#include "ruuvi_interface_communication.h"
+#include "ruuvi_interface_communication_ble_advertising.h"
+#include "ruuvi_interface_communication_radio.h"
+#include "ruuvi_task_advertisement.h"
+
+#define SIM_RADIO_ADDRESS  (0xC0FFEE000001ULL) //!< MAC of the gateway.
+#define SIM_DEVICE_ID      (0x0123456789ABCDEFULL)
+#define SIM_TAG_ADDRESS    (0xD0000000000ULL)  //!< Base of tag MACs.
+#define SIM_RUUVI_MANUID   (0x0499U)
+#define SIM_FOREIGN_MANUID (0x004CU)
+#define SIM_ADV_LEGACY_LEN (31U)
+#define SIM_ADV_CHANNELS   (3U)
+#define SIM_AD_TYPE_MANUF  (0xFFU)
+#define SIM_REPLAY_DRAIN_US (1000000U) //!< Run after last record to empty queues.
+
+static bool m_is_radio_init;
+static ri_radio_modulation_t m_modulation;
+static bool m_is_adv_init;
+static rt_adv_init_t m_adv_params;
+static ri_comm_evt_handler_fp_t m_on_scan;
+static sim_callout_t * m_adv_callout;
+static sim_callout_t * m_timeout_callout;
+static uint32_t m_random = 0x2545F491U;
+static uint16_t m_measurement_seq;
+static sim_radio_stats_t m_stats;
+static FILE * mp_replay;              //!< Capture file being replayed.
+static ri_adv_scan_t m_replay_scan;   //!< Next record.
+static uint64_t m_replay_ms;          //!< Recorded time of next record from first.
+static uint32_t m_replay_prev_ms;     //!< Recorded time of previous record.
+static uint64_t m_replay_start_us;    //!< Virtual time of first record.
+static sim_callout_t * m_end_callout;
+
+/** @brief Small deterministic generator, runs are repeatable. */
+static uint32_t random_next (void)
+{
+    m_random ^= m_random << 13;
+    m_random ^= m_random >> 17;
+    m_random ^= m_random << 5;
+    return m_random;
+}
+
+static bool tag_is_coded (const uint32_t tag)
+{
+    return ( (tag * 100U) / sim_options()->adv_tags) < sim_options()->adv_coded_pct;
+}
+
+/** @brief Foreign tags are taken from the other end than coded ones. */
+static bool tag_is_foreign (const uint32_t tag)
+{
+    const uint32_t tags = sim_options()->adv_tags;
+    return ( ( (tags - 1U - tag) * 100U) / tags) < sim_options()->adv_foreign_pct;
+}
+
+static bool scan_has_phy (const bool is_coded)
+{
+    bool has_phy = is_coded ? (RI_RADIO_BLE_125KBPS == m_modulation)
+                   : (RI_RADIO_BLE_125KBPS != m_modulation);
+#if APP_BLE_SIMULTANEOUS_PHY_ENABLED
+
+    if (RI_RADIO_BLE_1MBPS_CODED == m_modulation)
+    {
+        has_phy = is_coded ? m_adv_params.is_rx_le_coded_phy_enabled
+                  : (m_adv_params.is_rx_le_1m_phy_enabled
+                     || m_adv_params.is_rx_le_2m_phy_enabled);
+    }
+
+#endif
+    return has_phy;
+}
+
+static bool scan_has_channel (const uint8_t ch_index)
+{
+    return ( (37U == ch_index) && m_adv_params.channels.channel_37)
+           || ( (38U == ch_index) && m_adv_params.channels.channel_38)
+           || ( (39U == ch_index) && m_adv_params.channels.channel_39);
+}
+
+/**
+ * @brief Fill advertisement of tag, flags and manufacturer data.
+ *
+ * Manufacturer data is RAWv2 truncated or padded with random bytes to
+ * length of payload.
+ */
+static void adv_build (ri_adv_scan_t * const p_scan, const uint32_t tag)
+{
+    const bool is_coded = tag_is_coded (tag);
+    const uint16_t manuid = tag_is_foreign (tag) ? SIM_FOREIGN_MANUID : SIM_RUUVI_MANUID;
+    const uint64_t mac = SIM_TAG_ADDRESS + tag;
+    const size_t adv_len = (sim_options()->adv_len < sizeof (p_scan->data))
+                           ? sim_options()->adv_len : sizeof (p_scan->data);
+    uint8_t * const p = p_scan->data;
+    size_t len = 0;
+    memset (p_scan, 0, sizeof (*p_scan));
+
+    for (size_t ii = 0; ii < BLE_MAC_ADDRESS_LENGTH; ii++)
+    {
+        p_scan->addr[ii] = (uint8_t) (mac >> (8U * (BLE_MAC_ADDRESS_LENGTH - 1U - ii)));
+    }
+
+    p_scan->rssi = (int8_t) (-40 - (int32_t) (tag % 50U));
+    p_scan->is_coded_phy = is_coded;
+    p_scan->primary_phy = is_coded ? BLE_GAP_PHY_CODED : BLE_GAP_PHY_1MBPS;
+    p_scan->secondary_phy = is_coded ? BLE_GAP_PHY_CODED
+                            : ( (adv_len > SIM_ADV_LEGACY_LEN) ? BLE_GAP_PHY_1MBPS
+                                : BLE_GAP_PHY_NOT_SET);
+    p_scan->ch_index = (uint8_t) (37U + (random_next() % SIM_ADV_CHANNELS));
+    p_scan->tx_power = BLE_GAP_POWER_LEVEL_INVALID;
+    // Flags: LE General Discoverable, BR/EDR not supported.
+    p[len++] = 0x02U;
+    p[len++] = 0x01U;
+    p[len++] = 0x06U;
+    // Manufacturer data: format 5, 24 bytes of data.
+    p[len++] = (uint8_t) (adv_len - 4U);
+    p[len++] = SIM_AD_TYPE_MANUF;
+    p[len++] = (uint8_t) (manuid & 0xFFU);
+    p[len++] = (uint8_t) (manuid >> 8U);
+    p[len++] = 0x05U;
+
+    for (size_t ii = 0; ii < 17U; ii++)
+    {
+        p[len++] = (uint8_t) random_next();
+    }
+
+    p[len++] = (uint8_t) (m_measurement_seq >> 8U);
+    p[len++] = (uint8_t) m_measurement_seq;
+
+    for (size_t ii = 0; ii < BLE_MAC_ADDRESS_LENGTH; ii++)
+    {
+        p[len++] = p_scan->addr[ii];
+    }
+
+    while (len < adv_len)
+    {
+        p[len++] = (uint8_t) random_next();
+    }
+
+    m_measurement_seq++;
+    p_scan->data_len = adv_len;
+}
+
+/**
+ * @brief Give advertisement to scan handler if scan would receive it.
+ *
+ * @param[in] p_scan Advertisement.
+ * @param[in] is_any_channel Receive on any PHY and channel scan runs on.
+ */
+static void adv_deliver (ri_adv_scan_t * const p_scan, const bool is_any_channel)
+{
+    m_stats.sent++;
+
+    if (NULL == m_on_scan)
+    {
+        m_stats.not_scanning++;
+    }
+    else if (!is_any_channel && !scan_has_phy (p_scan->is_coded_phy))
+    {
+        m_stats.other_phy++;
+    }
+    else if (!is_any_channel && !scan_has_channel (p_scan->ch_index))
+    {
+        m_stats.other_ch++;
+    }
+    else if (RD_SUCCESS == m_on_scan (RI_COMM_RECEIVED, p_scan, sizeof (*p_scan)))
+    {
+        m_stats.received++;
+    }
+    else
+    {
+        m_stats.rejected++;
+    }
+}
+
+static void on_adv_callout (void * p_context)
+{
+    (void) p_context;
+    const sim_options_t * const p_options = sim_options();
+    const uint32_t tag = random_next() % p_options->adv_tags;
+    ri_adv_scan_t scan;
+    adv_build (&scan, tag);
+    adv_deliver (&scan, false);
+    // Uniform interarrival between 0.5 and 1.5 average intervals.
+    const uint64_t mean_us = 1000000U / p_options->adv_rate;
+    sim_callout_start (m_adv_callout, (mean_us / 2U) + (random_next() % (mean_us + 1U)));
+}
+
+static void on_timeout_callout (void * p_context)
+{
+    (void) p_context;
+    const ri_comm_evt_handler_fp_t on_scan = m_on_scan;
+    m_on_scan = NULL;
+    m_stats.timeouts++;
+
+    if (NULL != on_scan)
+    {
+        (void) on_scan (RI_COMM_TIMEOUT, NULL, 0);
+    }
+}
+
+/**
+ * @brief Read next record of capture file.
+ *
+ * @return True if a record was read, false at end of file or on error.
+ */
+static bool replay_read (void)
+{
+    uint8_t record[APP_CAPTURE_RECORD_MAX_LEN];
+    size_t len = APP_CAPTURE_HEADER_LEN;
+    uint32_t time_ms = 0;
+    bool is_read = (1U == fread (record, APP_CAPTURE_HEADER_LEN, 1U, mp_replay));
+
+    if (is_read)
+    {
+        const size_t data_len = record[APP_CAPTURE_DATA_LEN_IDX];
+        len += data_len;
+        is_read = (data_len == fread (&record[APP_CAPTURE_HEADER_LEN], 1U, data_len,
+                                      mp_replay))
+                  && (RD_SUCCESS == app_capture_decode (record, &len, &time_ms,
+                                                        &m_replay_scan));
+    }
+
+    if (is_read)
+    {
+        // Recorded time wraps at 2^32 ms, differences do not.
+        m_replay_ms += (0U != m_stats.sent) ? (uint32_t) (time_ms - m_replay_prev_ms) : 0U;
+        m_replay_prev_ms = time_ms;
+    }
+
+    return is_read;
+}
+
+static void on_end_callout (void * p_context)
+{
+    (void) p_context;
+    exit (EXIT_SUCCESS);
+}
+
+/** @brief Schedule next record, or end of replay. */
+static void replay_next (void)
+{
+    if (replay_read())
+    {
+        const uint64_t due_us = m_replay_start_us
+                                + ( (m_replay_ms * 1000U) / sim_options()->replay_speed);
+        const uint64_t now_us = sim_time_us();
+        sim_callout_start (m_adv_callout, (due_us > now_us) ? (due_us - now_us) : 0U);
+    }
+    else
+    {
+        sim_log (3U, "sim: replay ended after %" PRIu64 " records", m_stats.sent);
+        (void) fclose (mp_replay);
+        mp_replay = NULL;
+
+        if (0U == sim_options()->duration_ms)
+        {
+            m_end_callout = sim_callout_create (&on_end_callout, NULL);
+            sim_callout_start (m_end_callout, SIM_REPLAY_DRAIN_US);
+        }
+    }
+}
+
+static void on_replay_callout (void * p_context)
+{
+    (void) p_context;
+    adv_deliver (&m_replay_scan, true);
+    replay_next();
+}
+
+/** @brief Open capture file given with SIM_REPLAY, exit if it is not one. */
+static void replay_start (void)
+{
+    const char magic[] = APP_CAPTURE_FILE_MAGIC;
+    char header[sizeof (magic)];
+    mp_replay = fopen (sim_options()->p_replay, "rb");
+
+    if ( (NULL == mp_replay) || (1U != fread (header, sizeof (header), 1U, mp_replay))
+            || (0 != memcmp (header, magic, sizeof (magic))))
+    {
+        fprintf (stderr, "sim: %s is not a capture file\n", sim_options()->p_replay);
+        exit (EXIT_FAILURE);
+    }
+
+    m_adv_callout = sim_callout_create (&on_replay_callout, NULL);
+    m_timeout_callout = sim_callout_create (&on_timeout_callout, NULL);
+    m_replay_start_us = sim_time_us();
+    replay_next();
+}
+
+/** @brief Tags start advertising when radio is first used. */
+static void tags_start (void)
+{
+    if ( (NULL == m_adv_callout) && (NULL != sim_options()->p_replay))
+    {
+        replay_start();
+    }
+    else if ( (NULL == m_adv_callout) && (0U != sim_options()->adv_rate))
+    {
+        m_adv_callout = sim_callout_create (&on_adv_callout, NULL);
+        m_timeout_callout = sim_callout_create (&on_timeout_callout, NULL);
+        sim_callout_start (m_adv_callout, 1000000U / sim_options()->adv_rate);
+    }
+}
+
+rd_status_t ri_radio_init (const ri_radio_modulation_t modulation)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (m_is_radio_init)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        m_is_radio_init = true;
+        m_modulation = modulation;
+        tags_start();
+    }
+
+    return err_code;
+}
+
+rd_status_t ri_radio_uninit (void)
+{
+    m_is_radio_init = false;
+    return RD_SUCCESS;
+}
+
+rd_status_t ri_radio_address_get (uint64_t * const address)
+{
+    *address = SIM_RADIO_ADDRESS;
+    return RD_SUCCESS;
+}
+
+rd_status_t ri_comm_id_get (uint64_t * const id)
+{
+    *id = SIM_DEVICE_ID;
+    return RD_SUCCESS;
+}
+
+rd_status_t rt_adv_init (rt_adv_init_t * const p_adv_init_params)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (!m_is_radio_init)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        m_adv_params = *p_adv_init_params;
+        m_is_adv_init = true;
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_adv_uninit (void)
+{
+    (void) rt_adv_scan_stop();
+    m_is_adv_init = false;
+    return RD_SUCCESS;
+}
+
+rd_status_t rt_adv_scan_start (const ri_comm_evt_handler_fp_t on_evt)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (!m_is_adv_init)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else
+    {
+        m_on_scan = on_evt;
+
+        if (NULL != m_timeout_callout)
+        {
+            sim_callout_start (m_timeout_callout,
+                               (uint64_t) sim_options()->scan_timeout_ms * 1000U);
+        }
+    }
+
+    return err_code;
+}
+
+rd_status_t rt_adv_scan_stop (void)
+{
+    m_on_scan = NULL;
+
+    if (NULL != m_timeout_callout)
+    {
+        sim_callout_stop (m_timeout_callout);
+    }
+
+    return RD_SUCCESS;
+}
+
+uint16_t ri_adv_parse_manuid (uint8_t * const data, const size_t data_length)
+{
+    uint16_t manuid = 0U;
+    size_t offset = 0U;
+
+    // AD structures: length, type, data of length - 1 bytes.
+    while ( (0U == manuid) && ( (offset + 3U) < data_length))
+    {
+        const size_t ad_len = data[offset];
+
+        if ( (SIM_AD_TYPE_MANUF == data[offset + 1U]) && (ad_len >= 3U)
+                && ( (offset + ad_len) < data_length))
+        {
+            manuid = (uint16_t) (data[offset + 2U] | (data[offset + 3U] << 8U));
+        }
+
+        offset += ad_len + 1U;
+    }
+
+    return manuid;
+}
+
+void sim_radio_stats_get (sim_radio_stats_t * const p_stats)
+{
+    *p_stats = m_stats;
+}
+
+void sim_radio_summary (void)
+{
+    fprintf (stderr,
+             "sim: radio: sent=%" PRIu64 " received=%" PRIu64 " not_scanning=%" PRIu64
+             " other_phy=%" PRIu64 " other_ch=%" PRIu64 " rejected=%" PRIu64
+             " timeouts=%" PRIu64 "\n",
+             m_stats.sent, m_stats.received, m_stats.not_scanning, m_stats.other_phy,
+             m_stats.other_ch, m_stats.rejected, m_stats.timeouts);
+}
+
+/** @} */
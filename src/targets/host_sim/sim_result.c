@@ -0,0 +1,103 @@
+/**
+ * @addtogroup HOST_SIM
+ * @{
+ */
+/**
+ *  @file sim_result.c
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Machine readable results of a run, for benchmarks comparing releases.
+ *
+ *  CPU time is that of the whole host process divided by advertisements
+ *  given to application, so it includes the cost of the simulation. It is
+ *  meant for comparing builds on one host, not for estimating the target.
+ */
+#include "app_config.h"
+#include "app_stats.h"
+#include "sim.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <time.h>
+
+/** @brief Names of application counters in order of app_stats_id_t. */
+static const char * const m_app_stats_names[] =
+{
+    "rx_1m",
+    "rx_2m",
+    "rx_coded",
+    "fltr_manuf_id",
+    "fltr_too_long",
+    "drop_sched_full",
+    "drop_uart_busy",
+    "encode_errors",
+    "tx_frames",
+    "tx_bytes",
+    "rx_frames",
+    "decode_errors"
+};
+
+_Static_assert ( (sizeof (m_app_stats_names) / sizeof (m_app_stats_names[0]))
+                 == APP_STATS_NUM, "Name every application counter");
+
+static uint64_t cpu_ns (void)
+{
+    struct timespec ts;
+    (void) clock_gettime (CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ( (uint64_t) ts.tv_sec * 1000000000U) + (uint64_t) ts.tv_nsec;
+}
+
+void sim_result_write (const uint64_t virtual_us)
+{
+    const sim_options_t * const p_options = sim_options();
+    FILE * const p_file = (NULL != p_options->p_result) ? fopen (p_options->p_result, "w")
+                          : NULL;
+
+    if (NULL != p_file)
+    {
+        const uint64_t cpu = cpu_ns();
+        sim_radio_stats_t radio;
+        sim_uart_stats_t uart;
+        app_stats_t app;
+        sim_radio_stats_get (&radio);
+        sim_uart_stats_get (&uart);
+        app_stats_get (&app, false);
+        fprintf (p_file, "{\"options\": {\"adv_rate\": %" PRIu32 ", \"adv_tags\": %" PRIu32
+                 ", \"adv_len\": %" PRIu32 ", \"adv_coded_pct\": %" PRIu32
+                 ", \"adv_foreign_pct\": %" PRIu32 ", \"replay_speed\": %" PRIu32
+                 ", \"filter\": %s, \"uart_baud\": %" PRIu32 "},\n",
+                 p_options->adv_rate, p_options->adv_tags, p_options->adv_len,
+                 p_options->adv_coded_pct, p_options->adv_foreign_pct,
+                 (NULL != p_options->p_replay) ? p_options->replay_speed : 0U,
+                 p_options->is_config_reply ? (p_options->is_filter_enabled ? "true" : "false")
+                 : "null", p_options->uart_baud);
+        fprintf (p_file, " \"virtual_us\": %" PRIu64 ", \"cpu_ns\": %" PRIu64
+                 ", \"cpu_ns_per_adv\": %" PRIu64 ", \"forwarded_per_s\": %.1f,\n",
+                 virtual_us, cpu, (0U != radio.received) ? (cpu / radio.received) : 0U,
+                 (0U != virtual_us) ? ( (double) uart.tx_adv * 1000000.0 / (double) virtual_us)
+                 : 0.0);
+        fprintf (p_file, " \"radio\": {\"sent\": %" PRIu64 ", \"received\": %" PRIu64
+                 ", \"not_scanning\": %" PRIu64 ", \"other_phy\": %" PRIu64
+                 ", \"other_ch\": %" PRIu64 ", \"rejected\": %" PRIu64
+                 ", \"timeouts\": %" PRIu64 "},\n",
+                 radio.sent, radio.received, radio.not_scanning, radio.other_phy,
+                 radio.other_ch, radio.rejected, radio.timeouts);
+        fprintf (p_file, " \"uart\": {\"tx_frames\": %" PRIu64 ", \"tx_adv\": %" PRIu64
+                 ", \"tx_bytes\": %" PRIu64 ", \"tx_busy\": %" PRIu64
+                 ", \"tx_lost\": %" PRIu64 ", \"rx_bytes\": %" PRIu64 "},\n",
+                 uart.tx_frames, uart.tx_adv, uart.tx_bytes, uart.tx_busy, uart.tx_lost,
+                 uart.rx_bytes);
+        fprintf (p_file, " \"app\": {");
+
+        for (size_t ii = 0; ii < APP_STATS_NUM; ii++)
+        {
+            fprintf (p_file, "%s\"%s\": %" PRIu32, (0U == ii) ? "" : ", ",
+                     m_app_stats_names[ii], app.counters[ii]);
+        }
+
+        fprintf (p_file, "}}\n");
+        (void) fclose (p_file);
+    }
+}
+
+/** @} */
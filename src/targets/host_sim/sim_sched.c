@@ -0,0 +1,87 @@
+/**
+ * @addtogroup HOST_SIM
+ * @{
+ */
+/**
+ *  @file sim_sched.c
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Scheduler with the queue length and event size of the target.
+ */
+#include "app_config.h"
+#include "sim.h"
+#include <string.h>
+#include "ruuvi_driver_error.h"
+#include "ruuvi_interface_scheduler.h"
+
+/** @brief Queued event, data is copied like in app_scheduler. */
+typedef struct
+{
+    ri_scheduler_event_handler_t handler; //!< Function to run in main loop.
+    uint16_t size;                        //!< Bytes in data.
+    uint8_t data[RI_SCHEDULER_SIZE];      //!< Copy of event data.
+} sim_event_t;
+
+static sim_event_t m_events[RI_SCHEDULER_LENGTH];
+static uint32_t m_head;
+static uint32_t m_count;
+
+rd_status_t ri_scheduler_init (void)
+{
+    m_head = 0U;
+    m_count = 0U;
+    return RD_SUCCESS;
+}
+
+rd_status_t ri_scheduler_execute (void)
+{
+    while (0U != m_count)
+    {
+        sim_event_t * const p_event = &m_events[m_head];
+        // Handler may put new events, slot is released after it returns.
+        p_event->handler ( (0U != p_event->size) ? p_event->data : NULL, p_event->size);
+        m_head = (m_head + 1U) % RI_SCHEDULER_LENGTH;
+        m_count--;
+    }
+
+    return RD_SUCCESS;
+}
+
+rd_status_t ri_scheduler_event_put (void const * const p_event_data,
+                                    const uint16_t event_size,
+                                    const ri_scheduler_event_handler_t handler)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (NULL == handler)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if (event_size > RI_SCHEDULER_SIZE)
+    {
+        err_code |= RD_ERROR_INVALID_LENGTH;
+    }
+    // Slot of running event is still in use.
+    else if (m_count >= RI_SCHEDULER_LENGTH)
+    {
+        err_code |= RD_ERROR_NO_MEM;
+    }
+    else
+    {
+        sim_event_t * const p_event = &m_events[ (m_head + m_count) % RI_SCHEDULER_LENGTH];
+        p_event->handler = handler;
+        p_event->size = (NULL != p_event_data) ? event_size : 0U;
+
+        if (0U != p_event->size)
+        {
+            memcpy (p_event->data, p_event_data, event_size);
+        }
+
+        m_count++;
+    }
+
+    return err_code;
+}
+
+/** @} */
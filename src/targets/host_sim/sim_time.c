@@ -0,0 +1,451 @@
+/**
+ * @addtogroup HOST_SIM
+ * @{
+ */
+/**
+ *  @file sim_time.c
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  Virtual time: callouts, RTC, timers, watchdog and yield.
+ */
+#include "app_config.h"
+#include "app_prof.h"
+#include "sim.h"
+#include <inttypes.h>
+#include <poll.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "ruuvi_driver_error.h"
+#include "ruuvi_interface_rtc.h"
+#include "ruuvi_interface_timer.h"
+#include "ruuvi_interface_watchdog.h"
+#include "ruuvi_interface_yield.h"
+
+#define SIM_CALLOUTS_MAX (16U) //!< Timers of application and drivers.
+#define SIM_US_PER_MS    (1000U)
+#define SIM_ADV_RATE_MAX (100000U) //!< Keeps advertisement interval above 0 us.
+#define SIM_ADV_LEN_LEGACY (31U)   //!< Payload of legacy advertisement.
+#define SIM_ADV_LEN_MIN  (8U)      //!< Flags and manufacturer ID.
+
+/** @brief Application timer on top of a callout. */
+typedef struct
+{
+    sim_callout_t * p_callout;       //!< Slot of timer.
+    ri_timer_mode_t mode;            //!< Single shot or repeated.
+    ri_timer_timeout_fp_t handler;   //!< Timeout handler of application.
+    void * p_context;                //!< Context given on start.
+    uint64_t interval_us;            //!< Period of repeated timer.
+} sim_timer_t;
+
+static sim_options_t m_options;
+static sim_callout_t m_callouts[SIM_CALLOUTS_MAX];
+static sim_timer_t m_timers[RI_TIMER_MAX_INSTANCES];
+static uint64_t m_now_us;
+static uint64_t m_wall_start_ns;
+static int m_input_fd = -1;
+static sim_callout_fp_t m_on_input;
+static sim_callout_t * m_wdt_callout;
+static wdt_evt_handler_t m_on_wdt;
+static uint64_t m_wdt_interval_us;
+
+static uint64_t wall_ns (void)
+{
+    struct timespec ts;
+    (void) clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ( (uint64_t) ts.tv_sec * 1000000000U) + (uint64_t) ts.tv_nsec;
+}
+
+#if APP_PROF_ENABLED
+/** @brief Profile with host nanoseconds instead of CPU cycles. */
+static uint32_t prof_clock (void)
+{
+    return (uint32_t) wall_ns();
+}
+#endif
+
+static uint64_t env_u64 (const char * const p_name, const uint64_t default_value)
+{
+    const char * const p_value = getenv (p_name);
+    return (NULL != p_value) ? strtoull (p_value, NULL, 0) : default_value;
+}
+
+static void on_exit_summary (void)
+{
+    fprintf (stderr, "sim: stopped at %" PRIu64 " ms\n", m_now_us / SIM_US_PER_MS);
+    sim_radio_summary();
+    sim_uart_summary();
+    sim_result_write (m_now_us);
+}
+
+/** @brief Read options before firmware main runs. */
+__attribute__ ( (constructor)) static void sim_init (void)
+{
+    m_options.speed = (uint32_t) env_u64 ("SIM_SPEED", 1U);
+    m_options.duration_ms = env_u64 ("SIM_DURATION_MS", 0U);
+    m_options.adv_rate = (uint32_t) env_u64 ("SIM_ADV_RATE", 100U);
+    m_options.adv_tags = (uint32_t) env_u64 ("SIM_ADV_TAGS", 20U);
+    m_options.adv_coded_pct = (uint32_t) env_u64 ("SIM_ADV_CODED_PCT", 0U);
+    m_options.adv_foreign_pct = (uint32_t) env_u64 ("SIM_ADV_FOREIGN_PCT", 0U);
+    m_options.adv_len = (uint32_t) env_u64 ("SIM_ADV_LEN", SIM_ADV_LEN_LEGACY);
+    m_options.p_replay = getenv ("SIM_REPLAY");
+    m_options.replay_speed = (uint32_t) env_u64 ("SIM_REPLAY_SPEED", 1U);
+    m_options.scan_timeout_ms = (uint32_t) env_u64 ("SIM_SCAN_TIMEOUT_MS", 21000U);
+    m_options.uart_baud = (uint32_t) env_u64 ("SIM_UART_BAUD", 115200U);
+    m_options.p_uart_link = getenv ("SIM_UART_LINK");
+    m_options.is_uart_sink = (0U != env_u64 ("SIM_UART_SINK", 0U));
+    m_options.is_config_reply = (NULL != getenv ("SIM_FILTER"));
+    m_options.is_filter_enabled = (0U != env_u64 ("SIM_FILTER", 0U));
+    m_options.p_result = getenv ("SIM_RESULT");
+    m_options.log_level = (uint32_t) env_u64 ("SIM_LOG", 2U);
+
+    if (m_options.adv_rate > SIM_ADV_RATE_MAX)
+    {
+        m_options.adv_rate = SIM_ADV_RATE_MAX;
+    }
+
+    // Upper limit is size of scan buffer, applied by radio.
+    if (m_options.adv_len < SIM_ADV_LEN_MIN)
+    {
+        m_options.adv_len = SIM_ADV_LEN_MIN;
+    }
+
+    if (0U == m_options.adv_tags)
+    {
+        m_options.adv_tags = 1U;
+    }
+
+    if (0U == m_options.replay_speed)
+    {
+        m_options.replay_speed = 1U;
+    }
+
+    if (0U == m_options.uart_baud)
+    {
+        m_options.uart_baud = 115200U;
+    }
+
+    m_wall_start_ns = wall_ns();
+    (void) atexit (&on_exit_summary);
+#if APP_PROF_ENABLED
+    app_prof_clock_set (&prof_clock);
+#endif
+}
+
+const sim_options_t * sim_options (void)
+{
+    return &m_options;
+}
+
+uint64_t sim_time_us (void)
+{
+    return m_now_us;
+}
+
+void sim_log (const uint32_t level, const char * const p_fmt, ...)
+{
+    if (level <= m_options.log_level)
+    {
+        va_list args;
+        fprintf (stderr, "[%10.3f] ", (double) m_now_us / 1000000.0);
+        va_start (args, p_fmt);
+        vfprintf (stderr, p_fmt, args);
+        va_end (args);
+        fputc ('\n', stderr);
+    }
+}
+
+void sim_log_hex (const uint32_t level, const void * const p_data, const uint32_t len)
+{
+    if (level <= m_options.log_level)
+    {
+        const uint8_t * const p_bytes = (const uint8_t *) p_data;
+        fprintf (stderr, "[%10.3f] ", (double) m_now_us / 1000000.0);
+
+        for (uint32_t ii = 0; ii < len; ii++)
+        {
+            fprintf (stderr, "%02X ", p_bytes[ii]);
+        }
+
+        fputc ('\n', stderr);
+    }
+}
+
+sim_callout_t * sim_callout_create (const sim_callout_fp_t handler, void * const p_context)
+{
+    sim_callout_t * p_callout = NULL;
+
+    for (size_t ii = 0; (ii < SIM_CALLOUTS_MAX) && (NULL == p_callout); ii++)
+    {
+        if (NULL == m_callouts[ii].handler)
+        {
+            p_callout = &m_callouts[ii];
+            p_callout->handler = handler;
+            p_callout->p_context = p_context;
+            p_callout->is_active = false;
+        }
+    }
+
+    return p_callout;
+}
+
+void sim_callout_start (sim_callout_t * const p_callout, const uint64_t delay_us)
+{
+    p_callout->due_us = m_now_us + delay_us;
+    p_callout->is_active = true;
+}
+
+void sim_callout_stop (sim_callout_t * const p_callout)
+{
+    p_callout->is_active = false;
+}
+
+void sim_input_set (const int fd, const sim_callout_fp_t on_readable)
+{
+    m_input_fd = fd;
+    m_on_input = on_readable;
+}
+
+/** @brief Find earliest pending callout. */
+static sim_callout_t * callout_next (void)
+{
+    sim_callout_t * p_next = NULL;
+
+    for (size_t ii = 0; ii < SIM_CALLOUTS_MAX; ii++)
+    {
+        if (m_callouts[ii].is_active
+                && ( (NULL == p_next) || (m_callouts[ii].due_us < p_next->due_us)))
+        {
+            p_next = &m_callouts[ii];
+        }
+    }
+
+    return p_next;
+}
+
+/**
+ * @brief Wait for input until virtual time reaches target.
+ *
+ * @param[in] target_us Virtual time to wait until.
+ * @return True if input is readable, virtual time is then at arrival.
+ */
+static bool input_wait (const uint64_t target_us)
+{
+    bool has_input = false;
+    int timeout_ms = 0;
+
+    if ( (0U != m_options.speed) && (UINT64_MAX != target_us))
+    {
+        const uint64_t target_ns = m_wall_start_ns
+                                   + ( (target_us * 1000U) / m_options.speed);
+        const uint64_t now_ns = wall_ns();
+        timeout_ms = (target_ns > now_ns) ? (int) ( (target_ns - now_ns + 999999U) / 1000000U)
+                     : 0;
+    }
+    else if (UINT64_MAX == target_us)
+    {
+        // Nothing scheduled, only input can wake up.
+        timeout_ms = -1;
+    }
+    else
+    {
+        // Free running, only check for input.
+    }
+
+    if (m_input_fd >= 0)
+    {
+        struct pollfd pfd = { .fd = m_input_fd, .events = POLLIN };
+        has_input = (poll (&pfd, 1, timeout_ms) > 0) && (0 != (pfd.revents & POLLIN));
+    }
+    else if (timeout_ms > 0)
+    {
+        (void) poll (NULL, 0, timeout_ms);
+    }
+    else if (timeout_ms < 0)
+    {
+        sim_log (1U, "sim: nothing to simulate");
+        exit (EXIT_FAILURE);
+    }
+    else
+    {
+        // No input and no wait.
+    }
+
+    if (has_input && (0U != m_options.speed))
+    {
+        const uint64_t wall_us = ( (wall_ns() - m_wall_start_ns) * m_options.speed) / 1000U;
+
+        if ( (wall_us > m_now_us) && (wall_us < target_us))
+        {
+            m_now_us = wall_us;
+        }
+    }
+
+    return has_input;
+}
+
+rd_status_t ri_yield_init (void)
+{
+    return RD_SUCCESS;
+}
+
+rd_status_t ri_yield_low_power_enable (const bool enable)
+{
+    (void) enable;
+    return RD_SUCCESS;
+}
+
+/**
+ * @brief Wait for next "interrupt" and run it.
+ *
+ * Input is handled before callouts due at the same virtual time.
+ */
+rd_status_t ri_yield (void)
+{
+    sim_callout_t * p_next = callout_next();
+    uint64_t target_us = (NULL != p_next) ? p_next->due_us : UINT64_MAX;
+    const uint64_t end_us = m_options.duration_ms * SIM_US_PER_MS;
+
+    if ( (0U != end_us) && (target_us > end_us))
+    {
+        target_us = end_us;
+    }
+
+    if (input_wait (target_us))
+    {
+        m_on_input (NULL);
+    }
+    else
+    {
+        m_now_us = (target_us > m_now_us) ? target_us : m_now_us;
+
+        if ( (0U != end_us) && (m_now_us >= end_us))
+        {
+            exit (EXIT_SUCCESS);
+        }
+
+        // Run every callout due now, including ones started by earlier callouts.
+        for (p_next = callout_next(); (NULL != p_next) && (p_next->due_us <= m_now_us);
+                p_next = callout_next())
+        {
+            p_next->is_active = false;
+            p_next->handler (p_next->p_context);
+        }
+    }
+
+    return RD_SUCCESS;
+}
+
+rd_status_t ri_rtc_init (void)
+{
+    return RD_SUCCESS;
+}
+
+uint64_t ri_rtc_millis (void)
+{
+    return m_now_us / SIM_US_PER_MS;
+}
+
+rd_status_t ri_timer_init (void)
+{
+    return RD_SUCCESS;
+}
+
+static void on_timer_callout (void * p_context)
+{
+    sim_timer_t * const p_timer = (sim_timer_t *) p_context;
+
+    if (RI_TIMER_MODE_REPEATED == p_timer->mode)
+    {
+        sim_callout_start (p_timer->p_callout, p_timer->interval_us);
+    }
+
+    p_timer->handler (p_timer->p_context);
+}
+
+rd_status_t ri_timer_create (ri_timer_id_t * p_timer_id, ri_timer_mode_t mode,
+                             ri_timer_timeout_fp_t timeout_handler)
+{
+    rd_status_t err_code = RD_ERROR_NO_MEM;
+
+    for (size_t ii = 0; (ii < RI_TIMER_MAX_INSTANCES) && (RD_SUCCESS != err_code); ii++)
+    {
+        if (NULL == m_timers[ii].p_callout)
+        {
+            m_timers[ii].p_callout = sim_callout_create (&on_timer_callout, &m_timers[ii]);
+
+            if (NULL != m_timers[ii].p_callout)
+            {
+                m_timers[ii].mode = mode;
+                m_timers[ii].handler = timeout_handler;
+                *p_timer_id = &m_timers[ii];
+                err_code = RD_SUCCESS;
+            }
+        }
+    }
+
+    return err_code;
+}
+
+rd_status_t ri_timer_start (ri_timer_id_t timer_id, uint32_t ms, void * const context)
+{
+    sim_timer_t * const p_timer = (sim_timer_t *) timer_id;
+    p_timer->p_context = context;
+    p_timer->interval_us = (uint64_t) ms * SIM_US_PER_MS;
+    sim_callout_start (p_timer->p_callout, p_timer->interval_us);
+    return RD_SUCCESS;
+}
+
+rd_status_t ri_timer_stop (ri_timer_id_t timer_id)
+{
+    sim_timer_t * const p_timer = (sim_timer_t *) timer_id;
+    sim_callout_stop (p_timer->p_callout);
+    return RD_SUCCESS;
+}
+
+/** @brief Watchdog bites: report and exit, there is no reset on host. */
+static void on_wdt_callout (void * p_context)
+{
+    (void) p_context;
+
+    if (NULL != m_on_wdt)
+    {
+        m_on_wdt();
+    }
+
+    sim_log (1U, "sim: watchdog expired");
+    exit (3);
+}
+
+rd_status_t ri_watchdog_init (const uint32_t interval, const wdt_evt_handler_t handler)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    m_wdt_callout = sim_callout_create (&on_wdt_callout, NULL);
+
+    if (NULL == m_wdt_callout)
+    {
+        err_code |= RD_ERROR_NO_MEM;
+    }
+    else
+    {
+        m_on_wdt = handler;
+        m_wdt_interval_us = (uint64_t) interval * SIM_US_PER_MS;
+        sim_callout_start (m_wdt_callout, m_wdt_interval_us);
+    }
+
+    return err_code;
+}
+
+rd_status_t ri_watchdog_feed (void)
+{
+    if (NULL != m_wdt_callout)
+    {
+        sim_callout_start (m_wdt_callout, m_wdt_interval_us);
+    }
+
+    return RD_SUCCESS;
+}
+
+/** @} */
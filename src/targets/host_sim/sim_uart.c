@@ -0,0 +1,272 @@
+/**
+ * @addtogroup HOST_SIM
+ * @{
+ */
+/**
+ *  @file sim_uart.c
+ *  @date 2026-10-18
+ *  @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ *  UART on a pseudo-terminal. Host programs open the slave side, e.g. the
+ *  path given in SIM_UART_LINK, like the serial port of a gateway.
+ *
+ *  Frames are written to the pty at once and reported sent after their
+ *  time on the wire at SIM_UART_BAUD. As on the wire, nothing waits for a
+ *  reader: bytes which do not fit in the pty are lost and counted.
+ *
+ *  With SIM_FILTER set the simulation answers configuration polls of the
+ *  gateway like the ESP32 would, so benchmarks run without a host program.
+ */
+#include "app_config.h"
+#include "app_uart_ext.h"
+#include "sim.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include "ruuvi_driver_error.h"
+#include "ruuvi_endpoint_ca_uart.h"
+#include "ruuvi_interface_communication.h"
+#include "ruuvi_interface_communication_uart.h"
+
+#define SIM_UART_TX_FRAMES   (8U)   //!< Frames driver accepts before reporting busy.
+#define SIM_UART_RX_CHUNK    (64U)  //!< Bytes given to application per receive event.
+#define SIM_UART_BITS_PER_BYTE (10U)
+#define SIM_UART_CMD_INDEX   (2U)   //!< STX, LEN, CMD.
+#define SIM_UART_REPLY_US    (1000U) //!< Response time of configuration reply.
+#define SIM_UART_MANUID      (0x0499U)
+
+static ri_comm_channel_t * m_p_channel;
+static int m_master_fd = -1;
+static int m_slave_fd = -1;
+static sim_callout_t * m_tx_callout;
+static uint64_t m_tx_done_us[SIM_UART_TX_FRAMES]; //!< Completion times, oldest first.
+static uint32_t m_tx_head;
+static uint32_t m_tx_count;
+static sim_uart_stats_t m_stats;
+static sim_callout_t * m_reply_callout;
+static uint8_t m_reply[RI_COMM_MESSAGE_MAX_LENGTH];
+static uint8_t m_reply_len;
+
+static void tx_callout_arm (void)
+{
+    if (0U != m_tx_count)
+    {
+        const uint64_t now_us = sim_time_us();
+        const uint64_t done_us = m_tx_done_us[m_tx_head];
+        sim_callout_start (m_tx_callout, (done_us > now_us) ? (done_us - now_us) : 0U);
+    }
+}
+
+static void on_tx_callout (void * p_context)
+{
+    (void) p_context;
+    m_tx_head = (m_tx_head + 1U) % SIM_UART_TX_FRAMES;
+    m_tx_count--;
+    tx_callout_arm();
+    (void) m_p_channel->on_evt (RI_COMM_SENT, NULL, 0);
+}
+
+static void on_reply_callout (void * p_context)
+{
+    (void) p_context;
+    m_stats.rx_bytes += m_reply_len;
+    (void) m_p_channel->on_evt (RI_COMM_RECEIVED, m_reply, m_reply_len);
+}
+
+/** @brief Answer configuration poll with scan configuration of options. */
+static void config_reply (void)
+{
+    const sim_options_t * const p_options = sim_options();
+    re_ca_uart_payload_t cfg = {0};
+    cfg.cmd = RE_CA_UART_SET_ALL;
+    cfg.params.all_params.fltr_id.id = SIM_UART_MANUID;
+    cfg.params.all_params.bools.fltr_tags.state = p_options->is_filter_enabled;
+    cfg.params.all_params.bools.use_coded_phy.state = (0U != p_options->adv_coded_pct);
+    cfg.params.all_params.bools.use_1m_phy.state = true;
+    cfg.params.all_params.bools.use_2m_phy.state = false;
+    cfg.params.all_params.bools.ch_37.state = true;
+    cfg.params.all_params.bools.ch_38.state = true;
+    cfg.params.all_params.bools.ch_39.state = true;
+    cfg.params.all_params.max_adv_len = (uint8_t) p_options->adv_len;
+    m_reply_len = sizeof (m_reply);
+
+    if (RE_SUCCESS == re_ca_uart_encode (m_reply, &m_reply_len, &cfg))
+    {
+        sim_callout_start (m_reply_callout, SIM_UART_REPLY_US);
+    }
+}
+
+static rd_status_t uart_send (ri_comm_message_t * const msg)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (m_master_fd < 0)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else if (m_tx_count >= SIM_UART_TX_FRAMES)
+    {
+        m_stats.tx_busy++;
+        err_code |= RD_ERROR_BUSY;
+    }
+    else
+    {
+        const uint8_t cmd = msg->data[SIM_UART_CMD_INDEX];
+        const ssize_t written = sim_options()->is_uart_sink
+                                ? (ssize_t) msg->data_length
+                                : write (m_master_fd, msg->data, msg->data_length);
+        const size_t lost = (written < 0) ? msg->data_length
+                            : (msg->data_length - (size_t) written);
+        const uint64_t line_us = ( (uint64_t) msg->data_length * SIM_UART_BITS_PER_BYTE
+                                   * 1000000U) / sim_options()->uart_baud;
+        const uint64_t now_us = sim_time_us();
+        uint64_t start_us = now_us;
+
+        if (0U != m_tx_count)
+        {
+            const uint64_t last_us = m_tx_done_us[ (m_tx_head + m_tx_count - 1U)
+                                                   % SIM_UART_TX_FRAMES];
+            start_us = (last_us > now_us) ? last_us : now_us;
+        }
+
+        m_tx_done_us[ (m_tx_head + m_tx_count) % SIM_UART_TX_FRAMES] = start_us + line_us;
+        m_tx_count++;
+
+        if (1U == m_tx_count)
+        {
+            tx_callout_arm();
+        }
+
+        m_stats.tx_frames++;
+        m_stats.tx_bytes += msg->data_length;
+        m_stats.tx_lost += lost;
+
+        if ( (RE_CA_UART_ADV_RPRT2 == cmd) || (APP_UART_EXT_ADV_RPRT_TS == cmd))
+        {
+            m_stats.tx_adv++;
+        }
+        else if ( (RE_CA_UART_GET_ALL == cmd) && sim_options()->is_config_reply)
+        {
+            config_reply();
+        }
+        else
+        {
+            // Other frames are only counted.
+        }
+
+        sim_log (4U, "sim: uart tx %u bytes", (unsigned) msg->data_length);
+    }
+
+    return err_code;
+}
+
+static rd_status_t uart_read (ri_comm_message_t * const msg)
+{
+    (void) msg;
+    return RD_ERROR_NOT_SUPPORTED;
+}
+
+static void on_readable (void * p_context)
+{
+    (void) p_context;
+    uint8_t data[SIM_UART_RX_CHUNK];
+    const ssize_t len = read (m_master_fd, data, sizeof (data));
+
+    if ( (len > 0) && (NULL != m_p_channel->on_evt))
+    {
+        m_stats.rx_bytes += (uint64_t) len;
+        (void) m_p_channel->on_evt (RI_COMM_RECEIVED, data, (size_t) len);
+    }
+}
+
+rd_status_t ri_uart_init (ri_comm_channel_t * const channel)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (NULL == channel)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else
+    {
+        channel->send = &uart_send;
+        channel->read = &uart_read;
+        m_p_channel = channel;
+    }
+
+    return err_code;
+}
+
+/** @brief Open pty, line settings of config have no meaning on host. */
+rd_status_t ri_uart_config (const ri_uart_init_t * const config)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    (void) config;
+
+    if (m_master_fd < 0)
+    {
+        m_master_fd = posix_openpt (O_RDWR | O_NOCTTY | O_NONBLOCK);
+        m_tx_callout = sim_callout_create (&on_tx_callout, NULL);
+        m_reply_callout = sim_callout_create (&on_reply_callout, NULL);
+    }
+
+    if ( (m_master_fd < 0) || (NULL == m_tx_callout) || (NULL == m_reply_callout)
+            || (0 != grantpt (m_master_fd)) || (0 != unlockpt (m_master_fd)))
+    {
+        err_code |= RD_ERROR_INTERNAL;
+    }
+    else
+    {
+        const char * const p_slave = ptsname (m_master_fd);
+        struct termios tio;
+        // Keep slave open, pty reports hangup while no program has it open.
+        m_slave_fd = open (p_slave, O_RDWR | O_NOCTTY);
+
+        if ( (m_slave_fd >= 0) && (0 == tcgetattr (m_slave_fd, &tio)))
+        {
+            cfmakeraw (&tio);
+            (void) tcsetattr (m_slave_fd, TCSANOW, &tio);
+        }
+
+        if (NULL != sim_options()->p_uart_link)
+        {
+            (void) unlink (sim_options()->p_uart_link);
+
+            if (0 != symlink (p_slave, sim_options()->p_uart_link))
+            {
+                sim_log (1U, "sim: symlink %s: errno %d", sim_options()->p_uart_link, errno);
+            }
+        }
+
+        fprintf (stderr, "sim: uart on %s\n", p_slave);
+        sim_input_set (m_master_fd, &on_readable);
+    }
+
+    return err_code;
+}
+
+void sim_uart_stats_get (sim_uart_stats_t * const p_stats)
+{
+    *p_stats = m_stats;
+}
+
+void sim_uart_summary (void)
+{
+    fprintf (stderr,
+             "sim: uart: tx_frames=%" PRIu64 " tx_adv=%" PRIu64 " tx_bytes=%" PRIu64
+             " tx_busy=%" PRIu64 " tx_lost=%" PRIu64 " rx_bytes=%" PRIu64 "\n",
+             m_stats.tx_frames, m_stats.tx_adv, m_stats.tx_bytes, m_stats.tx_busy,
+             m_stats.tx_lost, m_stats.rx_bytes);
+
+    if (NULL != sim_options()->p_uart_link)
+    {
+        (void) unlink (sim_options()->p_uart_link);
+    }
+}
+
+/** @} */
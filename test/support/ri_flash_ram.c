@@ -0,0 +1,280 @@
+/**
+ * @file ri_flash_ram.c
+ * @date 2026-10-18
+ * @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ * RAM-backed stand-in for Ruuvi flash interface in host tests.
+ */
+#include "ri_flash_ram.h"
+#include <string.h>
+#include "ruuvi_driver_error.h"
+
+#define RI_FLASH_RAM_SIZE (RI_FLASH_RAM_PAGES * RI_FLASH_RAM_PAGE_SIZE)
+#define RI_FLASH_RAM_ALIGN(x) (((x) + 3U) & ~3U)
+
+typedef struct
+{
+    uint16_t page_id;
+    uint16_t record_id;
+    uint16_t size;
+    uint16_t valid;
+} ri_flash_ram_header_t;
+
+static uint8_t m_flash[RI_FLASH_RAM_SIZE];
+static size_t m_write_offset;
+static uint32_t m_writes;
+static uint32_t m_erases[RI_FLASH_RAM_PAGES];
+static bool m_is_init;
+
+/** @brief Write in progress, source is read on completion. */
+static struct
+{
+    bool is_pending;
+    uint16_t page_id;
+    uint16_t record_id;
+    uint16_t size;
+    const void * p_data;
+} m_pending;
+static bool m_is_gc_pending;
+
+static ri_flash_ram_header_t * header_at (const size_t offset)
+{
+    return (ri_flash_ram_header_t *) &m_flash[offset];
+}
+
+static ri_flash_ram_header_t * record_find (const uint32_t page_id,
+        const uint32_t record_id)
+{
+    ri_flash_ram_header_t * p_found = NULL;
+    size_t offset = 0;
+
+    while (offset < m_write_offset)
+    {
+        ri_flash_ram_header_t * const p_header = header_at (offset);
+
+        if (p_header->valid && (p_header->page_id == page_id)
+                && (p_header->record_id == record_id))
+        {
+            p_found = p_header;
+        }
+
+        offset += sizeof (ri_flash_ram_header_t) + RI_FLASH_RAM_ALIGN (p_header->size);
+    }
+
+    return p_found;
+}
+
+void ri_flash_ram_reset (void)
+{
+    memset (m_flash, 0xFF, sizeof (m_flash));
+    memset (m_erases, 0, sizeof (m_erases));
+    memset (&m_pending, 0, sizeof (m_pending));
+    m_is_gc_pending = false;
+    m_write_offset = 0;
+    m_writes = 0;
+    m_is_init = false;
+}
+
+static void write_complete (void)
+{
+    ri_flash_ram_header_t * const p_old = record_find (m_pending.page_id,
+                                          m_pending.record_id);
+    ri_flash_ram_header_t * const p_new = header_at (m_write_offset);
+    p_new->page_id = m_pending.page_id;
+    p_new->record_id = m_pending.record_id;
+    p_new->size = m_pending.size;
+    p_new->valid = 1U;
+    memcpy (p_new + 1, m_pending.p_data, m_pending.size);
+    m_write_offset += sizeof (ri_flash_ram_header_t) + RI_FLASH_RAM_ALIGN (m_pending.size);
+    m_writes++;
+
+    if (NULL != p_old)
+    {
+        p_old->valid = 0U;
+    }
+
+    m_pending.is_pending = false;
+}
+
+uint32_t ri_flash_ram_write_count (void)
+{
+    return m_writes;
+}
+
+uint32_t ri_flash_ram_erase_count (const uint8_t page)
+{
+    return (page < RI_FLASH_RAM_PAGES) ? m_erases[page] : 0;
+}
+
+void ri_flash_ram_corrupt (const uint32_t page_id, const uint32_t record_id)
+{
+    ri_flash_ram_header_t * const p_header = record_find (page_id, record_id);
+
+    if (NULL != p_header)
+    {
+        ((uint8_t *) (p_header + 1)) [0] ^= 0x01U;
+    }
+}
+
+rd_status_t ri_flash_init (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (m_is_init)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+
+    m_is_init = true;
+    return err_code;
+}
+
+rd_status_t ri_flash_uninit (void)
+{
+    m_is_init = false;
+    return RD_SUCCESS;
+}
+
+rd_status_t ri_flash_record_set (const uint32_t page_id, const uint32_t record_id,
+                                 const size_t data_size, const void * const data)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    const size_t needed = sizeof (ri_flash_ram_header_t) + RI_FLASH_RAM_ALIGN (data_size);
+
+    if (!m_is_init)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else if (NULL == data)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if (m_pending.is_pending || m_is_gc_pending)
+    {
+        err_code |= RD_ERROR_BUSY;
+    }
+    else if ( (m_write_offset + needed) > RI_FLASH_RAM_SIZE)
+    {
+        err_code |= RD_ERROR_NO_MEM;
+    }
+    else
+    {
+        m_pending.page_id = (uint16_t) page_id;
+        m_pending.record_id = (uint16_t) record_id;
+        m_pending.size = (uint16_t) data_size;
+        m_pending.p_data = data;
+        m_pending.is_pending = true;
+    }
+
+    return err_code;
+}
+
+rd_status_t ri_flash_record_get (const uint32_t page_id, const uint32_t record_id,
+                                 const size_t data_size, void * const data)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    const ri_flash_ram_header_t * const p_header = record_find (page_id, record_id);
+
+    if (!m_is_init)
+    {
+        err_code |= RD_ERROR_INVALID_STATE;
+    }
+    else if (NULL == data)
+    {
+        err_code |= RD_ERROR_NULL;
+    }
+    else if (NULL == p_header)
+    {
+        err_code |= RD_ERROR_NOT_FOUND;
+    }
+    else if (p_header->size > data_size)
+    {
+        err_code |= RD_ERROR_DATA_SIZE;
+    }
+    else
+    {
+        memcpy (data, p_header + 1, p_header->size);
+    }
+
+    return err_code;
+}
+
+rd_status_t ri_flash_record_delete (const uint32_t page_id, const uint32_t record_id)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    ri_flash_ram_header_t * const p_header = record_find (page_id, record_id);
+
+    if (NULL == p_header)
+    {
+        err_code |= RD_ERROR_NOT_FOUND;
+    }
+    else
+    {
+        p_header->valid = 0U;
+    }
+
+    return err_code;
+}
+
+static void gc_compact (void)
+{
+    static uint8_t compacted[RI_FLASH_RAM_SIZE];
+    size_t read_offset = 0;
+    size_t write_offset = 0;
+    memset (compacted, 0xFF, sizeof (compacted));
+
+    while (read_offset < m_write_offset)
+    {
+        const ri_flash_ram_header_t * const p_header = header_at (read_offset);
+        const size_t len = sizeof (ri_flash_ram_header_t) + RI_FLASH_RAM_ALIGN (p_header->size);
+
+        if (p_header->valid)
+        {
+            memcpy (&compacted[write_offset], p_header, len);
+            write_offset += len;
+        }
+
+        read_offset += len;
+    }
+
+    for (uint8_t page = 0; page < RI_FLASH_RAM_PAGES; page++)
+    {
+        if ( (page * RI_FLASH_RAM_PAGE_SIZE) < m_write_offset)
+        {
+            m_erases[page]++;
+        }
+    }
+
+    memcpy (m_flash, compacted, sizeof (m_flash));
+    m_write_offset = write_offset;
+}
+
+rd_status_t ri_flash_gc_run (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+
+    if (m_pending.is_pending || m_is_gc_pending)
+    {
+        err_code |= RD_ERROR_BUSY;
+    }
+    else
+    {
+        gc_compact();
+        m_is_gc_pending = true;
+    }
+
+    return err_code;
+}
+
+bool ri_flash_is_busy (void)
+{
+    const bool is_busy = m_pending.is_pending || m_is_gc_pending;
+
+    if (m_pending.is_pending)
+    {
+        write_complete();
+    }
+
+    m_is_gc_pending = false;
+    return is_busy;
+}
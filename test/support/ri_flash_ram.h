@@ -0,0 +1,37 @@
+#ifndef RI_FLASH_RAM_H
+#define RI_FLASH_RAM_H
+
+/**
+ * @file ri_flash_ram.h
+ * @date 2026-10-18
+ * @copyright Ruuvi Innovations Ltd, license BSD-3-Clause.
+ *
+ * RAM-backed stand-in for Ruuvi flash interface in host tests.
+ *
+ * Implements ruuvi_interface_flash.h as a log-structured store over
+ * RI_FLASH_RAM_PAGES pages: records are appended, old versions are
+ * invalidated and only reclaimed by ri_flash_gc_run(), which erases pages.
+ * Like FDS, a write reads its source only when it completes, which is on
+ * the first following call to ri_flash_is_busy().
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ruuvi_interface_flash.h"
+
+#define RI_FLASH_RAM_PAGES     (2U)   //!< Number of emulated pages.
+#define RI_FLASH_RAM_PAGE_SIZE (256U) //!< Bytes per emulated page.
+
+/** @brief Erase all pages, reset counters and uninitialize. */
+void ri_flash_ram_reset (void);
+
+/** @brief Number of successful record writes since reset. */
+uint32_t ri_flash_ram_write_count (void);
+
+/** @brief Number of erases of given page since reset. */
+uint32_t ri_flash_ram_erase_count (const uint8_t page);
+
+/** @brief Flip a bit in the latest copy of record to emulate corruption. */
+void ri_flash_ram_corrupt (const uint32_t page_id, const uint32_t record_id);
+
+#endif
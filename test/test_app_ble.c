@@ -1,20 +1,38 @@
 #include "unity.h"
 
 #include "app_ble.h"
+#include "app_ch_sched.h"
+#include "app_phy_sched.h"
+#include "app_stats.h"
+#include "ble_gap.h"
 #include "ruuvi_boards.h"
+#include "mock_app_flash.h"
+#include "mock_app_latency.h"
+#include "mock_app_queue.h"
+#include "mock_app_trace.h"
 #include "mock_app_uart.h"
+#include "mock_app_wdt.h"
 #include "mock_ruuvi_driver_error.h"
+#include "mock_ruuvi_interface_communication_ble_advertising.h"
 #include "mock_ruuvi_interface_communication_radio.h"
 #include "mock_ruuvi_interface_gpio.h"
 #include "mock_ruuvi_interface_log.h"
+#include "mock_ruuvi_interface_rtc.h"
 #include "mock_ruuvi_interface_scheduler.h"
-#include "mock_ruuvi_interface_watchdog.h"
+#include "mock_ruuvi_interface_timer.h"
 #include "mock_ruuvi_task_advertisement.h"
 #include "mock_ruuvi_task_led.h"
 #include <string.h>
 
 static const ri_gpio_state_t led = 17U;
 
+static const app_ble_scan_timing_t default_timing =
+{
+    .interval_ms = 1000U,
+    .window_ms = 1000U,
+    .timeout_ms = 0U
+};
+
 extern int GlobalExpectCount;
 extern int GlobalVerifyOrder;
 
@@ -22,6 +40,18 @@ void setUp (void)
 {
     ri_log_Ignore();
     rd_error_check_Ignore();
+    app_latency_on_rx_Ignore();
+    app_latency_adv_begin_Ignore();
+    app_latency_adv_end_Ignore();
+    app_queue_full_record_Ignore();
+    app_queue_sched_put_Ignore();
+    app_queue_sched_done_Ignore();
+    app_trace_record_Ignore();
+    app_wdt_arm_Ignore();
+    app_wdt_disarm_Ignore();
+    app_ch_sched_reset();
+    app_phy_sched_reset();
+    app_stats_clear();
     const ri_radio_channels_t channels =
     {
         .channel_37 = 1,
@@ -34,6 +64,7 @@ void setUp (void)
     app_ble_modulation_enable (RI_RADIO_BLE_125KBPS, false);
     app_ble_modulation_enable (RI_RADIO_BLE_1MBPS, false);
     app_ble_modulation_enable (RI_RADIO_BLE_2MBPS, false);
+    app_ble_scan_timing_set (&default_timing);
 }
 
 void tearDown (void)
@@ -336,10 +367,52 @@ void test_app_ble_on_scan_isr_received (void)
     TEST_ASSERT_EQUAL (GlobalExpectCount, GlobalVerifyOrder);
 }
 
+void test_app_ble_on_scan_isr_received_counts_phy (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    app_stats_t stats;
+    ri_adv_scan_t scan = mock_scan;
+    scan.is_coded_phy = true;
+    ri_scheduler_event_put_ExpectAndReturn (&scan, sizeof (scan), &repeat_adv,
+                                            RD_SUCCESS);
+    err_code |= on_scan_isr (RI_COMM_RECEIVED, &scan, sizeof (scan));
+    scan.is_coded_phy = false;
+    scan.secondary_phy = BLE_GAP_PHY_2MBPS;
+    ri_scheduler_event_put_ExpectAndReturn (&scan, sizeof (scan), &repeat_adv,
+                                            RD_ERROR_NO_MEM);
+    ri_adv_parse_manuid_ExpectAndReturn (scan.data, scan.data_len, RB_BLE_MANUFACTURER_ID);
+    app_uart_adv_seq_drop_Expect();
+    err_code |= on_scan_isr (RI_COMM_RECEIVED, &scan, sizeof (scan));
+    app_stats_get (&stats, false);
+    TEST_ASSERT_EQUAL (RD_ERROR_NO_MEM, err_code);
+    TEST_ASSERT_EQUAL (1, stats.counters[APP_STATS_RX_CODED]);
+    TEST_ASSERT_EQUAL (1, stats.counters[APP_STATS_RX_2M]);
+    TEST_ASSERT_EQUAL (0, stats.counters[APP_STATS_RX_1M]);
+    TEST_ASSERT_EQUAL (1, stats.counters[APP_STATS_DROP_SCHED_FULL]);
+    TEST_ASSERT_EQUAL (GlobalExpectCount, GlobalVerifyOrder);
+}
+
+void test_app_ble_on_scan_isr_sched_full_filtered_keeps_seq (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    app_stats_t stats;
+    ri_adv_scan_t scan = mock_scan;
+    ri_scheduler_event_put_ExpectAndReturn (&scan, sizeof (scan), &repeat_adv,
+                                            RD_ERROR_NO_MEM);
+    // app_uart would discard the advertisement, it takes no sequence number.
+    ri_adv_parse_manuid_ExpectAndReturn (scan.data, scan.data_len, 0x1234U);
+    err_code |= on_scan_isr (RI_COMM_RECEIVED, &scan, sizeof (scan));
+    app_stats_get (&stats, false);
+    TEST_ASSERT_EQUAL (RD_ERROR_NO_MEM, err_code);
+    TEST_ASSERT_EQUAL (1, stats.counters[APP_STATS_DROP_SCHED_FULL]);
+    TEST_ASSERT_EQUAL (GlobalExpectCount, GlobalVerifyOrder);
+}
+
 void test_app_ble_on_scan_isr_timeout (void)
 {
     app_ble_modulation_enable (RI_RADIO_BLE_1MBPS, true);
     rd_status_t err_code = RD_SUCCESS;
+    ri_rtc_millis_ExpectAndReturn (2000);
     rt_adv_uninit_ExpectAndReturn (RD_SUCCESS);
     ri_radio_uninit_ExpectAndReturn (RD_SUCCESS);
     ri_gpio_is_init_ExpectAndReturn (false);
@@ -351,11 +424,88 @@ void test_app_ble_on_scan_isr_timeout (void)
     ri_radio_init_ExpectAnyArgsAndReturn (RD_SUCCESS);
     rt_adv_init_ExpectAnyArgsAndReturn (RD_SUCCESS);
     rt_adv_scan_start_ExpectAndReturn (&on_scan_isr, RD_SUCCESS);
+    ri_rtc_millis_ExpectAndReturn (2000);
     err_code |= on_scan_isr (RI_COMM_TIMEOUT, NULL, 0);
     TEST_ASSERT_EQUAL (RD_SUCCESS, err_code);
     TEST_ASSERT_EQUAL (GlobalExpectCount, GlobalVerifyOrder);
 }
 
+void test_app_ble_on_scan_isr_timeout_resume (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    app_ble_restart_stats_t stats_before = {0};
+    app_ble_restart_stats_t stats_after = {0};
+    app_ble_modulation_enable (RI_RADIO_BLE_1MBPS, true);
+    app_ble_restart_stats_get (&stats_before);
+    // Radio is on 1M PHY with same parameters from previous scan.
+    ri_rtc_millis_ExpectAndReturn (3000);
+    rt_adv_scan_start_ExpectAndReturn (&on_scan_isr, RD_SUCCESS);
+    ri_rtc_millis_ExpectAndReturn (3001);
+    err_code |= on_scan_isr (RI_COMM_TIMEOUT, NULL, 0);
+    app_ble_restart_stats_get (&stats_after);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, err_code);
+    TEST_ASSERT_EQUAL (stats_before.fast_restarts + 1, stats_after.fast_restarts);
+    TEST_ASSERT_EQUAL (stats_before.full_restarts, stats_after.full_restarts);
+    TEST_ASSERT_EQUAL (3000, stats_after.last_restart_ms);
+    TEST_ASSERT_EQUAL (1, stats_after.last_gap_ms);
+    TEST_ASSERT_EQUAL (GlobalExpectCount, GlobalVerifyOrder);
+}
+
+void test_app_ble_scan_start_resume_error_reinitializes (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    app_ble_restart_stats_t stats_before = {0};
+    app_ble_restart_stats_t stats_after = {0};
+    app_ble_modulation_enable (RI_RADIO_BLE_1MBPS, true);
+    app_ble_restart_stats_get (&stats_before);
+    rt_adv_scan_start_ExpectAndReturn (&on_scan_isr, RD_ERROR_INVALID_STATE);
+    err_code |= app_ble_scan_start();
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_STATE, err_code);
+    // Failed resume is not a restart.
+    app_ble_restart_stats_get (&stats_after);
+    TEST_ASSERT_EQUAL (stats_before.fast_restarts, stats_after.fast_restarts);
+    rt_adv_uninit_ExpectAndReturn (RD_SUCCESS);
+    ri_radio_uninit_ExpectAndReturn (RD_SUCCESS);
+    ri_gpio_is_init_ExpectAndReturn (true);
+    ri_gpio_configure_ExpectAndReturn (RB_PA_CRX_PIN, RI_GPIO_MODE_INPUT_PULLUP, RD_SUCCESS);
+    ri_gpio_configure_ExpectAndReturn (RB_PA_CSD_PIN, RI_GPIO_MODE_OUTPUT_STANDARD,
+                                       RD_SUCCESS);
+    ri_gpio_write_ExpectAndReturn (RB_PA_CSD_PIN, RB_PA_CSD_ACTIVE, RD_SUCCESS);
+    ri_radio_init_ExpectAndReturn (RI_RADIO_BLE_1MBPS, RD_SUCCESS);
+    rt_adv_init_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    rt_adv_scan_start_ExpectAndReturn (&on_scan_isr, RD_SUCCESS);
+    err_code = app_ble_scan_start();
+    TEST_ASSERT_EQUAL (RD_SUCCESS, err_code);
+    TEST_ASSERT_EQUAL (GlobalExpectCount, GlobalVerifyOrder);
+}
+
+void test_app_ble_scan_start_phy_switch_reinitializes (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    app_ble_modulation_enable (RI_RADIO_BLE_1MBPS, true);
+    app_ble_modulation_enable (RI_RADIO_BLE_125KBPS, true);
+
+    for (size_t ii = 0; ii < 2U; ii++)
+    {
+        rt_adv_uninit_ExpectAndReturn (RD_SUCCESS);
+        ri_radio_uninit_ExpectAndReturn (RD_SUCCESS);
+        ri_gpio_is_init_ExpectAndReturn (true);
+        ri_gpio_configure_ExpectAndReturn (RB_PA_CRX_PIN, RI_GPIO_MODE_INPUT_PULLUP,
+                                           RD_SUCCESS);
+        ri_gpio_configure_ExpectAndReturn (RB_PA_CSD_PIN, RI_GPIO_MODE_OUTPUT_STANDARD,
+                                           RD_SUCCESS);
+        ri_gpio_write_ExpectAndReturn (RB_PA_CSD_PIN, RB_PA_CSD_ACTIVE, RD_SUCCESS);
+        ri_radio_init_ExpectAndReturn ( (0U == ii) ? RI_RADIO_BLE_125KBPS :
+                                        RI_RADIO_BLE_1MBPS, RD_SUCCESS);
+        rt_adv_init_ExpectAnyArgsAndReturn (RD_SUCCESS);
+        rt_adv_scan_start_ExpectAndReturn (&on_scan_isr, RD_SUCCESS);
+        err_code |= app_ble_scan_start();
+    }
+
+    TEST_ASSERT_EQUAL (RD_SUCCESS, err_code);
+    TEST_ASSERT_EQUAL (GlobalExpectCount, GlobalVerifyOrder);
+}
+
 void test_app_ble_on_scan_isr_unknown (void)
 {
     app_ble_modulation_enable (RI_RADIO_BLE_1MBPS, true);
@@ -370,7 +520,6 @@ void test_repeat_adv_ok (void)
     uint16_t timer_ms = 10000U;
     rd_status_t err_code = RD_SUCCESS;
     app_uart_send_broadcast_ExpectAndReturn (&mock_scan, RD_SUCCESS);
-    ri_watchdog_feed_ExpectAndReturn (RD_SUCCESS);
     repeat_adv (&mock_scan, mock_scan_len);
     TEST_ASSERT_EQUAL (RD_SUCCESS, err_code);
     TEST_ASSERT_EQUAL (GlobalExpectCount, GlobalVerifyOrder);
@@ -392,3 +541,340 @@ void test_repeat_adv_send_error (void)
     TEST_ASSERT_EQUAL (RD_ERROR_DATA_SIZE, err_code);
     TEST_ASSERT_EQUAL (GlobalExpectCount, GlobalVerifyOrder);
 }
+
+void test_app_ble_config_commit_unchanged (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    const ri_radio_channels_t channels =
+    {
+        .channel_37 = 1,
+        .channel_38 = 1,
+        .channel_39 = 1
+    };
+    app_ble_commit_stats_t stats_before = {0};
+    app_ble_commit_stats_t stats_after = {0};
+    app_ble_commit_stats_get (&stats_before);
+    err_code |= app_ble_config_begin();
+    err_code |= app_ble_channels_set (channels);
+    err_code |= app_ble_manufacturer_filter_set (true);
+    err_code |= app_ble_config_commit();
+    app_ble_commit_stats_get (&stats_after);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, err_code);
+    TEST_ASSERT_EQUAL (stats_before.commits + 1, stats_after.commits);
+    TEST_ASSERT_EQUAL (stats_before.restarts, stats_after.restarts);
+    TEST_ASSERT_EQUAL (GlobalExpectCount, GlobalVerifyOrder);
+}
+
+void test_app_ble_config_commit_filter_id_while_filter_disabled (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    app_ble_manufacturer_filter_set (false);
+    err_code |= app_ble_config_begin();
+    err_code |= app_ble_manufacturer_id_set (0x0101);
+    err_code |= app_ble_config_commit();
+    TEST_ASSERT_EQUAL (RD_SUCCESS, err_code);
+    TEST_ASSERT_EQUAL (GlobalExpectCount, GlobalVerifyOrder);
+}
+
+void test_app_ble_config_commit_changed (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    app_ble_commit_stats_t stats_before = {0};
+    app_ble_commit_stats_t stats_after = {0};
+    app_ble_commit_stats_get (&stats_before);
+    err_code |= app_ble_config_begin();
+    err_code |= app_ble_modulation_enable (RI_RADIO_BLE_1MBPS, true);
+    ri_rtc_millis_ExpectAndReturn (1000);
+    rt_adv_uninit_ExpectAndReturn (RD_SUCCESS);
+    ri_radio_uninit_ExpectAndReturn (RD_SUCCESS);
+    ri_gpio_is_init_ExpectAndReturn (true);
+    ri_gpio_configure_ExpectAndReturn (RB_PA_CRX_PIN, RI_GPIO_MODE_INPUT_PULLUP, RD_SUCCESS);
+    ri_gpio_configure_ExpectAndReturn (RB_PA_CSD_PIN, RI_GPIO_MODE_OUTPUT_STANDARD,
+                                       RD_SUCCESS);
+    ri_gpio_write_ExpectAndReturn (RB_PA_CSD_PIN, RB_PA_CSD_ACTIVE, RD_SUCCESS);
+    ri_radio_init_ExpectAndReturn (RI_RADIO_BLE_1MBPS, RD_SUCCESS);
+    rt_adv_init_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    rt_adv_scan_start_ExpectAndReturn (&on_scan_isr, RD_SUCCESS);
+    ri_rtc_millis_ExpectAndReturn (1012);
+    app_flash_scan_params_store_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    err_code |= app_ble_config_commit();
+    app_ble_commit_stats_get (&stats_after);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, err_code);
+    TEST_ASSERT_EQUAL (stats_before.restarts + 1, stats_after.restarts);
+    TEST_ASSERT_EQUAL (12, stats_after.last_downtime_ms);
+    TEST_ASSERT_EQUAL (GlobalExpectCount, GlobalVerifyOrder);
+}
+
+void test_app_ble_config_staged_until_commit (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    const ri_radio_channels_t channels =
+    {
+        .channel_38 = 1
+    };
+    ri_radio_channels_t get_channels;
+    err_code |= app_ble_config_begin();
+    err_code |= app_ble_channels_set (channels);
+    err_code |= app_ble_channels_get (&get_channels);
+    TEST_ASSERT (0 == get_channels.channel_37 &&
+                 1 == get_channels.channel_38 &&
+                 0 == get_channels.channel_39);
+    // No PHY enabled, scan is stopped on reconfiguration.
+    ri_rtc_millis_ExpectAndReturn (0);
+    rt_adv_scan_stop_ExpectAndReturn (RD_SUCCESS);
+    ri_rtc_millis_ExpectAndReturn (0);
+    app_flash_scan_params_store_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    err_code |= app_ble_config_commit();
+    err_code |= app_ble_channels_get (&get_channels);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, err_code);
+    TEST_ASSERT (0 == get_channels.channel_37 &&
+                 1 == get_channels.channel_38 &&
+                 0 == get_channels.channel_39);
+    TEST_ASSERT_EQUAL (GlobalExpectCount, GlobalVerifyOrder);
+}
+
+void test_app_ble_config_begin_twice (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    err_code |= app_ble_config_begin();
+    TEST_ASSERT_EQUAL (RD_SUCCESS, err_code);
+    err_code |= app_ble_config_begin();
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_STATE, err_code);
+    err_code = app_ble_config_commit();
+    TEST_ASSERT_EQUAL (RD_SUCCESS, err_code);
+}
+
+void test_app_ble_config_commit_without_begin (void)
+{
+    rd_status_t err_code = app_ble_config_commit();
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_STATE, err_code);
+}
+
+void test_app_ble_config_abort_discards_staged (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    const ri_radio_channels_t channels =
+    {
+        .channel_38 = 1
+    };
+    ri_radio_channels_t get_channels;
+    app_ble_commit_stats_t stats_before = {0};
+    app_ble_commit_stats_t stats_after = {0};
+    app_ble_commit_stats_get (&stats_before);
+    err_code |= app_ble_config_begin();
+    err_code |= app_ble_channels_set (channels);
+    // Radio is not touched.
+    err_code |= app_ble_config_abort();
+    err_code |= app_ble_channels_get (&get_channels);
+    app_ble_commit_stats_get (&stats_after);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, err_code);
+    TEST_ASSERT (1 == get_channels.channel_37 &&
+                 1 == get_channels.channel_38 &&
+                 1 == get_channels.channel_39);
+    TEST_ASSERT_EQUAL (stats_before.commits, stats_after.commits);
+    TEST_ASSERT_EQUAL (stats_before.aborts + 1, stats_after.aborts);
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_STATE, app_ble_config_abort());
+    TEST_ASSERT_EQUAL (GlobalExpectCount, GlobalVerifyOrder);
+}
+
+void test_app_ble_config_restore (void)
+{
+    app_ble_scan_t stored;
+    ri_radio_channels_t get_channels;
+    memset (&stored, 0, sizeof (stored));
+    stored.scan_channels.channel_39 = 1;
+    stored.modulation_125kbps_enabled = true;
+    app_flash_scan_params_load_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    app_flash_scan_params_load_ReturnThruPtr_p_params (&stored);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_ble_config_restore());
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_ble_channels_get (&get_channels));
+    TEST_ASSERT (0 == get_channels.channel_37 &&
+                 0 == get_channels.channel_38 &&
+                 1 == get_channels.channel_39);
+}
+
+void test_app_ble_config_restore_not_found (void)
+{
+    ri_radio_channels_t get_channels;
+    app_flash_scan_params_load_ExpectAnyArgsAndReturn (RD_ERROR_NOT_FOUND);
+    TEST_ASSERT_EQUAL (RD_ERROR_NOT_FOUND, app_ble_config_restore());
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_ble_channels_get (&get_channels));
+    TEST_ASSERT (1 == get_channels.channel_37 &&
+                 1 == get_channels.channel_38 &&
+                 1 == get_channels.channel_39);
+}
+
+void test_app_ble_scan_timing_set_invalid (void)
+{
+    app_ble_scan_timing_t timing = {.interval_ms = 1000U, .window_ms = 5U};
+    app_ble_scan_timing_t get_timing;
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_PARAM, app_ble_scan_timing_set (&timing));
+    timing.window_ms = 1001U;
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_PARAM, app_ble_scan_timing_set (&timing));
+    timing.window_ms = 500U;
+    timing.timeout_ms = 999U;
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_PARAM, app_ble_scan_timing_set (&timing));
+    TEST_ASSERT_EQUAL (RD_ERROR_NULL, app_ble_scan_timing_set (NULL));
+    app_ble_scan_timing_get (&get_timing);
+    TEST_ASSERT_EQUAL_MEMORY (&default_timing, &get_timing, sizeof (get_timing));
+}
+
+static uint32_t m_wdt_arms;
+static uint32_t m_wdt_timeout_ms;
+
+static void wdt_arm_cb (const app_wdt_src_t src, const uint32_t timeout_ms,
+                        int cmock_num_calls)
+{
+    (void) cmock_num_calls;
+
+    if (APP_WDT_SCAN == src)
+    {
+        m_wdt_arms++;
+        m_wdt_timeout_ms = timeout_ms;
+    }
+}
+
+void test_app_ble_scan_duty_cycle (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    const app_ble_scan_timing_t timing = {.interval_ms = 1000U, .window_ms = 250U};
+    app_ble_modulation_enable (RI_RADIO_BLE_1MBPS, true);
+    m_wdt_arms = 0;
+    app_wdt_arm_StubWithCallback (&wdt_arm_cb);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_ble_scan_timing_set (&timing));
+    rt_adv_uninit_ExpectAndReturn (RD_SUCCESS);
+    ri_radio_uninit_ExpectAndReturn (RD_SUCCESS);
+    ri_gpio_is_init_ExpectAndReturn (true);
+    ri_gpio_configure_ExpectAndReturn (RB_PA_CRX_PIN, RI_GPIO_MODE_INPUT_PULLUP, RD_SUCCESS);
+    ri_gpio_configure_ExpectAndReturn (RB_PA_CSD_PIN, RI_GPIO_MODE_OUTPUT_STANDARD,
+                                       RD_SUCCESS);
+    ri_gpio_write_ExpectAndReturn (RB_PA_CSD_PIN, RB_PA_CSD_ACTIVE, RD_SUCCESS);
+    ri_radio_init_ExpectAndReturn (RI_RADIO_BLE_1MBPS, RD_SUCCESS);
+    rt_adv_init_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    rt_adv_scan_start_ExpectAndReturn (&on_scan_isr, RD_SUCCESS);
+    ri_rtc_millis_ExpectAndReturn (0);
+    ri_timer_create_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_timer_start_ExpectAndReturn (NULL, 250U, NULL, RD_SUCCESS);
+    err_code |= app_ble_scan_start();
+    // Supervisor covers the whole slot, including pauses.
+    TEST_ASSERT_EQUAL (1, m_wdt_arms);
+    TEST_ASSERT_EQUAL (APP_WDT_SCAN_TIMEOUT_MS + APP_BLE_SCAN_DUTY_SLOT_MS, m_wdt_timeout_ms);
+    // End of window pauses scan for rest of interval.
+    ri_rtc_millis_ExpectAndReturn (250);
+    rt_adv_scan_stop_ExpectAndReturn (RD_SUCCESS);
+    ri_timer_create_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_timer_start_ExpectAndReturn (NULL, 750U, NULL, RD_SUCCESS);
+    on_scan_timer (NULL, 0);
+    // Next window resumes scan on initialized radio.
+    ri_rtc_millis_ExpectAndReturn (1000);
+    rt_adv_scan_start_ExpectAndReturn (&on_scan_isr, RD_SUCCESS);
+    ri_timer_create_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_timer_start_ExpectAndReturn (NULL, 250U, NULL, RD_SUCCESS);
+    on_scan_timer (NULL, 0);
+    // Pause and resume within the slot do not feed the supervisor.
+    TEST_ASSERT_EQUAL (1, m_wdt_arms);
+    ri_timer_stop_ExpectAndReturn (NULL, RD_SUCCESS);
+    rt_adv_scan_stop_ExpectAndReturn (RD_SUCCESS);
+    err_code |= app_ble_scan_stop();
+    TEST_ASSERT_EQUAL (RD_SUCCESS, err_code);
+    TEST_ASSERT_EQUAL (GlobalExpectCount, GlobalVerifyOrder);
+}
+
+static void expect_scan_init (void)
+{
+    rt_adv_uninit_ExpectAndReturn (RD_SUCCESS);
+    ri_radio_uninit_ExpectAndReturn (RD_SUCCESS);
+    ri_gpio_is_init_ExpectAndReturn (true);
+    ri_gpio_configure_ExpectAndReturn (RB_PA_CRX_PIN, RI_GPIO_MODE_INPUT_PULLUP, RD_SUCCESS);
+    ri_gpio_configure_ExpectAndReturn (RB_PA_CSD_PIN, RI_GPIO_MODE_OUTPUT_STANDARD,
+                                       RD_SUCCESS);
+    ri_gpio_write_ExpectAndReturn (RB_PA_CSD_PIN, RB_PA_CSD_ACTIVE, RD_SUCCESS);
+    ri_radio_init_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    rt_adv_init_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    rt_adv_scan_start_ExpectAndReturn (&on_scan_isr, RD_SUCCESS);
+}
+
+void test_app_ble_scan_duty_cycle_without_timeout_alternates_phy (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    const app_ble_scan_timing_t timing = {.interval_ms = 1000U, .window_ms = 250U};
+    ri_radio_modulation_t first_modulation;
+    app_ble_modulation_enable (RI_RADIO_BLE_125KBPS, true);
+    app_ble_modulation_enable (RI_RADIO_BLE_1MBPS, true);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_ble_scan_timing_set (&timing));
+    expect_scan_init();
+    ri_rtc_millis_ExpectAndReturn (0);
+    ri_timer_create_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_timer_start_ExpectAndReturn (NULL, 250U, NULL, RD_SUCCESS);
+    err_code |= app_ble_scan_start();
+    first_modulation = app_ble_modulation_get();
+    // Resumed windows restart driver timeout, application ends the slot.
+    ri_rtc_millis_ExpectAndReturn (APP_BLE_SCAN_DUTY_SLOT_MS);
+    rt_adv_scan_stop_ExpectAndReturn (RD_SUCCESS);
+    expect_scan_init();
+    ri_timer_stop_ExpectAndReturn (NULL, RD_SUCCESS);
+    ri_rtc_millis_ExpectAndReturn (APP_BLE_SCAN_DUTY_SLOT_MS);
+    ri_timer_create_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_timer_start_ExpectAndReturn (NULL, 250U, NULL, RD_SUCCESS);
+    on_scan_timer (NULL, 0);
+    TEST_ASSERT_NOT_EQUAL (first_modulation, app_ble_modulation_get());
+    ri_timer_stop_ExpectAndReturn (NULL, RD_SUCCESS);
+    rt_adv_scan_stop_ExpectAndReturn (RD_SUCCESS);
+    err_code |= app_ble_scan_stop();
+    TEST_ASSERT_EQUAL (RD_SUCCESS, err_code);
+    TEST_ASSERT_EQUAL (GlobalExpectCount, GlobalVerifyOrder);
+}
+
+void test_app_ble_scan_slot_timeout (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    const app_ble_scan_timing_t timing =
+    {
+        .interval_ms = 1000U,
+        .window_ms = 1000U,
+        .timeout_ms = 3000U
+    };
+    app_ble_modulation_enable (RI_RADIO_BLE_1MBPS, true);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_ble_scan_timing_set (&timing));
+    rt_adv_scan_start_ExpectAndReturn (&on_scan_isr, RD_SUCCESS);
+    ri_rtc_millis_ExpectAndReturn (0);
+    ri_timer_create_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_timer_start_ExpectAndReturn (NULL, 3000U, NULL, RD_SUCCESS);
+    err_code |= app_ble_scan_start();
+    // Slot ends before scan timeout of the radio driver.
+    ri_rtc_millis_ExpectAndReturn (3000);
+    rt_adv_scan_stop_ExpectAndReturn (RD_SUCCESS);
+    rt_adv_scan_start_ExpectAndReturn (&on_scan_isr, RD_SUCCESS);
+    ri_timer_stop_ExpectAndReturn (NULL, RD_SUCCESS);
+    ri_rtc_millis_ExpectAndReturn (3000);
+    ri_timer_create_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_timer_start_ExpectAndReturn (NULL, 3000U, NULL, RD_SUCCESS);
+    on_scan_timer (NULL, 0);
+    ri_timer_stop_ExpectAndReturn (NULL, RD_SUCCESS);
+    rt_adv_scan_stop_ExpectAndReturn (RD_SUCCESS);
+    err_code |= app_ble_scan_stop();
+    TEST_ASSERT_EQUAL (RD_SUCCESS, err_code);
+    TEST_ASSERT_EQUAL (GlobalExpectCount, GlobalVerifyOrder);
+}
+
+void test_app_ble_config_commit_timing_resumes_scan (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    const app_ble_scan_timing_t timing = {.interval_ms = 2000U, .window_ms = 500U};
+    app_ble_modulation_enable (RI_RADIO_BLE_1MBPS, true);
+    err_code |= app_ble_config_begin();
+    err_code |= app_ble_scan_timing_set (&timing);
+    ri_rtc_millis_ExpectAndReturn (1000);
+    rt_adv_scan_start_ExpectAndReturn (&on_scan_isr, RD_SUCCESS);
+    ri_rtc_millis_ExpectAndReturn (1000);
+    ri_timer_create_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_timer_start_ExpectAndReturn (NULL, 500U, NULL, RD_SUCCESS);
+    ri_rtc_millis_ExpectAndReturn (1001);
+    app_flash_scan_params_store_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    err_code |= app_ble_config_commit();
+    ri_timer_stop_ExpectAndReturn (NULL, RD_SUCCESS);
+    rt_adv_scan_stop_ExpectAndReturn (RD_SUCCESS);
+    err_code |= app_ble_scan_stop();
+    TEST_ASSERT_EQUAL (RD_SUCCESS, err_code);
+    TEST_ASSERT_EQUAL (GlobalExpectCount, GlobalVerifyOrder);
+}
@@ -0,0 +1,105 @@
+#include "unity.h"
+
+#include "app_capture.h"
+#include "ble_gap.h"
+#include <string.h>
+
+static ri_adv_scan_t m_scan;
+
+void setUp (void)
+{
+    const uint8_t addr[] = {0xF1U, 0xF2U, 0xF3U, 0xF4U, 0xF5U, 0xF6U};
+    memset (&m_scan, 0, sizeof (m_scan));
+    memcpy (m_scan.addr, addr, sizeof (addr));
+    m_scan.rssi = -90;
+    m_scan.is_coded_phy = true;
+    m_scan.primary_phy = BLE_GAP_PHY_CODED;
+    m_scan.secondary_phy = BLE_GAP_PHY_CODED;
+    m_scan.ch_index = 12U;
+    m_scan.tx_power = -8;
+
+    for (size_t ii = 0; ii < 40U; ii++)
+    {
+        m_scan.data[ii] = (uint8_t) ii;
+    }
+
+    m_scan.data_len = 40U;
+}
+
+void tearDown (void)
+{
+}
+
+void test_app_capture_encode_decode (void)
+{
+    uint8_t buffer[APP_CAPTURE_RECORD_MAX_LEN];
+    size_t len = sizeof (buffer);
+    ri_adv_scan_t decoded;
+    uint32_t time_ms = 0;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_capture_encode (buffer, &len, 0xA1B2C3D4U, &m_scan));
+    TEST_ASSERT_EQUAL (APP_CAPTURE_HEADER_LEN + 40U, len);
+    TEST_ASSERT_EQUAL_HEX8 (0xD4U, buffer[0]);
+    TEST_ASSERT_EQUAL_HEX8 (0xF1U, buffer[4]);
+    TEST_ASSERT_EQUAL (40U, buffer[APP_CAPTURE_DATA_LEN_IDX]);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_capture_decode (buffer, &len, &time_ms, &decoded));
+    TEST_ASSERT_EQUAL (APP_CAPTURE_HEADER_LEN + 40U, len);
+    TEST_ASSERT_EQUAL_HEX32 (0xA1B2C3D4U, time_ms);
+    TEST_ASSERT_EQUAL_MEMORY (m_scan.addr, decoded.addr, sizeof (m_scan.addr));
+    TEST_ASSERT_EQUAL (m_scan.rssi, decoded.rssi);
+    TEST_ASSERT_TRUE (decoded.is_coded_phy);
+    TEST_ASSERT_EQUAL (BLE_GAP_PHY_CODED, decoded.primary_phy);
+    TEST_ASSERT_EQUAL (BLE_GAP_PHY_CODED, decoded.secondary_phy);
+    TEST_ASSERT_EQUAL (12U, decoded.ch_index);
+    TEST_ASSERT_EQUAL (-8, decoded.tx_power);
+    TEST_ASSERT_EQUAL (40U, decoded.data_len);
+    TEST_ASSERT_EQUAL_MEMORY (m_scan.data, decoded.data, 40U);
+}
+
+void test_app_capture_encode_too_small (void)
+{
+    uint8_t buffer[APP_CAPTURE_HEADER_LEN + 39U];
+    size_t len = sizeof (buffer);
+    TEST_ASSERT_EQUAL (RD_ERROR_DATA_SIZE, app_capture_encode (buffer, &len, 0U, &m_scan));
+    TEST_ASSERT_EQUAL (sizeof (buffer), len);
+}
+
+void test_app_capture_encode_null (void)
+{
+    uint8_t buffer[APP_CAPTURE_RECORD_MAX_LEN];
+    size_t len = sizeof (buffer);
+    TEST_ASSERT_EQUAL (RD_ERROR_NULL, app_capture_encode (buffer, &len, 0U, NULL));
+    TEST_ASSERT_EQUAL (RD_ERROR_NULL, app_capture_encode (NULL, &len, 0U, &m_scan));
+}
+
+void test_app_capture_decode_incomplete (void)
+{
+    uint8_t buffer[APP_CAPTURE_RECORD_MAX_LEN];
+    size_t len = sizeof (buffer);
+    ri_adv_scan_t decoded;
+    uint32_t time_ms = 0;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_capture_encode (buffer, &len, 0U, &m_scan));
+    len = APP_CAPTURE_HEADER_LEN - 1U;
+    TEST_ASSERT_EQUAL (RD_ERROR_DATA_SIZE, app_capture_decode (buffer, &len, &time_ms,
+                       &decoded));
+    len = APP_CAPTURE_HEADER_LEN;
+    TEST_ASSERT_EQUAL (RD_ERROR_DATA_SIZE, app_capture_decode (buffer, &len, &time_ms,
+                       &decoded));
+    // Length of record is known from header.
+    TEST_ASSERT_EQUAL (APP_CAPTURE_HEADER_LEN + 40U, len);
+}
+
+void test_app_capture_decode_too_long (void)
+{
+    uint8_t buffer[APP_CAPTURE_RECORD_MAX_LEN] = {0};
+    size_t len = sizeof (buffer);
+    ri_adv_scan_t decoded;
+    uint32_t time_ms = 0;
+    buffer[APP_CAPTURE_DATA_LEN_IDX] = UINT8_MAX;
+
+    if (sizeof (decoded.data) < UINT8_MAX)
+    {
+        TEST_ASSERT_EQUAL (RD_ERROR_INVALID_LENGTH, app_capture_decode (buffer, &len,
+                           &time_ms, &decoded));
+        TEST_ASSERT_EQUAL (APP_CAPTURE_RECORD_MAX_LEN, len);
+    }
+}
@@ -0,0 +1,148 @@
+#include "unity.h"
+
+#include "app_config.h"
+#include "app_ch_sched.h"
+#include <string.h>
+
+static const app_ch_sched_cfg_t default_cfg =
+{
+    .is_adaptive = true,
+    .round_slots = 4,
+    .min_slots = 1
+};
+
+static const ri_radio_channels_t all_channels =
+{
+    .channel_37 = 1,
+    .channel_38 = 1,
+    .channel_39 = 1
+};
+
+/**
+ * @brief Run slots where each scanned channel yields given packets per full slot.
+ *
+ * @param[out] p_slots Number of slots each channel was scanned.
+ */
+static void run_slots (const uint32_t slots, const uint32_t * const p_yield,
+                       uint32_t * const p_slots)
+{
+    ri_radio_channels_t current = app_ch_sched_next_channels (all_channels);
+
+    for (uint32_t ii = 0; ii < slots; ii++)
+    {
+        const bool on[APP_CH_SCHED_NUM] =
+        {
+            current.channel_37, current.channel_38, current.channel_39
+        };
+        const uint32_t active = (uint32_t) on[0] + on[1] + on[2];
+
+        for (uint8_t ch = 0; ch < APP_CH_SCHED_NUM; ch++)
+        {
+            if (on[ch])
+            {
+                p_slots[ch]++;
+
+                for (uint32_t pkt = 0; pkt < (p_yield[ch] / active); pkt++)
+                {
+                    app_ch_sched_on_rx ( (uint8_t) (37U + ch));
+                }
+            }
+        }
+
+        current = app_ch_sched_next_channels (all_channels);
+    }
+}
+
+void setUp (void)
+{
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_ch_sched_configure (&default_cfg));
+    app_ch_sched_reset();
+}
+
+void tearDown (void)
+{
+}
+
+void test_app_ch_sched_configure_invalid (void)
+{
+    app_ch_sched_cfg_t cfg = default_cfg;
+    TEST_ASSERT_EQUAL (RD_ERROR_NULL, app_ch_sched_configure (NULL));
+    cfg.min_slots = 0;
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_PARAM, app_ch_sched_configure (&cfg));
+    cfg.min_slots = 5;
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_PARAM, app_ch_sched_configure (&cfg));
+}
+
+void test_app_ch_sched_no_yield_all_channels (void)
+{
+    const uint32_t yield[APP_CH_SCHED_NUM] = {0};
+    uint32_t slots[APP_CH_SCHED_NUM] = {0};
+    run_slots (20, yield, slots);
+    TEST_ASSERT_EQUAL (20, slots[APP_CH_SCHED_37]);
+    TEST_ASSERT_EQUAL (20, slots[APP_CH_SCHED_38]);
+    TEST_ASSERT_EQUAL (20, slots[APP_CH_SCHED_39]);
+}
+
+void test_app_ch_sched_subset_of_enabled (void)
+{
+    const ri_radio_channels_t enabled = {.channel_38 = 1};
+    app_ch_sched_on_rx (38);
+    const ri_radio_channels_t next = app_ch_sched_next_channels (enabled);
+    TEST_ASSERT_EQUAL (0, next.channel_37);
+    TEST_ASSERT_EQUAL (1, next.channel_38);
+    TEST_ASSERT_EQUAL (0, next.channel_39);
+}
+
+void test_app_ch_sched_weak_channel_less_time (void)
+{
+    const uint32_t yield[APP_CH_SCHED_NUM] = {30, 30, 3};
+    uint32_t slots[APP_CH_SCHED_NUM] = {0};
+    app_ch_sched_stats_t stats;
+    run_slots (40, yield, slots);
+    memset (slots, 0, sizeof (slots));
+    run_slots (40, yield, slots);
+    app_ch_sched_stats_get (&stats);
+    TEST_ASSERT_EQUAL (40, slots[APP_CH_SCHED_37]);
+    TEST_ASSERT_EQUAL (40, slots[APP_CH_SCHED_38]);
+    // Weak channel is kept at the minimum 1 slot of 4.
+    TEST_ASSERT_EQUAL (10, slots[APP_CH_SCHED_39]);
+    TEST_ASSERT_EQUAL (1, stats.ch[APP_CH_SCHED_39].alloc_slots);
+}
+
+void test_app_ch_sched_not_adaptive (void)
+{
+    const uint32_t yield[APP_CH_SCHED_NUM] = {30, 30, 3};
+    uint32_t slots[APP_CH_SCHED_NUM] = {0};
+    app_ch_sched_cfg_t cfg = default_cfg;
+    cfg.is_adaptive = false;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_ch_sched_configure (&cfg));
+    run_slots (40, yield, slots);
+    TEST_ASSERT_EQUAL (40, slots[APP_CH_SCHED_39]);
+}
+
+void test_app_ch_sched_secondary_channel_ignored (void)
+{
+    app_ch_sched_stats_t stats;
+    (void) app_ch_sched_next_channels (all_channels);
+    app_ch_sched_on_rx (12);
+    app_ch_sched_on_rx (40);
+    app_ch_sched_on_rx (37);
+    (void) app_ch_sched_next_channels (all_channels);
+    app_ch_sched_stats_get (&stats);
+    TEST_ASSERT_EQUAL (1, stats.ch[APP_CH_SCHED_37].packets);
+    TEST_ASSERT_EQUAL (0, stats.ch[APP_CH_SCHED_38].packets);
+    TEST_ASSERT_EQUAL (0, stats.ch[APP_CH_SCHED_39].packets);
+    // 1 packet on a third of the slot, 3 packets per full slot, averaged by 1/4.
+    TEST_ASSERT_EQUAL (12, stats.ch[APP_CH_SCHED_37].yield_x16);
+}
+
+void test_app_ch_sched_enabled_change_restarts_round (void)
+{
+    const ri_radio_channels_t two = {.channel_37 = 1, .channel_39 = 1};
+    app_ch_sched_stats_t stats;
+    (void) app_ch_sched_next_channels (all_channels);
+    (void) app_ch_sched_next_channels (two);
+    app_ch_sched_stats_get (&stats);
+    TEST_ASSERT_EQUAL (2, stats.rounds);
+    TEST_ASSERT_EQUAL (0, stats.ch[APP_CH_SCHED_38].alloc_slots);
+}
@@ -0,0 +1,196 @@
+#include "unity.h"
+
+#include "app_flash.h"
+#include "ri_flash_ram.h"
+#include <string.h>
+
+static app_ble_scan_t test_params (void)
+{
+    app_ble_scan_t params;
+    memset (&params, 0, sizeof (params));
+    params.manufacturer_id = 0x0499;
+    params.scan_channels.channel_37 = 1;
+    params.scan_channels.channel_38 = 1;
+    params.scan_channels.channel_39 = 1;
+    params.modulation_1mbit_enabled = true;
+    params.manufacturer_filter_enabled = true;
+    params.max_adv_length = 48;
+    return params;
+}
+
+/** @brief Run main loop processing until flash write has completed. */
+static void store_complete (const app_ble_scan_t * const p_params)
+{
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_flash_scan_params_store (p_params));
+
+    for (uint8_t ii = 0; (ii < 10U) && app_flash_is_busy(); ii++)
+    {
+        app_flash_process();
+    }
+
+    TEST_ASSERT_FALSE (app_flash_is_busy());
+}
+
+void setUp (void)
+{
+    ri_flash_ram_reset();
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_flash_init());
+}
+
+void tearDown (void)
+{
+}
+
+void test_app_flash_load_empty (void)
+{
+    app_ble_scan_t params = test_params();
+    rd_status_t err_code = app_flash_scan_params_load (&params);
+    TEST_ASSERT_EQUAL (RD_ERROR_NOT_FOUND, err_code);
+}
+
+void test_app_flash_load_null (void)
+{
+    TEST_ASSERT_EQUAL (RD_ERROR_NULL, app_flash_scan_params_load (NULL));
+    TEST_ASSERT_EQUAL (RD_ERROR_NULL, app_flash_scan_params_store (NULL));
+}
+
+void test_app_flash_store_load (void)
+{
+    const app_ble_scan_t stored = test_params();
+    app_ble_scan_t loaded;
+    memset (&loaded, 0, sizeof (loaded));
+    store_complete (&stored);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_flash_scan_params_load (&loaded));
+    TEST_ASSERT_EQUAL_MEMORY (&stored, &loaded, sizeof (loaded));
+}
+
+void test_app_flash_survives_reinit (void)
+{
+    const app_ble_scan_t stored = test_params();
+    app_ble_scan_t loaded;
+    memset (&loaded, 0, sizeof (loaded));
+    store_complete (&stored);
+    // Reset of the MCU keeps flash content but loses RAM state.
+    ri_flash_uninit();
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_flash_init());
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_flash_scan_params_load (&loaded));
+    TEST_ASSERT_EQUAL_MEMORY (&stored, &loaded, sizeof (loaded));
+}
+
+void test_app_flash_store_is_asynchronous (void)
+{
+    app_ble_scan_t params = test_params();
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_flash_scan_params_store (&params));
+    TEST_ASSERT_TRUE (app_flash_is_busy());
+    // Caller's parameters may change right after storing.
+    params.manufacturer_id = 0x1234;
+    app_flash_process();
+    app_flash_process();
+    TEST_ASSERT_FALSE (app_flash_is_busy());
+    TEST_ASSERT_EQUAL (1, ri_flash_ram_write_count());
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_flash_scan_params_load (&params));
+    TEST_ASSERT_EQUAL (0x0499, params.manufacturer_id);
+}
+
+void test_app_flash_store_during_write_stores_latest (void)
+{
+    app_ble_scan_t params = test_params();
+    app_ble_scan_t loaded;
+    app_flash_stats_t stats;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_flash_scan_params_store (&params));
+    params.manufacturer_id = 0x1234;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_flash_scan_params_store (&params));
+    params.manufacturer_id = 0x5678;
+    store_complete (&params);
+    app_flash_stats_get (&stats);
+    TEST_ASSERT_EQUAL (2, stats.writes);
+    TEST_ASSERT_EQUAL (2, ri_flash_ram_write_count());
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_flash_scan_params_load (&loaded));
+    TEST_ASSERT_EQUAL (0x5678, loaded.manufacturer_id);
+}
+
+void test_app_flash_store_unchanged_skips_write (void)
+{
+    app_ble_scan_t params = test_params();
+    app_flash_stats_t stats;
+    store_complete (&params);
+    // Runtime state is not stored.
+    params.is_current_modulation_125kbps = true;
+    store_complete (&params);
+    app_flash_stats_get (&stats);
+    TEST_ASSERT_EQUAL (1, ri_flash_ram_write_count());
+    TEST_ASSERT_EQUAL (1, stats.writes);
+    TEST_ASSERT_EQUAL (1, stats.skipped);
+}
+
+void test_app_flash_store_ignores_padding (void)
+{
+    app_ble_scan_t params;
+    app_flash_stats_t stats;
+    const app_ble_scan_t reference = test_params();
+    // Padding bytes of caller's copy are undefined.
+    memset (&params, 0xFF, sizeof (params));
+    params.manufacturer_id = reference.manufacturer_id;
+    params.scan_channels.channel_37 = 1;
+    params.scan_channels.channel_38 = 1;
+    params.scan_channels.channel_39 = 1;
+    params.modulation_125kbps_enabled = false;
+    params.modulation_1mbit_enabled = true;
+    params.modulation_2mbit_enabled = false;
+    params.manufacturer_filter_enabled = true;
+    params.is_current_modulation_125kbps = false;
+    params.max_adv_length = reference.max_adv_length;
+    params.timing = reference.timing;
+    store_complete (&reference);
+    store_complete (&params);
+    app_flash_stats_get (&stats);
+    TEST_ASSERT_EQUAL (1, stats.writes);
+    TEST_ASSERT_EQUAL (1, stats.skipped);
+}
+
+void test_app_flash_store_changed_writes (void)
+{
+    app_ble_scan_t params = test_params();
+    store_complete (&params);
+    params.modulation_125kbps_enabled = true;
+    store_complete (&params);
+    TEST_ASSERT_EQUAL (2, ri_flash_ram_write_count());
+}
+
+void test_app_flash_store_full_runs_gc (void)
+{
+    app_ble_scan_t params = test_params();
+    app_ble_scan_t loaded;
+    app_flash_stats_t stats;
+
+    for (uint16_t ii = 0; ii < 100U; ii++)
+    {
+        params.manufacturer_id = ii;
+        store_complete (&params);
+    }
+
+    app_flash_stats_get (&stats);
+    TEST_ASSERT_EQUAL (100, stats.writes);
+    TEST_ASSERT_EQUAL (0, stats.errors);
+
+    // Log-structured writes wear all pages, not only the first one.
+    for (uint8_t page = 0; page < RI_FLASH_RAM_PAGES; page++)
+    {
+        TEST_ASSERT_NOT_EQUAL (0, ri_flash_ram_erase_count (page));
+    }
+
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_flash_scan_params_load (&loaded));
+    TEST_ASSERT_EQUAL (99, loaded.manufacturer_id);
+}
+
+void test_app_flash_load_incompatible_version (void)
+{
+    const app_ble_scan_t stored = test_params();
+    app_ble_scan_t loaded = test_params();
+    loaded.manufacturer_id = 0x1234;
+    store_complete (&stored);
+    // First byte of the record is the version.
+    ri_flash_ram_corrupt (0xA5U, 0x01U);
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_DATA, app_flash_scan_params_load (&loaded));
+    TEST_ASSERT_EQUAL (0x1234, loaded.manufacturer_id);
+}
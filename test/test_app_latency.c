@@ -0,0 +1,113 @@
+#include "unity.h"
+
+#include "app_latency.h"
+#include "mock_ruuvi_interface_rtc.h"
+
+void setUp (void)
+{
+    app_latency_clear();
+}
+
+void tearDown (void)
+{
+}
+
+static void relay_adv (const uint64_t rx_ms, const uint64_t sent_ms)
+{
+    ri_rtc_millis_ExpectAndReturn (rx_ms);
+    app_latency_on_rx();
+    app_latency_adv_begin();
+    app_latency_on_frame_queued();
+    app_latency_adv_end();
+    ri_rtc_millis_ExpectAndReturn (sent_ms);
+    app_latency_on_frame_sent();
+}
+
+void test_app_latency_buckets (void)
+{
+    app_latency_hist_t hist;
+    relay_adv (100, 100);
+    relay_adv (100, 101);
+    relay_adv (100, 107);
+    relay_adv (100, 108);
+    relay_adv (0, 1000000);
+    app_latency_get (&hist, false);
+    TEST_ASSERT_EQUAL (5, hist.count);
+    TEST_ASSERT_EQUAL (1000000, hist.max_ms);
+    TEST_ASSERT_EQUAL (1, hist.buckets[0]);
+    TEST_ASSERT_EQUAL (1, hist.buckets[1]);
+    // 7 ms is in [4, 8), 8 ms in [8, 16).
+    TEST_ASSERT_EQUAL (1, hist.buckets[3]);
+    TEST_ASSERT_EQUAL (1, hist.buckets[4]);
+    TEST_ASSERT_EQUAL (1, hist.buckets[APP_LATENCY_BUCKETS - 1U]);
+}
+
+void test_app_latency_filtered_adv_not_recorded (void)
+{
+    app_latency_hist_t hist;
+    ri_rtc_millis_ExpectAndReturn (10);
+    app_latency_on_rx();
+    ri_rtc_millis_ExpectAndReturn (20);
+    app_latency_on_rx();
+    // First advertisement is filtered out, second is relayed.
+    app_latency_adv_begin();
+    app_latency_adv_end();
+    app_latency_adv_begin();
+    app_latency_on_frame_queued();
+    app_latency_adv_end();
+    ri_rtc_millis_ExpectAndReturn (52);
+    app_latency_on_frame_sent();
+    app_latency_get (&hist, false);
+    TEST_ASSERT_EQUAL (1, hist.count);
+    TEST_ASSERT_EQUAL (32, hist.max_ms);
+}
+
+void test_app_latency_other_frames_keep_order (void)
+{
+    app_latency_hist_t hist;
+    // Acknowledgement is queued to UART before the advertisement.
+    app_latency_on_frame_queued();
+    ri_rtc_millis_ExpectAndReturn (10);
+    app_latency_on_rx();
+    app_latency_adv_begin();
+    app_latency_on_frame_queued();
+    app_latency_adv_end();
+    app_latency_on_frame_sent();
+    ri_rtc_millis_ExpectAndReturn (14);
+    app_latency_on_frame_sent();
+    app_latency_get (&hist, false);
+    TEST_ASSERT_EQUAL (1, hist.count);
+    TEST_ASSERT_EQUAL (4, hist.max_ms);
+}
+
+void test_app_latency_reset_on_read (void)
+{
+    app_latency_hist_t hist;
+    relay_adv (0, 3);
+    app_latency_get (&hist, true);
+    TEST_ASSERT_EQUAL (1, hist.count);
+    app_latency_get (&hist, false);
+    TEST_ASSERT_EQUAL (0, hist.count);
+    TEST_ASSERT_EQUAL (0, hist.max_ms);
+}
+
+void test_app_latency_sent_without_frame (void)
+{
+    app_latency_hist_t hist;
+    app_latency_on_frame_sent();
+    app_latency_get (&hist, false);
+    TEST_ASSERT_EQUAL (0, hist.count);
+}
+
+void test_app_latency_rx_ms_get (void)
+{
+    uint32_t rx_ms = 0;
+    TEST_ASSERT_FALSE (app_latency_rx_ms_get (&rx_ms));
+    ri_rtc_millis_ExpectAndReturn (0x100000123ULL);
+    app_latency_on_rx();
+    app_latency_adv_begin();
+    TEST_ASSERT_TRUE (app_latency_rx_ms_get (&rx_ms));
+    TEST_ASSERT_EQUAL_HEX32 (0x00000123U, rx_ms);
+    app_latency_adv_end();
+    TEST_ASSERT_FALSE (app_latency_rx_ms_get (&rx_ms));
+}
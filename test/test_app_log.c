@@ -0,0 +1,95 @@
+#include "unity.h"
+
+#include "app_log.h"
+#include <string.h>
+
+static const uint8_t m_mac[APP_LOG_MAC_LEN] = {0xC5, 0x01, 0x02, 0x03, 0x04, 0xFA};
+
+void setUp (void)
+{
+    app_log_clear();
+}
+
+void tearDown (void)
+{
+}
+
+static void put_info (void)
+{
+    APP_LOG (RI_LOG_LEVEL_INFO, m_mac, NULL, 0U, "addr=%s: len=%d", 31);
+}
+
+void test_app_log_format_integers (void)
+{
+    char line[APP_LOG_LINE_MAX_LEN];
+    const int32_t args[] = {-5, 0x499, 200, 'A'};
+    size_t len = app_log_format (line, sizeof (line), "d=%d x=0x%04x u=%3u c=%c",
+                                 NULL, args, 4);
+    TEST_ASSERT_EQUAL_STRING ("d=-5 x=0x0499 u=200 c=A", line);
+    TEST_ASSERT_EQUAL (strlen (line), len);
+}
+
+void test_app_log_format_mac (void)
+{
+    char line[APP_LOG_LINE_MAX_LEN];
+    const int32_t args[] = {31};
+    app_log_format (line, sizeof (line), "addr=%s: len=%d", m_mac, args, 1);
+    TEST_ASSERT_EQUAL_STRING ("addr=c5:01:02:03:04:fa: len=31", line);
+    app_log_format (line, sizeof (line), "addr=%s: len=%d", NULL, args, 1);
+    TEST_ASSERT_EQUAL_STRING ("addr=-: len=31", line);
+}
+
+void test_app_log_format_percent_and_missing_args (void)
+{
+    char line[APP_LOG_LINE_MAX_LEN];
+    const int32_t args[] = {50};
+    app_log_format (line, sizeof (line), "%d%% of %d", NULL, args, 1);
+    TEST_ASSERT_EQUAL_STRING ("50% of 0", line);
+}
+
+void test_app_log_format_truncates (void)
+{
+    char line[8];
+    const int32_t args[] = {123456};
+    size_t len = app_log_format (line, sizeof (line), "value=%d", NULL, args, 1);
+    TEST_ASSERT_EQUAL_STRING ("value=1", line);
+    TEST_ASSERT_EQUAL (sizeof (line) - 1U, len);
+}
+
+void test_app_log_format_unsupported_conversion_ends_line (void)
+{
+    char line[APP_LOG_LINE_MAX_LEN];
+    const int32_t args[] = {1, 2};
+    app_log_format (line, sizeof (line), "a=%d b=%f c=%d", NULL, args, 2);
+    TEST_ASSERT_EQUAL_STRING ("a=1 b=", line);
+    app_log_format (line, sizeof (line), "a=%d b=%", NULL, args, 2);
+    TEST_ASSERT_EQUAL_STRING ("a=1 b=", line);
+}
+
+void test_app_log_full_buffer_drops_until_processed (void)
+{
+    uint32_t puts = 0;
+
+    while ( (0U == app_log_dropped()) && (puts < APP_LOG_BUFFER_LEN))
+    {
+        put_info();
+        puts++;
+    }
+
+    TEST_ASSERT_EQUAL (1, app_log_dropped());
+    TEST_ASSERT_GREATER_THAN (1, puts);
+    app_log_process();
+    // Buffer is empty again, drop count is kept.
+    put_info();
+    TEST_ASSERT_EQUAL (1, app_log_dropped());
+}
+
+void test_app_log_filtered_level_not_recorded (void)
+{
+    for (uint32_t ii = 0; ii < APP_LOG_BUFFER_LEN; ii++)
+    {
+        APP_LOG (RI_LOG_LEVEL_DEBUG, m_mac, m_mac, sizeof (m_mac), "len=%d", 6);
+    }
+
+    TEST_ASSERT_EQUAL (0, app_log_dropped());
+}
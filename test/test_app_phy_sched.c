@@ -0,0 +1,175 @@
+#include "unity.h"
+
+#include "app_config.h"
+#include "app_phy_sched.h"
+
+static const app_phy_sched_cfg_t default_cfg =
+{
+    .is_adaptive = true,
+    .round_slots = 8,
+    .min_slots = 1
+};
+
+static void rx_packets (const uint32_t packets)
+{
+    for (uint32_t ii = 0; ii < packets; ii++)
+    {
+        app_phy_sched_on_rx();
+    }
+}
+
+/**
+ * @brief Run slots with constant packet yield per PHY.
+ *
+ * @return Number of slots on coded PHY.
+ */
+static uint32_t run_slots (const uint32_t slots, const uint32_t yield_1m,
+                           const uint32_t yield_coded)
+{
+    bool is_coded = false;
+    uint32_t coded_slots = 0;
+
+    for (uint32_t ii = 0; ii < slots; ii++)
+    {
+        rx_packets (is_coded ? yield_coded : yield_1m);
+        app_phy_sched_slot_complete();
+        is_coded = app_phy_sched_next_is_coded (is_coded, true, true);
+        coded_slots += is_coded ? 1U : 0U;
+    }
+
+    return coded_slots;
+}
+
+void setUp (void)
+{
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_phy_sched_configure (&default_cfg));
+    app_phy_sched_reset();
+}
+
+void tearDown (void)
+{
+}
+
+void test_app_phy_sched_configure_null (void)
+{
+    TEST_ASSERT_EQUAL (RD_ERROR_NULL, app_phy_sched_configure (NULL));
+}
+
+void test_app_phy_sched_configure_invalid (void)
+{
+    app_phy_sched_cfg_t cfg = default_cfg;
+    app_phy_sched_cfg_t get_cfg;
+    cfg.min_slots = 0;
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_PARAM, app_phy_sched_configure (&cfg));
+    cfg.min_slots = 5;
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_PARAM, app_phy_sched_configure (&cfg));
+    app_phy_sched_config_get (&get_cfg);
+    TEST_ASSERT_EQUAL (default_cfg.min_slots, get_cfg.min_slots);
+}
+
+void test_app_phy_sched_single_phy (void)
+{
+    TEST_ASSERT_FALSE (app_phy_sched_next_is_coded (false, false, true));
+    TEST_ASSERT_FALSE (app_phy_sched_next_is_coded (true, false, true));
+    TEST_ASSERT_TRUE (app_phy_sched_next_is_coded (false, true, false));
+    TEST_ASSERT_TRUE (app_phy_sched_next_is_coded (true, true, false));
+}
+
+void test_app_phy_sched_no_yield_alternates (void)
+{
+    TEST_ASSERT_TRUE (app_phy_sched_next_is_coded (false, true, true));
+    TEST_ASSERT_FALSE (app_phy_sched_next_is_coded (true, true, true));
+    TEST_ASSERT_TRUE (app_phy_sched_next_is_coded (false, true, true));
+}
+
+void test_app_phy_sched_not_adaptive_alternates (void)
+{
+    app_phy_sched_cfg_t cfg = default_cfg;
+    cfg.is_adaptive = false;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_phy_sched_configure (&cfg));
+    TEST_ASSERT_EQUAL (40, run_slots (80, 20, 0));
+}
+
+void test_app_phy_sched_mostly_1m (void)
+{
+    app_phy_sched_stats_t stats;
+    // Let averages settle, then measure.
+    (void) run_slots (80, 20, 0);
+    const uint32_t coded_slots = run_slots (80, 20, 0);
+    app_phy_sched_stats_get (&stats);
+    // Coded PHY gets only the minimum 1 slot of each round of 8.
+    TEST_ASSERT_EQUAL (10, coded_slots);
+    TEST_ASSERT_EQUAL (7, stats.phy[APP_PHY_SCHED_1M].alloc_slots);
+    TEST_ASSERT_EQUAL (1, stats.phy[APP_PHY_SCHED_CODED].alloc_slots);
+}
+
+void test_app_phy_sched_mostly_coded (void)
+{
+    (void) run_slots (80, 0, 20);
+    TEST_ASSERT_EQUAL (70, run_slots (80, 0, 20));
+}
+
+void test_app_phy_sched_proportional (void)
+{
+    app_phy_sched_stats_t stats;
+    (void) run_slots (80, 30, 10);
+    const uint32_t coded_slots = run_slots (80, 30, 10);
+    app_phy_sched_stats_get (&stats);
+    TEST_ASSERT_EQUAL (6, stats.phy[APP_PHY_SCHED_1M].alloc_slots);
+    TEST_ASSERT_EQUAL (2, stats.phy[APP_PHY_SCHED_CODED].alloc_slots);
+    TEST_ASSERT_EQUAL (20, coded_slots);
+}
+
+void test_app_phy_sched_adapts_to_change (void)
+{
+    (void) run_slots (80, 20, 0);
+    // Tags switch to coded PHY, coded PHY gets the majority in a few rounds.
+    (void) run_slots (40, 0, 20);
+    TEST_ASSERT_GREATER_OR_EQUAL (60, run_slots (80, 0, 20));
+}
+
+void test_app_phy_sched_stats (void)
+{
+    app_phy_sched_stats_t stats;
+    rx_packets (3);
+    app_phy_sched_slot_complete();
+    (void) app_phy_sched_next_is_coded (false, true, true);
+    rx_packets (5);
+    app_phy_sched_slot_complete();
+    (void) app_phy_sched_next_is_coded (true, true, true);
+    app_phy_sched_stats_get (&stats);
+    TEST_ASSERT_EQUAL (1, stats.phy[APP_PHY_SCHED_1M].slots);
+    TEST_ASSERT_EQUAL (3, stats.phy[APP_PHY_SCHED_1M].packets);
+    TEST_ASSERT_EQUAL (12, stats.phy[APP_PHY_SCHED_1M].yield_x16);
+    TEST_ASSERT_EQUAL (1, stats.phy[APP_PHY_SCHED_CODED].slots);
+    TEST_ASSERT_EQUAL (5, stats.phy[APP_PHY_SCHED_CODED].packets);
+    TEST_ASSERT_EQUAL (20, stats.phy[APP_PHY_SCHED_CODED].yield_x16);
+    TEST_ASSERT_EQUAL (2, stats.switches);
+}
+
+void test_app_phy_sched_cut_slot_keeps_yield (void)
+{
+    app_phy_sched_stats_t stats;
+    rx_packets (8);
+    app_phy_sched_slot_complete();
+    (void) app_phy_sched_next_is_coded (false, false, true);
+    // Reconfiguration ends the slot right after it started.
+    rx_packets (1);
+    (void) app_phy_sched_next_is_coded (false, false, true);
+    app_phy_sched_stats_get (&stats);
+    TEST_ASSERT_EQUAL (1, stats.phy[APP_PHY_SCHED_1M].slots);
+    TEST_ASSERT_EQUAL (1, stats.phy[APP_PHY_SCHED_1M].cut_slots);
+    TEST_ASSERT_EQUAL (9, stats.phy[APP_PHY_SCHED_1M].packets);
+    TEST_ASSERT_EQUAL (32, stats.phy[APP_PHY_SCHED_1M].yield_x16);
+}
+
+void test_app_phy_sched_slot_packets_saturate (void)
+{
+    app_phy_sched_stats_t stats;
+    rx_packets (100000);
+    app_phy_sched_slot_complete();
+    (void) app_phy_sched_next_is_coded (false, false, true);
+    app_phy_sched_stats_get (&stats);
+    TEST_ASSERT_EQUAL (100000, stats.phy[APP_PHY_SCHED_1M].packets);
+    TEST_ASSERT_GREATER_THAN (0, stats.phy[APP_PHY_SCHED_1M].yield_x16);
+}
@@ -0,0 +1,85 @@
+#include "unity.h"
+
+#include "app_config.h"
+#include "app_prof.h"
+#include "mock_ruuvi_interface_scheduler.h"
+#include "mock_ruuvi_interface_timer.h"
+
+static uint32_t m_cycles;
+
+static uint32_t clock_stub (void)
+{
+    return m_cycles;
+}
+
+static void run_site (const app_prof_site_t site, const uint32_t cycles)
+{
+    app_prof_start (site);
+    m_cycles += cycles;
+    app_prof_stop (site);
+}
+
+void setUp (void)
+{
+    m_cycles = 0xFFFFFF00U;
+    app_prof_clock_set (&clock_stub);
+    app_prof_clear();
+}
+
+void tearDown (void)
+{
+    app_prof_clock_set (NULL);
+}
+
+void test_app_prof_min_avg_max (void)
+{
+    app_prof_stats_t stats[APP_PROF_NUM];
+    run_site (APP_PROF_ENCODE, 100U);
+    // Counter wraps during run.
+    run_site (APP_PROF_ENCODE, 400U);
+    run_site (APP_PROF_ENCODE, 250U);
+    app_prof_get (stats, false);
+    TEST_ASSERT_EQUAL (3, stats[APP_PROF_ENCODE].count);
+    TEST_ASSERT_EQUAL (100, stats[APP_PROF_ENCODE].min_cycles);
+    TEST_ASSERT_EQUAL (250, stats[APP_PROF_ENCODE].avg_cycles);
+    TEST_ASSERT_EQUAL (400, stats[APP_PROF_ENCODE].max_cycles);
+    TEST_ASSERT_EQUAL (0, stats[APP_PROF_PARSER].count);
+    TEST_ASSERT_EQUAL (0, stats[APP_PROF_PARSER].avg_cycles);
+}
+
+void test_app_prof_nested_sites (void)
+{
+    app_prof_stats_t stats[APP_PROF_NUM];
+    app_prof_start (APP_PROF_SEND_BROADCAST);
+    m_cycles += 10U;
+    run_site (APP_PROF_ENCODE, 30U);
+    m_cycles += 5U;
+    app_prof_stop (APP_PROF_SEND_BROADCAST);
+    app_prof_get (stats, false);
+    TEST_ASSERT_EQUAL (45, stats[APP_PROF_SEND_BROADCAST].max_cycles);
+    TEST_ASSERT_EQUAL (30, stats[APP_PROF_ENCODE].max_cycles);
+}
+
+void test_app_prof_reset_on_read (void)
+{
+    app_prof_stats_t stats[APP_PROF_NUM];
+    run_site (APP_PROF_SCAN_ISR, 500U);
+    app_prof_get (stats, true);
+    TEST_ASSERT_EQUAL (1, stats[APP_PROF_SCAN_ISR].count);
+    // Reset is visible before the site runs again.
+    app_prof_get (stats, false);
+    TEST_ASSERT_EQUAL (0, stats[APP_PROF_SCAN_ISR].count);
+    TEST_ASSERT_EQUAL (UINT32_MAX, stats[APP_PROF_SCAN_ISR].min_cycles);
+    run_site (APP_PROF_SCAN_ISR, 20U);
+    app_prof_get (stats, false);
+    TEST_ASSERT_EQUAL (1, stats[APP_PROF_SCAN_ISR].count);
+    TEST_ASSERT_EQUAL (20, stats[APP_PROF_SCAN_ISR].min_cycles);
+    TEST_ASSERT_EQUAL (20, stats[APP_PROF_SCAN_ISR].max_cycles);
+}
+
+void test_app_prof_init_starts_log_timer (void)
+{
+    ri_timer_create_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_timer_start_ExpectAndReturn (NULL, APP_PROF_LOG_INTERVAL_MS, NULL, RD_SUCCESS);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_prof_init());
+}
@@ -0,0 +1,64 @@
+#include "unity.h"
+
+#include "app_config.h"
+#include "app_queue.h"
+
+void setUp (void)
+{
+    app_queue_clear();
+}
+
+void tearDown (void)
+{
+}
+
+void test_app_queue_high_water (void)
+{
+    app_queue_stats_t stats[APP_QUEUE_NUM];
+    app_queue_level_record (APP_QUEUE_UART_RX, 20U);
+    app_queue_level_record (APP_QUEUE_UART_RX, 5U);
+    app_queue_stats_get (stats, false);
+    TEST_ASSERT_EQUAL (5, stats[APP_QUEUE_UART_RX].level);
+    TEST_ASSERT_EQUAL (20, stats[APP_QUEUE_UART_RX].high_water);
+    TEST_ASSERT_EQUAL (RI_SCHEDULER_LENGTH, stats[APP_QUEUE_SCHED].capacity);
+}
+
+void test_app_queue_sched_level (void)
+{
+    app_queue_stats_t stats[APP_QUEUE_NUM];
+    app_queue_sched_put (APP_QUEUE_SRC_SCAN);
+    app_queue_sched_put (APP_QUEUE_SRC_SCAN);
+    app_queue_sched_put (APP_QUEUE_SRC_UART);
+    app_queue_sched_done (APP_QUEUE_SRC_SCAN);
+    app_queue_sched_done (APP_QUEUE_SRC_UART);
+    app_queue_sched_done (APP_QUEUE_SRC_SCAN);
+    app_queue_stats_get (stats, false);
+    TEST_ASSERT_EQUAL (3, stats[APP_QUEUE_SCHED].high_water);
+    TEST_ASSERT_EQUAL (1, stats[APP_QUEUE_SCHED].level);
+}
+
+void test_app_queue_sched_done_without_put (void)
+{
+    app_queue_stats_t stats[APP_QUEUE_NUM];
+    app_queue_sched_done (APP_QUEUE_SRC_UART);
+    app_queue_sched_put (APP_QUEUE_SRC_UART);
+    app_queue_sched_done (APP_QUEUE_SRC_UART);
+    app_queue_stats_get (stats, false);
+    TEST_ASSERT_EQUAL (1, stats[APP_QUEUE_SCHED].high_water);
+}
+
+void test_app_queue_full_reset_on_read (void)
+{
+    app_queue_stats_t stats[APP_QUEUE_NUM];
+    app_queue_capacity_set (APP_QUEUE_UART_RX, 127U);
+    app_queue_level_record (APP_QUEUE_UART_RX, 127U);
+    app_queue_level_record (APP_QUEUE_UART_RX, 10U);
+    app_queue_full_record (APP_QUEUE_UART_RX);
+    app_queue_stats_get (stats, true);
+    TEST_ASSERT_EQUAL (127, stats[APP_QUEUE_UART_RX].capacity);
+    TEST_ASSERT_EQUAL (127, stats[APP_QUEUE_UART_RX].high_water);
+    TEST_ASSERT_EQUAL (1, stats[APP_QUEUE_UART_RX].full);
+    app_queue_stats_get (stats, false);
+    TEST_ASSERT_EQUAL (10, stats[APP_QUEUE_UART_RX].high_water);
+    TEST_ASSERT_EQUAL (0, stats[APP_QUEUE_UART_RX].full);
+}
@@ -0,0 +1,59 @@
+#include "unity.h"
+
+#include "app_stats.h"
+
+void setUp (void)
+{
+    app_stats_clear();
+}
+
+void tearDown (void)
+{
+}
+
+void test_app_stats_inc_add (void)
+{
+    app_stats_t stats;
+    app_stats_inc (APP_STATS_RX_1M);
+    app_stats_inc (APP_STATS_RX_1M);
+    app_stats_add (APP_STATS_TX_BYTES, 40U);
+    app_stats_get (&stats, false);
+    TEST_ASSERT_EQUAL (2, stats.counters[APP_STATS_RX_1M]);
+    TEST_ASSERT_EQUAL (40, stats.counters[APP_STATS_TX_BYTES]);
+    TEST_ASSERT_EQUAL (0, stats.counters[APP_STATS_RX_CODED]);
+}
+
+void test_app_stats_invalid_id (void)
+{
+    app_stats_t stats;
+    app_stats_inc (APP_STATS_NUM);
+    app_stats_get (&stats, false);
+
+    for (size_t ii = 0; ii < APP_STATS_NUM; ii++)
+    {
+        TEST_ASSERT_EQUAL (0, stats.counters[ii]);
+    }
+}
+
+void test_app_stats_reset_on_read (void)
+{
+    app_stats_t stats;
+    app_stats_add (APP_STATS_RX_FRAMES, 3U);
+    app_stats_get (&stats, true);
+    TEST_ASSERT_EQUAL (3, stats.counters[APP_STATS_RX_FRAMES]);
+    app_stats_inc (APP_STATS_RX_FRAMES);
+    app_stats_get (&stats, false);
+    TEST_ASSERT_EQUAL (1, stats.counters[APP_STATS_RX_FRAMES]);
+    app_stats_get (&stats, false);
+    TEST_ASSERT_EQUAL (1, stats.counters[APP_STATS_RX_FRAMES]);
+}
+
+void test_app_stats_wraps_across_reset (void)
+{
+    app_stats_t stats;
+    app_stats_add (APP_STATS_TX_BYTES, UINT32_MAX - 1U);
+    app_stats_get (&stats, true);
+    app_stats_add (APP_STATS_TX_BYTES, 5U);
+    app_stats_get (&stats, false);
+    TEST_ASSERT_EQUAL (5, stats.counters[APP_STATS_TX_BYTES]);
+}
@@ -0,0 +1,62 @@
+#include "unity.h"
+
+#include "app_config.h"
+#include "app_trace.h"
+#include "mock_ruuvi_interface_rtc.h"
+
+void setUp (void)
+{
+    app_trace_clear();
+}
+
+void tearDown (void)
+{
+}
+
+static void record (const uint32_t count)
+{
+    for (uint32_t ii = 0; ii < count; ii++)
+    {
+        ri_rtc_millis_ExpectAndReturn (1000U + ii);
+        app_trace_record (APP_TRACE_TX_START, 0xCAU, (uint16_t) ii);
+    }
+}
+
+void test_app_trace_empty (void)
+{
+    app_trace_event_t events[4];
+    uint32_t first = 1;
+    TEST_ASSERT_EQUAL (0, app_trace_read (0, &first, events, 4));
+    TEST_ASSERT_EQUAL (0, first);
+    TEST_ASSERT_EQUAL (0, app_trace_next_seq());
+}
+
+void test_app_trace_read_in_chunks (void)
+{
+    app_trace_event_t events[4];
+    uint32_t first = 0;
+    record (6);
+    TEST_ASSERT_EQUAL (4, app_trace_read (0, &first, events, 4));
+    TEST_ASSERT_EQUAL (0, first);
+    TEST_ASSERT_EQUAL (1000, events[0].time_ms);
+    TEST_ASSERT_EQUAL (APP_TRACE_TX_START, events[0].id);
+    TEST_ASSERT_EQUAL_HEX8 (0xCA, events[0].arg0);
+    TEST_ASSERT_EQUAL (3, events[3].arg1);
+    TEST_ASSERT_EQUAL (2, app_trace_read (first + 4U, &first, events, 4));
+    TEST_ASSERT_EQUAL (4, first);
+    TEST_ASSERT_EQUAL (5, events[1].arg1);
+    TEST_ASSERT_EQUAL (0, app_trace_read (6, &first, events, 4));
+    TEST_ASSERT_EQUAL (6, first);
+}
+
+void test_app_trace_overwritten_read_from_oldest (void)
+{
+    app_trace_event_t events[2];
+    uint32_t first = 0;
+    record (APP_TRACE_LENGTH + 3U);
+    TEST_ASSERT_EQUAL (APP_TRACE_LENGTH + 3U, app_trace_next_seq());
+    TEST_ASSERT_EQUAL (2, app_trace_read (1, &first, events, 2));
+    TEST_ASSERT_EQUAL (3, first);
+    TEST_ASSERT_EQUAL (3, events[0].arg1);
+    TEST_ASSERT_EQUAL (4, events[1].arg1);
+}
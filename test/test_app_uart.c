@@ -1,8 +1,20 @@
 #include "unity.h"
 
+#include "app_config.h"
 #include "ble_gap.h"
+#include "app_stats.h"
+#include "app_capture.h"
 #include "app_uart.h"
+#include "app_uart_ext.h"
+#include "app_uart_rx.h"
 #include "mock_app_ble.h"
+#include "mock_app_ch_sched.h"
+#include "mock_app_latency.h"
+#include "mock_app_phy_sched.h"
+#include "mock_app_prof.h"
+#include "mock_app_queue.h"
+#include "mock_app_trace.h"
+#include "mock_app_wdt.h"
 #include "ruuvi_boards.h"
 #include "mock_ruuvi_interface_communication_ble_advertising.h"
 #include "mock_ruuvi_interface_communication.h"
@@ -10,10 +22,9 @@
 #include "mock_ruuvi_driver_error.h"
 #include "mock_ruuvi_endpoint_ca_uart.h"
 #include "mock_ruuvi_interface_communication_uart.h"
+#include "mock_ruuvi_interface_rtc.h"
 #include "mock_ruuvi_interface_scheduler.h"
-#include "mock_ruuvi_interface_yield.h"
-#include "mock_ruuvi_interface_watchdog.h"
-#include "mock_ruuvi_library_ringbuffer.h"
+#include "mock_ruuvi_interface_timer.h"
 #include "mock_ruuvi_task_led.h"
 
 #include <string.h>
@@ -40,36 +51,15 @@ const uint8_t mock_mac[BLE_MAC_ADDRESS_LENGTH] = MOCK_MAC_ADDR_INIT();
 const uint8_t mock_data[] = MOCK_DATA_INIT();
 const uint16_t mock_manuf_id = 0x0499;
 
-static uint8_t t_ring_buffer[128] = {0};
-static bool t_buffer_wlock = false;
-static bool t_buffer_rlock = false;
-
 extern volatile bool m_uart_ack;
 
-static rl_ringbuffer_t t_uart_ring_buffer =
-{
-    .head = 0,
-    .tail = 0,
-    .block_size = sizeof (uint8_t),
-    .storage_size = sizeof (t_ring_buffer),
-    .index_mask = (sizeof (t_ring_buffer) / sizeof (uint8_t)) - 1,
-    .storage = t_ring_buffer,
-    .lock = app_uart_ringbuffer_lock_dummy,
-    .writelock = &t_buffer_wlock,
-    .readlock  = &t_buffer_rlock
-};
-
 static size_t mock_sends = 0;
+static ri_comm_message_t mock_sent_msg;
 // Mock sending fp for data through uart.
 static rd_status_t mock_send (ri_comm_message_t * const msg)
 {
     mock_sends++;
-    return RD_SUCCESS;
-}
-
-static rd_status_t dummy_send_success (ri_comm_message_t * const msg)
-{
-    m_uart_ack = true;
+    mock_sent_msg = *msg;
     return RD_SUCCESS;
 }
 
@@ -86,12 +76,6 @@ static ri_comm_channel_t mock_uart =
     .on_evt = app_uart_isr
 };
 
-static ri_comm_channel_t dummy_uart_success =
-{
-    .send = &dummy_send_success,
-    .on_evt = app_uart_isr
-};
-
 static ri_comm_channel_t dummy_uart_fail =
 {
     .send = &dummy_send_fail,
@@ -103,7 +87,20 @@ static ri_comm_channel_t dummy_uart_fail =
 void setUp (void)
 {
     mock_sends = 0;
+    app_stats_clear();
+    app_latency_on_frame_queued_Ignore();
+    app_latency_on_frame_sent_Ignore();
+    app_queue_capacity_set_Ignore();
+    app_queue_level_record_Ignore();
+    app_queue_full_record_Ignore();
+    app_queue_sched_put_Ignore();
+    app_queue_sched_done_Ignore();
+    app_trace_record_Ignore();
+    app_wdt_arm_Ignore();
+    app_wdt_disarm_Ignore();
+    app_wdt_checkin_Ignore();
     app_uart_init_globs();
+    ri_rtc_millis_IgnoreAndReturn (0);
 }
 
 void tearDown (void)
@@ -320,37 +317,80 @@ void test_app_uart_send_broadcast_error_size (void)
 void test_app_uart_poll_configuration_ok (void)
 {
     rd_status_t err_code = RD_SUCCESS;
-    static ri_uart_init_t config =
-    {
-        .hwfc_enabled = RB_HWFC_ENABLED,
-        .parity_enabled = RB_PARITY_ENABLED,
-        .cts  = RB_UART_CTS_PIN,
-        .rts  = RB_UART_RTS_PIN,
-        .rx   = RB_UART_RX_PIN,
-        .tx   = RB_UART_TX_PIN,
-        .baud = RI_UART_BAUD_115200 //!< XXX hardcoded, should come from board.
-    };
-    ri_uart_init_ExpectAnyArgsAndReturn (RD_SUCCESS);
-    ri_uart_init_ReturnThruPtr_channel (&dummy_uart_success);
-    ri_uart_config_ExpectWithArrayAndReturn (&config, 1, RD_SUCCESS);
-    err_code = app_uart_init();
-    TEST_ASSERT_EQUAL (RD_SUCCESS, err_code);
+    test_app_uart_init_ok();
+    ri_timer_create_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_timer_start_ExpectAndReturn (NULL, APP_UART_POLL_INTERVAL_MIN_MS, NULL, RD_SUCCESS);
     re_ca_uart_encode_ExpectAnyArgsAndReturn (RD_SUCCESS);
-    ri_scheduler_execute_ExpectAndReturn (RD_SUCCESS);
-    ri_yield_ExpectAndReturn (RD_SUCCESS);
     err_code |= app_uart_poll_configuration();
     TEST_ASSERT_EQUAL (RD_SUCCESS, err_code);
-    TEST_ASSERT_EQUAL (0, mock_sends);
+    TEST_ASSERT_EQUAL (1, mock_sends);
 }
 
 void test_app_uart_poll_configuration_encoding_error (void)
 {
     rd_status_t err_code = RD_SUCCESS;
     test_app_uart_init_ok();
+    ri_timer_create_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_timer_start_ExpectAndReturn (NULL, APP_UART_POLL_INTERVAL_MIN_MS, NULL, RD_SUCCESS);
     re_ca_uart_encode_ExpectAnyArgsAndReturn (RD_ERROR_INTERNAL);
     err_code |= app_uart_poll_configuration();
     TEST_ASSERT_EQUAL (RD_ERROR_INVALID_DATA, err_code);
     TEST_ASSERT_EQUAL (0, mock_sends);
+    // Poll is retried on timeout.
+    re_ca_uart_encode_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_timer_start_ExpectAndReturn (NULL, 2U * APP_UART_POLL_INTERVAL_MIN_MS, NULL,
+                                    RD_SUCCESS);
+    app_uart_on_evt_poll_timeout (NULL, 0);
+    TEST_ASSERT_EQUAL (1, mock_sends);
+}
+
+void test_app_uart_poll_timeout_backoff (void)
+{
+    test_app_uart_poll_configuration_ok();
+    re_ca_uart_encode_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_timer_start_ExpectAndReturn (NULL, 2U * APP_UART_POLL_INTERVAL_MIN_MS, NULL,
+                                    RD_SUCCESS);
+    app_uart_on_evt_poll_timeout (NULL, 0);
+    re_ca_uart_encode_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_timer_start_ExpectAndReturn (NULL, 4U * APP_UART_POLL_INTERVAL_MIN_MS, NULL,
+                                    RD_SUCCESS);
+    app_uart_on_evt_poll_timeout (NULL, 0);
+    TEST_ASSERT_EQUAL (3, mock_sends);
+}
+
+void test_app_uart_poll_timeout_backoff_limit (void)
+{
+    test_app_uart_poll_configuration_ok();
+
+    for (uint32_t interval = APP_UART_POLL_INTERVAL_MIN_MS;
+            interval < APP_UART_POLL_INTERVAL_MAX_MS;
+            interval *= 2U)
+    {
+        re_ca_uart_encode_ExpectAnyArgsAndReturn (RD_SUCCESS);
+        ri_timer_start_ExpectAnyArgsAndReturn (RD_SUCCESS);
+        app_uart_on_evt_poll_timeout (NULL, 0);
+    }
+
+    re_ca_uart_encode_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_timer_start_ExpectAndReturn (NULL, APP_UART_POLL_INTERVAL_MAX_MS, NULL, RD_SUCCESS);
+    app_uart_on_evt_poll_timeout (NULL, 0);
+}
+
+void test_app_uart_poll_timeout_configured (void)
+{
+    test_app_uart_poll_configuration_ok();
+    m_uart_ack = true;
+    app_uart_on_evt_poll_timeout (NULL, 0);
+    TEST_ASSERT_EQUAL (1, mock_sends);
+}
+
+void test_app_uart_boot_stats_first_adv (void)
+{
+    app_uart_boot_stats_t stats = {0};
+    test_app_uart_send_broadcast_ok_regular();
+    app_uart_boot_stats_get (&stats);
+    TEST_ASSERT_TRUE (stats.is_first_adv_sent);
+    TEST_ASSERT_FALSE (stats.is_configured);
 }
 
 /**
@@ -390,21 +430,114 @@ void test_app_uart_parser_get_device_id_ok (void)
     re_ca_uart_decode_ExpectAndReturn ((uint8_t *) &data[0],
                                        (re_ca_uart_payload_t *) &payload, RD_SUCCESS);
     re_ca_uart_decode_ReturnThruPtr_payload ((re_ca_uart_payload_t *) &expect_payload);
-    rl_ringbuffer_dequeue_ExpectAnyArgsAndReturn (RL_ERROR_NO_DATA);
     ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_device_id,
                                             RD_SUCCESS);
-    ri_watchdog_feed_IgnoreAndReturn (RD_SUCCESS);
-    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_tx_finish,
-                                            RD_SUCCESS);
     ri_radio_address_get_ExpectAnyArgsAndReturn (RD_SUCCESS);
     ri_comm_id_get_ExpectAnyArgsAndReturn (RD_SUCCESS);
     re_ca_uart_encode_ExpectAnyArgsAndReturn (RD_SUCCESS);
     app_uart_parser ((void *) &data[0], 6);
     app_uart_on_evt_send_device_id (NULL, 0);
-    app_uart_on_evt_tx_finish (NULL, 0);
     TEST_ASSERT_EQUAL (1, mock_sends);
 }
 
+static void send_adv (void)
+{
+    const ri_adv_scan_t scan =
+    {
+        .addr = MOCK_MAC_ADDR_INIT(),
+        .rssi = -50,
+        .data = MOCK_DATA_INIT(),
+        .data_len = sizeof (mock_data),
+        .primary_phy = RE_CA_UART_BLE_PHY_1MBPS,
+        .secondary_phy = RE_CA_UART_BLE_PHY_NOT_SET,
+        .ch_index = 37,
+        .tx_power = BLE_GAP_POWER_LEVEL_INVALID,
+    };
+    uint16_t manufacturer_id = 0x0499;
+    ri_adv_parse_manuid_ExpectAnyArgsAndReturn (mock_manuf_id);
+    app_ble_manufacturer_filter_enabled_ExpectAndReturn (&manufacturer_id, true);
+    re_ca_uart_encode_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_send_broadcast (&scan));
+}
+
+static int m_wdt_disarms;
+static void count_wdt_disarm (const app_wdt_src_t src, int cmock_num_calls)
+{
+    (void) cmock_num_calls;
+
+    if (APP_WDT_UART_TX == src)
+    {
+        m_wdt_disarms++;
+    }
+}
+
+void test_app_uart_ack_request_keeps_tx_supervisor_armed (void)
+{
+    m_wdt_disarms = 0;
+    app_wdt_disarm_StubWithCallback (&count_wdt_disarm);
+    test_app_uart_init_ok();
+    // Two frames in driver, first one sent.
+    send_adv();
+    send_adv();
+    app_uart_on_evt_tx_finish (NULL, 0);
+    // Ack is sent right away, sending it must not account a sent frame.
+    re_ca_uart_encode_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    app_uart_on_evt_send_ack (NULL, 0);
+    TEST_ASSERT_EQUAL (3, mock_sends);
+    app_uart_on_evt_tx_finish (NULL, 0);
+    TEST_ASSERT_EQUAL (0, m_wdt_disarms);
+    app_uart_on_evt_tx_finish (NULL, 0);
+    TEST_ASSERT_EQUAL (1, m_wdt_disarms);
+}
+
+static int m_latency_samples;
+static void count_latency_sample (int cmock_num_calls)
+{
+    (void) cmock_num_calls;
+    m_latency_samples++;
+}
+
+void test_app_uart_response_request_records_no_latency (void)
+{
+    m_latency_samples = 0;
+    app_latency_on_frame_sent_StubWithCallback (&count_latency_sample);
+    test_app_uart_init_ok();
+    send_adv();
+    send_adv();
+    app_uart_on_evt_tx_finish (NULL, 0);
+    re_ca_uart_encode_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    app_uart_on_evt_send_ack (NULL, 0);
+    TEST_ASSERT_EQUAL (1, m_latency_samples);
+}
+
+static int m_sched_done;
+static void count_sched_done (const app_queue_src_t src, int cmock_num_calls)
+{
+    (void) cmock_num_calls;
+
+    if (APP_QUEUE_SRC_UART == src)
+    {
+        m_sched_done++;
+    }
+}
+
+void test_app_uart_sched_done_only_for_put_events (void)
+{
+    int sched_puts = 0;
+    m_sched_done = 0;
+    app_queue_sched_done_StubWithCallback (&count_sched_done);
+    test_app_uart_init_ok();
+    send_adv();
+    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_tx_finish, RD_SUCCESS);
+    rd_error_check_ExpectAnyArgs();
+    app_uart_isr (RI_COMM_SENT, NULL, 0);
+    sched_puts++;
+    app_uart_on_evt_tx_finish (NULL, 0);
+    re_ca_uart_encode_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    app_uart_on_evt_send_ack (NULL, 0);
+    TEST_ASSERT_EQUAL (sched_puts, m_sched_done);
+}
+
 void test_app_uart_isr_received (void)
 {
     rd_status_t err_code = RD_SUCCESS;
@@ -624,19 +757,21 @@ void test_app_uart_parser_ok (void)
     re_ca_uart_payload_t payload = {0};
     re_ca_uart_decode_ExpectAndReturn ((uint8_t *) &data[0],
                                        (re_ca_uart_payload_t *) &payload, RD_SUCCESS);
-    rl_ringbuffer_dequeue_ExpectAnyArgsAndReturn (RL_ERROR_NO_DATA);
     ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_ack, RD_SUCCESS);
-    ri_watchdog_feed_IgnoreAndReturn (RD_SUCCESS);
-    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_tx_finish, RD_SUCCESS);
     re_ca_uart_encode_ExpectAnyArgsAndReturn (RD_SUCCESS);
     app_uart_parser ((void *) data, 8);
     app_uart_on_evt_send_ack (NULL, 0);
-    app_uart_on_evt_tx_finish (NULL, 0);
     TEST_ASSERT_EQUAL (1, mock_sends);
 }
 
-void test_app_uart_parser_clean_old (void)
+void test_app_uart_parser_stale_partial_discarded (void)
 {
+    uint8_t stale[] =
+    {
+        RE_CA_UART_STX,
+        2 + CMD_IN_LEN,
+        RE_CA_UART_SET_CH_37,
+    };
     uint8_t data[] =
     {
         RE_CA_UART_STX,
@@ -647,26 +782,17 @@ void test_app_uart_parser_clean_old (void)
         0xB6U, 0x78U, //crc
         RE_CA_UART_ETX
     };
-    uint8_t * p_data_0 = &data[0];
-    ri_scheduler_event_put_ExpectAndReturn (data, 8, &app_uart_parser,
-                                            RD_SUCCESS);
-    rd_error_check_ExpectAnyArgs();
-    app_uart_isr (RI_COMM_RECEIVED,
-                  (void *) &data[0], 8);
-    re_ca_uart_payload_t payload = {0};
-    re_ca_uart_decode_ExpectAndReturn ((uint8_t *) &data[0],
-                                       (re_ca_uart_payload_t *) &payload, RD_SUCCESS);
-    rl_ringbuffer_dequeue_ExpectAnyArgsAndReturn (RL_SUCCESS);
-    rl_ringbuffer_dequeue_ReturnMemThruPtr_data (&p_data_0, sizeof (uint8_t *));
-    rl_ringbuffer_dequeue_ExpectAnyArgsAndReturn (RL_ERROR_NO_DATA);
+    app_stats_t stats;
+    app_uart_parser ((void *) stale, sizeof (stale));
+    re_ca_uart_decode_ExpectAnyArgsAndReturn (RD_SUCCESS);
     ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_ack, RD_SUCCESS);
-    ri_watchdog_feed_IgnoreAndReturn (RD_SUCCESS);
-    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_tx_finish, RD_SUCCESS);
     re_ca_uart_encode_ExpectAnyArgsAndReturn (RD_SUCCESS);
-    app_uart_parser ((void *) data, 8);
+    app_uart_parser ((void *) data, sizeof (data));
     app_uart_on_evt_send_ack (NULL, 0);
-    app_uart_on_evt_tx_finish (NULL, 0);
     TEST_ASSERT_EQUAL (1, mock_sends);
+    TEST_ASSERT_EQUAL (0, app_uart_rx_pending());
+    app_stats_get (&stats, false);
+    TEST_ASSERT_EQUAL (1, stats.counters[APP_STATS_DECODE_ERRORS]);
 }
 
 void test_app_uart_parser_part_1_ok (void)
@@ -677,75 +803,800 @@ void test_app_uart_parser_part_1_ok (void)
         2 + CMD_IN_LEN,
         RE_CA_UART_SET_CH_37,
     };
-    uint8_t * p_data_0 = &data_part1[0];
-    uint8_t * p_data_1 = &data_part1[1];
-    uint8_t * p_data_2 = &data_part1[2];
     ri_scheduler_event_put_ExpectAndReturn (data_part1, 3, &app_uart_parser,
                                             RD_SUCCESS);
     rd_error_check_ExpectAnyArgs();
     app_uart_isr (RI_COMM_RECEIVED,
                   (void *) &data_part1[0], 3);
-    re_ca_uart_payload_t payload = {0};
-    re_ca_uart_decode_ExpectAndReturn ((uint8_t *) &data_part1[0],
-                                       (re_ca_uart_payload_t *) &payload, RE_ERROR_DECODING_CRC);
-    rl_ringbuffer_queue_ExpectAnyArgsAndReturn (RL_SUCCESS);
-    rl_ringbuffer_queue_ExpectAnyArgsAndReturn (RL_SUCCESS);
-    rl_ringbuffer_queue_ExpectAnyArgsAndReturn (RL_SUCCESS);
-    rl_ringbuffer_dequeue_ExpectAnyArgsAndReturn (RL_SUCCESS);
-    rl_ringbuffer_dequeue_ReturnMemThruPtr_data (&p_data_0, sizeof (uint8_t *));
-    rl_ringbuffer_dequeue_ExpectAnyArgsAndReturn (RL_SUCCESS);
-    rl_ringbuffer_dequeue_ReturnMemThruPtr_data (&p_data_1, sizeof (uint8_t *));
-    rl_ringbuffer_dequeue_ExpectAnyArgsAndReturn (RL_SUCCESS);
-    rl_ringbuffer_dequeue_ReturnMemThruPtr_data (&p_data_2, sizeof (uint8_t *));
-    rl_ringbuffer_dequeue_ExpectAnyArgsAndReturn (RL_ERROR_NO_DATA);
-    re_ca_uart_decode_ExpectAnyArgsAndReturn (RE_ERROR_DECODING_CRC);
-    rl_ringbuffer_queue_ExpectAnyArgsAndReturn (RL_SUCCESS);
-    rl_ringbuffer_queue_ExpectAnyArgsAndReturn (RL_SUCCESS);
-    rl_ringbuffer_queue_ExpectAnyArgsAndReturn (RL_SUCCESS);
-    ri_watchdog_feed_IgnoreAndReturn (RD_SUCCESS);
+    // Incomplete frame is kept without decoding.
     app_uart_parser ((void *) data_part1, 3);
+    TEST_ASSERT_EQUAL (3, app_uart_rx_pending());
     TEST_ASSERT_EQUAL (0, mock_sends);
 }
 
 void test_app_uart_parser_part_2_ok (void)
 {
     uint8_t data_part1[] =
+    {
+        RE_CA_UART_STX,
+        2 + CMD_IN_LEN,
+        RE_CA_UART_SET_CH_37,
+    };
+    uint8_t data_part2[] =
     {
         0x01U,
         RE_CA_UART_FIELD_DELIMITER,
         0xB6U, 0x78U, //crc
         RE_CA_UART_ETX
     };
-    ri_scheduler_event_put_ExpectAndReturn (data_part1, 5, &app_uart_parser,
+    ri_scheduler_event_put_ExpectAndReturn (data_part2, 5, &app_uart_parser,
                                             RD_SUCCESS);
     rd_error_check_ExpectAnyArgs();
     app_uart_isr (RI_COMM_RECEIVED,
-                  (void *) &data_part1[0], sizeof (data_part1));
-    re_ca_uart_payload_t payload = {0};
-    re_ca_uart_decode_ExpectAndReturn ((uint8_t *) &data_part1[0],
-                                       (re_ca_uart_payload_t *) &payload, RE_ERROR_DECODING_CRC);
+                  (void *) &data_part2[0], sizeof (data_part2));
+    app_uart_parser ((void *) data_part1, sizeof (data_part1));
+    re_ca_uart_decode_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_ack, RD_SUCCESS);
+    re_ca_uart_encode_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    app_uart_parser ((void *) data_part2, sizeof (data_part2));
+    app_uart_on_evt_send_ack (NULL, 0);
+    TEST_ASSERT_EQUAL (1, mock_sends);
+    TEST_ASSERT_EQUAL (0, app_uart_rx_pending());
+}
+
+void test_app_uart_parser_two_frames_in_one_read (void)
+{
+    uint8_t data[] =
+    {
+        RE_CA_UART_STX, 0 + CMD_IN_LEN, RE_CA_UART_GET_DEVICE_ID, 0x36U, 0x8EU, RE_CA_UART_ETX,
+        RE_CA_UART_STX, 0 + CMD_IN_LEN, RE_CA_UART_GET_DEVICE_ID, 0x36U, 0x8EU, RE_CA_UART_ETX
+    };
+    re_ca_uart_payload_t expect_payload = {.cmd = RE_CA_UART_GET_DEVICE_ID};
 
-    for (size_t ii = 0; ii < sizeof (data_part1); ii++)
+    for (size_t ii = 0; ii < 2U; ii++)
     {
-        rl_ringbuffer_queue_ExpectAnyArgsAndReturn (RL_SUCCESS);
+        re_ca_uart_decode_ExpectAnyArgsAndReturn (RD_SUCCESS);
+        re_ca_uart_decode_ReturnThruPtr_payload (&expect_payload);
+        ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_device_id,
+                                                RD_SUCCESS);
     }
 
-    rl_ringbuffer_dequeue_ExpectAnyArgsAndReturn (RL_SUCCESS);
-    rl_ringbuffer_dequeue_ExpectAnyArgsAndReturn (RL_SUCCESS);
-    rl_ringbuffer_dequeue_ExpectAnyArgsAndReturn (RL_SUCCESS);
-    rl_ringbuffer_dequeue_ExpectAnyArgsAndReturn (RL_SUCCESS);
-    rl_ringbuffer_dequeue_ExpectAnyArgsAndReturn (RL_SUCCESS);
-    rl_ringbuffer_dequeue_ExpectAnyArgsAndReturn (RL_SUCCESS);
-    rl_ringbuffer_dequeue_ExpectAnyArgsAndReturn (RL_SUCCESS);
-    rl_ringbuffer_dequeue_ExpectAnyArgsAndReturn (RL_SUCCESS);
-    rl_ringbuffer_dequeue_ExpectAnyArgsAndReturn (RL_ERROR_NO_DATA);
+    app_uart_parser ((void *) data, sizeof (data));
+}
+
+void test_app_uart_on_frame_invalid (void)
+{
+    uint8_t data[] =
+    {
+        RE_CA_UART_STX, 0 + CMD_IN_LEN, RE_CA_UART_GET_DEVICE_ID, 0x00U, 0x00U, RE_CA_UART_ETX
+    };
+    re_ca_uart_decode_ExpectAnyArgsAndReturn (RE_ERROR_DECODING_CRC);
+    TEST_ASSERT_FALSE (app_uart_on_frame (data, sizeof (data)));
+}
+
+void test_app_uart_parser_set_all_commits_once (void)
+{
+    uint8_t data[] =
+    {
+        RE_CA_UART_STX, 0 + CMD_IN_LEN, RE_CA_UART_SET_ALL, 0x00U, 0x00U, RE_CA_UART_ETX
+    };
+    re_ca_uart_payload_t expect_payload =
+    {
+        .cmd = RE_CA_UART_SET_ALL,
+        .params.all_params.fltr_id.id = 0x0499,
+        .params.all_params.bools.fltr_tags.state = 1,
+        .params.all_params.bools.use_1m_phy.state = 1,
+        .params.all_params.bools.ch_37.state = 1,
+        .params.all_params.bools.ch_38.state = 1,
+        .params.all_params.bools.ch_39.state = 1,
+    };
+    re_ca_uart_decode_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    re_ca_uart_decode_ReturnThruPtr_payload (&expect_payload);
+    app_ble_config_begin_ExpectAndReturn (RD_SUCCESS);
+    app_ble_manufacturer_id_set_ExpectAndReturn (0x0499, RD_SUCCESS);
+    app_ble_manufacturer_filter_set_ExpectAndReturn (true, RD_SUCCESS);
+    app_ble_set_max_adv_len_Expect (0);
+    app_ble_channels_set_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    app_ble_modulation_enable_ExpectAndReturn (RI_RADIO_BLE_125KBPS, false, RD_SUCCESS);
+    app_ble_modulation_enable_ExpectAndReturn (RI_RADIO_BLE_1MBPS, true, RD_SUCCESS);
+    app_ble_modulation_enable_ExpectAndReturn (RI_RADIO_BLE_2MBPS, false, RD_SUCCESS);
+    app_ble_config_commit_ExpectAndReturn (RD_SUCCESS);
+    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_ack, RD_SUCCESS);
+    app_uart_parser ((void *) data, sizeof (data));
+    TEST_ASSERT_TRUE (m_uart_ack);
+}
+
+static uint8_t m_ack_state;
+
+static re_status_t capture_ack_state (uint8_t * const buffer, uint8_t * const buf_len,
+                                      const re_ca_uart_payload_t * const payload,
+                                      int cmock_num_calls)
+{
+    (void) buffer;
+    (void) buf_len;
+    (void) cmock_num_calls;
+    m_ack_state = payload->params.ack.ack_state.state;
+    return RE_SUCCESS;
+}
+
+static const re_ca_uart_payload_t m_set_all_payload = {.cmd = RE_CA_UART_SET_ALL};
+
+static void set_all_expect_apply (const rd_status_t apply_status)
+{
     re_ca_uart_decode_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    re_ca_uart_decode_ReturnThruPtr_payload ((re_ca_uart_payload_t *) &m_set_all_payload);
+    app_ble_config_begin_ExpectAndReturn (RD_SUCCESS);
+    app_ble_manufacturer_id_set_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    app_ble_manufacturer_filter_set_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    app_ble_set_max_adv_len_ExpectAnyArgs();
+    app_ble_channels_set_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    app_ble_modulation_enable_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    app_ble_modulation_enable_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    app_ble_modulation_enable_ExpectAnyArgsAndReturn (apply_status);
     ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_ack, RD_SUCCESS);
-    ri_watchdog_feed_IgnoreAndReturn (RD_SUCCESS);
-    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_tx_finish, RD_SUCCESS);
-    re_ca_uart_encode_ExpectAnyArgsAndReturn (RD_SUCCESS);
-    app_uart_parser ((void *) data_part1, 5);
+}
+
+static void set_all_parse_and_ack (void)
+{
+    uint8_t data[] =
+    {
+        RE_CA_UART_STX, 0 + CMD_IN_LEN, RE_CA_UART_SET_ALL, 0x00U, 0x00U, RE_CA_UART_ETX
+    };
+    m_ack_state = RE_CA_ACK_OK;
+    app_uart_parser ((void *) data, sizeof (data));
+    re_ca_uart_encode_StubWithCallback (&capture_ack_state);
     app_uart_on_evt_send_ack (NULL, 0);
-    app_uart_on_evt_tx_finish (NULL, 0);
+}
+
+void test_app_uart_parser_set_all_apply_error_aborts (void)
+{
+    test_app_uart_init_ok();
+    set_all_expect_apply (RD_ERROR_INVALID_PARAM);
+    app_ble_config_abort_ExpectAndReturn (RD_SUCCESS);
+    set_all_parse_and_ack();
+    TEST_ASSERT_EQUAL (RE_CA_ACK_ERROR, m_ack_state);
+    // Configuration is polled again.
+    TEST_ASSERT_FALSE (m_uart_ack);
+}
+
+void test_app_uart_parser_set_all_commit_error_nacked (void)
+{
+    test_app_uart_init_ok();
+    set_all_expect_apply (RD_SUCCESS);
+    app_ble_config_commit_ExpectAndReturn (RD_ERROR_INTERNAL);
+    set_all_parse_and_ack();
+    TEST_ASSERT_EQUAL (RE_CA_ACK_ERROR, m_ack_state);
+    TEST_ASSERT_FALSE (m_uart_ack);
+}
+
+void test_app_uart_parser_set_all_begin_error_nacked (void)
+{
+    test_app_uart_init_ok();
+    re_ca_uart_decode_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    re_ca_uart_decode_ReturnThruPtr_payload ((re_ca_uart_payload_t *) &m_set_all_payload);
+    app_ble_config_begin_ExpectAndReturn (RD_ERROR_INVALID_STATE);
+    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_ack, RD_SUCCESS);
+    set_all_parse_and_ack();
+    TEST_ASSERT_EQUAL (RE_CA_ACK_ERROR, m_ack_state);
+}
+
+static void ext_request (const uint8_t cmd, const uint8_t * const p_payload,
+                         const uint8_t len, uint8_t * const p_buffer, uint8_t * const p_len)
+{
+    app_uart_ext_frame_t frame = {.cmd = cmd, .len = len};
+    memcpy (frame.payload, p_payload, len);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_ext_encode (p_buffer, p_len, &frame));
+}
+
+static void ext_response_expect_sent (const uint8_t cmd, app_uart_ext_frame_t * const p_resp)
+{
+    app_uart_on_evt_send_ext (NULL, 0);
+    TEST_ASSERT_EQUAL (1, mock_sends);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_ext_decode (mock_sent_msg.data,
+                       mock_sent_msg.data_length, p_resp));
+    TEST_ASSERT_EQUAL (cmd, p_resp->cmd);
+}
+
+void test_app_uart_parser_ext_get_scan_stats (void)
+{
+    uint8_t data[16];
+    uint8_t len = sizeof (data);
+    app_uart_ext_frame_t resp;
+    app_phy_sched_stats_t phy_stats = {0};
+    app_ch_sched_stats_t ch_stats = {0};
+    phy_stats.phy[APP_PHY_SCHED_CODED].packets = 0x01020304U;
+    ch_stats.ch[APP_CH_SCHED_39].alloc_slots = 3U;
+    ch_stats.rounds = 7U;
+    test_app_uart_init_ok();
+    ext_request (APP_UART_EXT_GET_SCAN_STATS, NULL, 0, data, &len);
+    app_phy_sched_stats_get_ExpectAnyArgs();
+    app_phy_sched_stats_get_ReturnThruPtr_p_stats (&phy_stats);
+    app_ch_sched_stats_get_ExpectAnyArgs();
+    app_ch_sched_stats_get_ReturnThruPtr_p_stats (&ch_stats);
+    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_ext,
+                                            RD_SUCCESS);
+    app_uart_parser (data, len);
+    ext_response_expect_sent (APP_UART_EXT_GET_SCAN_STATS, &resp);
+    TEST_ASSERT_EQUAL (63, resp.len);
+    // Coded PHY packets after 1M PHY stats and coded PHY slots, little-endian.
+    TEST_ASSERT_EQUAL_HEX8 (0x04, resp.payload[15]);
+    TEST_ASSERT_EQUAL_HEX8 (0x01, resp.payload[18]);
+    // Channel 39 allocation is the last byte before rounds.
+    TEST_ASSERT_EQUAL (3, resp.payload[58]);
+    TEST_ASSERT_EQUAL (7, resp.payload[59]);
+}
+
+void test_app_uart_parser_ext_set_scan_sched (void)
+{
+    const uint8_t payload[] = {1, 8, 1, 1, 4, 1};
+    uint8_t data[16];
+    uint8_t len = sizeof (data);
+    app_uart_ext_frame_t resp;
+    test_app_uart_init_ok();
+    ext_request (APP_UART_EXT_SET_SCAN_SCHED, payload, sizeof (payload), data, &len);
+    app_phy_sched_config_get_ExpectAnyArgs();
+    app_phy_sched_configure_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    app_ch_sched_configure_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_ext,
+                                            RD_SUCCESS);
+    app_uart_parser (data, len);
+    ext_response_expect_sent (APP_UART_EXT_SET_SCAN_SCHED, &resp);
+    TEST_ASSERT_EQUAL (1, resp.len);
+    TEST_ASSERT_EQUAL (0, resp.payload[0]);
+}
+
+void test_app_uart_parser_ext_set_scan_sched_invalid_reverts (void)
+{
+    const uint8_t payload[] = {1, 8, 1, 1, 0, 1};
+    uint8_t data[16];
+    uint8_t len = sizeof (data);
+    app_uart_ext_frame_t resp;
+    test_app_uart_init_ok();
+    ext_request (APP_UART_EXT_SET_SCAN_SCHED, payload, sizeof (payload), data, &len);
+    app_phy_sched_config_get_ExpectAnyArgs();
+    app_phy_sched_configure_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    app_ch_sched_configure_ExpectAnyArgsAndReturn (RD_ERROR_INVALID_PARAM);
+    app_phy_sched_configure_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_ext,
+                                            RD_SUCCESS);
+    app_uart_parser (data, len);
+    ext_response_expect_sent (APP_UART_EXT_SET_SCAN_SCHED, &resp);
+    TEST_ASSERT_EQUAL (1, resp.payload[0]);
+}
+
+void test_app_uart_parser_ext_set_scan_sched_short (void)
+{
+    const uint8_t payload[] = {1, 8, 1};
+    uint8_t data[16];
+    uint8_t len = sizeof (data);
+    app_uart_ext_frame_t resp;
+    test_app_uart_init_ok();
+    ext_request (APP_UART_EXT_SET_SCAN_SCHED, payload, sizeof (payload), data, &len);
+    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_ext,
+                                            RD_SUCCESS);
+    app_uart_parser (data, len);
+    ext_response_expect_sent (APP_UART_EXT_SET_SCAN_SCHED, &resp);
+    TEST_ASSERT_EQUAL (1, resp.payload[0]);
+}
+
+void test_app_uart_parser_ext_set_scan_timing (void)
+{
+    // Interval 1000 ms, window 250 ms, slot 10000 ms.
+    const uint8_t payload[] = {0xE8, 0x03, 0xFA, 0x00, 0x10, 0x27, 0x00, 0x00};
+    const app_ble_scan_timing_t timing =
+    {
+        .interval_ms = 1000U,
+        .window_ms = 250U,
+        .timeout_ms = 10000U
+    };
+    uint8_t data[16];
+    uint8_t len = sizeof (data);
+    app_uart_ext_frame_t resp;
+    test_app_uart_init_ok();
+    ext_request (APP_UART_EXT_SET_SCAN_TIMING, payload, sizeof (payload), data, &len);
+    app_ble_config_begin_ExpectAndReturn (RD_SUCCESS);
+    app_ble_scan_timing_set_ExpectWithArrayAndReturn (&timing, 1, RD_SUCCESS);
+    app_ble_config_commit_ExpectAndReturn (RD_SUCCESS);
+    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_ext,
+                                            RD_SUCCESS);
+    app_uart_parser (data, len);
+    ext_response_expect_sent (APP_UART_EXT_SET_SCAN_TIMING, &resp);
+    TEST_ASSERT_EQUAL (1, resp.len);
+    TEST_ASSERT_EQUAL (0, resp.payload[0]);
+}
+
+void test_app_uart_parser_ext_set_scan_timing_invalid (void)
+{
+    const uint8_t payload[] = {0xE8, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    uint8_t data[16];
+    uint8_t len = sizeof (data);
+    app_uart_ext_frame_t resp;
+    test_app_uart_init_ok();
+    ext_request (APP_UART_EXT_SET_SCAN_TIMING, payload, sizeof (payload), data, &len);
+    app_ble_config_begin_ExpectAndReturn (RD_SUCCESS);
+    app_ble_scan_timing_set_ExpectAnyArgsAndReturn (RD_ERROR_INVALID_PARAM);
+    app_ble_config_abort_ExpectAndReturn (RD_SUCCESS);
+    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_ext,
+                                            RD_SUCCESS);
+    app_uart_parser (data, len);
+    ext_response_expect_sent (APP_UART_EXT_SET_SCAN_TIMING, &resp);
+    TEST_ASSERT_EQUAL (1, resp.payload[0]);
+}
+
+void test_app_uart_parser_ext_get_stats_reset (void)
+{
+    const uint8_t payload[] = {APP_UART_EXT_STATS_FLAG_RESET};
+    uint8_t data[16];
+    uint8_t len = sizeof (data);
+    app_uart_ext_frame_t resp;
+    app_stats_t stats;
+    test_app_uart_init_ok();
+    app_stats_add (APP_STATS_RX_CODED, 0x0102U);
+    ext_request (APP_UART_EXT_GET_STATS, payload, sizeof (payload), data, &len);
+    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_ext,
+                                            RD_SUCCESS);
+    app_uart_parser (data, len);
+    ext_response_expect_sent (APP_UART_EXT_GET_STATS, &resp);
+    TEST_ASSERT_EQUAL (1U + (4U * APP_STATS_NUM), resp.len);
+    TEST_ASSERT_EQUAL (APP_STATS_NUM, resp.payload[0]);
+    TEST_ASSERT_EQUAL_HEX32 (0x0102U, app_uart_ext_get_u32 (&resp,
+                             1U + (4U * APP_STATS_RX_CODED)));
+    // The request itself was counted before read.
+    TEST_ASSERT_EQUAL (1, app_uart_ext_get_u32 (&resp, 1U + (4U * APP_STATS_RX_FRAMES)));
+    // Only the response was sent after reset.
+    app_stats_get (&stats, false);
+    TEST_ASSERT_EQUAL (0, stats.counters[APP_STATS_RX_CODED]);
+    TEST_ASSERT_EQUAL (0, stats.counters[APP_STATS_RX_FRAMES]);
+    TEST_ASSERT_EQUAL (1, stats.counters[APP_STATS_TX_FRAMES]);
+    TEST_ASSERT_EQUAL (resp.len + APP_UART_EXT_OVERHEAD, stats.counters[APP_STATS_TX_BYTES]);
+}
+
+void test_app_uart_parser_ext_get_latency (void)
+{
+    const uint8_t payload[] = {APP_UART_EXT_STATS_FLAG_RESET};
+    uint8_t data[16];
+    uint8_t len = sizeof (data);
+    app_uart_ext_frame_t resp;
+    app_latency_hist_t hist = {.count = 3, .max_ms = 40};
+    hist.buckets[APP_LATENCY_BUCKETS - 1U] = 0x0A0B0C0DU;
+    test_app_uart_init_ok();
+    ext_request (APP_UART_EXT_GET_LATENCY, payload, sizeof (payload), data, &len);
+    app_latency_get_ExpectAnyArgs();
+    app_latency_get_ReturnThruPtr_p_hist (&hist);
+    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_ext,
+                                            RD_SUCCESS);
+    app_uart_parser (data, len);
+    ext_response_expect_sent (APP_UART_EXT_GET_LATENCY, &resp);
+    TEST_ASSERT_EQUAL (13U + (4U * APP_LATENCY_BUCKETS), resp.len);
+    TEST_ASSERT_EQUAL (APP_LATENCY_BUCKETS, resp.payload[0]);
+    TEST_ASSERT_EQUAL (3, app_uart_ext_get_u32 (&resp, 1U));
+    TEST_ASSERT_EQUAL (40, app_uart_ext_get_u32 (&resp, 5U));
+    TEST_ASSERT_EQUAL_HEX32 (0x0A0B0C0DU, app_uart_ext_get_u32 (&resp,
+                             resp.len - 4U));
+}
+
+void test_app_uart_parser_ext_get_queues (void)
+{
+    uint8_t data[16];
+    uint8_t len = sizeof (data);
+    app_uart_ext_frame_t resp;
+    app_queue_stats_t stats[APP_QUEUE_NUM] = {0};
+    stats[APP_QUEUE_SCHED].capacity = RI_SCHEDULER_LENGTH;
+    stats[APP_QUEUE_SCHED].high_water = 7U;
+    stats[APP_QUEUE_UART_TX].full = 2U;
+    test_app_uart_init_ok();
+    ext_request (APP_UART_EXT_GET_QUEUES, NULL, 0, data, &len);
+    app_queue_stats_get_ExpectAnyArgs();
+    app_queue_stats_get_ReturnArrayThruPtr_p_stats (stats, APP_QUEUE_NUM);
+    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_ext,
+                                            RD_SUCCESS);
+    app_uart_parser (data, len);
+    ext_response_expect_sent (APP_UART_EXT_GET_QUEUES, &resp);
+    TEST_ASSERT_EQUAL (1U + (8U * APP_QUEUE_NUM), resp.len);
+    TEST_ASSERT_EQUAL (APP_QUEUE_NUM, resp.payload[0]);
+    TEST_ASSERT_EQUAL (RI_SCHEDULER_LENGTH, app_uart_ext_get_u16 (&resp, 1U));
+    TEST_ASSERT_EQUAL (7, app_uart_ext_get_u16 (&resp, 3U));
+    TEST_ASSERT_EQUAL (2, app_uart_ext_get_u32 (&resp, 1U + (8U * APP_QUEUE_UART_TX) + 4U));
+}
+
+void test_app_uart_parser_ext_get_commit_stats (void)
+{
+    uint8_t data[16];
+    uint8_t len = sizeof (data);
+    app_uart_ext_frame_t resp;
+    app_ble_commit_stats_t stats =
+    {
+        .commits = 4U,
+        .aborts = 1U,
+        .restarts = 2U,
+        .last_downtime_ms = 3U,
+        .max_downtime_ms = 5U,
+        .total_downtime_ms = 8U
+    };
+    test_app_uart_init_ok();
+    ext_request (APP_UART_EXT_GET_COMMIT_STATS, NULL, 0, data, &len);
+    app_ble_commit_stats_get_ExpectAnyArgs();
+    app_ble_commit_stats_get_ReturnThruPtr_p_stats (&stats);
+    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_ext,
+                                            RD_SUCCESS);
+    app_uart_parser (data, len);
+    ext_response_expect_sent (APP_UART_EXT_GET_COMMIT_STATS, &resp);
+    TEST_ASSERT_EQUAL (24, resp.len);
+    TEST_ASSERT_EQUAL (4, app_uart_ext_get_u32 (&resp, 0U));
+    TEST_ASSERT_EQUAL (1, app_uart_ext_get_u32 (&resp, 4U));
+    TEST_ASSERT_EQUAL (2, app_uart_ext_get_u32 (&resp, 8U));
+    TEST_ASSERT_EQUAL (8, app_uart_ext_get_u32 (&resp, 20U));
+}
+
+void test_app_uart_parser_ext_set_adv_timestamp (void)
+{
+    const uint8_t payload[] = {1};
+    uint8_t data[16];
+    uint8_t len = sizeof (data);
+    app_uart_ext_frame_t resp;
+    test_app_uart_init_ok();
+    ext_request (APP_UART_EXT_SET_ADV_TIMESTAMP, payload, sizeof (payload), data, &len);
+    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_ext,
+                                            RD_SUCCESS);
+    app_uart_parser (data, len);
+    ext_response_expect_sent (APP_UART_EXT_SET_ADV_TIMESTAMP, &resp);
+    TEST_ASSERT_EQUAL (1, resp.len);
+    TEST_ASSERT_EQUAL (0, resp.payload[0]);
+}
+
+void test_app_uart_send_broadcast_timestamped (void)
+{
+    rd_status_t err_code = RD_SUCCESS;
+    const ri_adv_scan_t scan =
+    {
+        .addr = MOCK_MAC_ADDR_INIT(),
+        .rssi = -50,
+        .data = MOCK_DATA_INIT(),
+        .data_len = sizeof (mock_data),
+        .is_coded_phy = false,
+        .primary_phy = BLE_GAP_PHY_1MBPS,
+        .secondary_phy = BLE_GAP_PHY_NOT_SET,
+        .ch_index = 37,
+        .tx_power = BLE_GAP_POWER_LEVEL_INVALID,
+    };
+    uint32_t rx_ms = 0x11223344U;
+    app_uart_ext_frame_t resp;
+    test_app_uart_parser_ext_set_adv_timestamp();
+    mock_sends = 0;
+    ri_adv_parse_manuid_ExpectAnyArgsAndReturn (mock_manuf_id);
+    uint16_t manufacturer_id = 0x0499;
+    app_ble_manufacturer_filter_enabled_ExpectAndReturn (&manufacturer_id, true);
+    app_latency_rx_ms_get_ExpectAnyArgsAndReturn (true);
+    app_latency_rx_ms_get_ReturnThruPtr_p_rx_ms (&rx_ms);
+    err_code |= app_uart_send_broadcast (&scan);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, err_code);
+    TEST_ASSERT_EQUAL (1, mock_sends);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_ext_decode (mock_sent_msg.data,
+                       mock_sent_msg.data_length, &resp));
+    TEST_ASSERT_EQUAL (APP_UART_EXT_ADV_RPRT_TS, resp.cmd);
+    TEST_ASSERT_EQUAL (21U + sizeof (mock_data), resp.len);
+    TEST_ASSERT_EQUAL (0, app_uart_ext_get_u32 (&resp, 0U));
+    TEST_ASSERT_EQUAL_HEX32 (rx_ms, app_uart_ext_get_u32 (&resp, 4U));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (mock_mac, &resp.payload[8], sizeof (mock_mac));
+    TEST_ASSERT_EQUAL (-50, (int8_t) resp.payload[14]);
+    TEST_ASSERT_EQUAL (37, resp.payload[17]);
+    TEST_ASSERT_EQUAL (sizeof (mock_data), resp.payload[20]);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (mock_data, &resp.payload[21], sizeof (mock_data));
+}
+
+void test_app_uart_parser_ext_set_adv_seq (void)
+{
+    const uint8_t payload[] = {1};
+    uint8_t data[16];
+    uint8_t len = sizeof (data);
+    app_uart_ext_frame_t resp;
+    test_app_uart_init_ok();
+    ext_request (APP_UART_EXT_SET_ADV_SEQ, payload, sizeof (payload), data, &len);
+    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_ext,
+                                            RD_SUCCESS);
+    app_uart_parser (data, len);
+    ext_response_expect_sent (APP_UART_EXT_SET_ADV_SEQ, &resp);
+    TEST_ASSERT_EQUAL (1, resp.len);
+    TEST_ASSERT_EQUAL (0, resp.payload[0]);
+}
+
+void test_app_uart_send_broadcast_sequenced (void)
+{
+    const ri_adv_scan_t scan =
+    {
+        .addr = MOCK_MAC_ADDR_INIT(),
+        .rssi = -50,
+        .data = MOCK_DATA_INIT(),
+        .data_len = sizeof (mock_data),
+        .primary_phy = BLE_GAP_PHY_1MBPS,
+        .secondary_phy = BLE_GAP_PHY_NOT_SET,
+        .ch_index = 37,
+        .tx_power = BLE_GAP_POWER_LEVEL_INVALID,
+    };
+    uint16_t manufacturer_id = 0x0499;
+    app_uart_ext_frame_t resp;
+    test_app_uart_parser_ext_set_adv_seq();
+    mock_sends = 0;
+    // Advertisement lost in scan interrupt takes sequence number 0.
+    app_uart_adv_seq_drop();
+    ri_adv_parse_manuid_ExpectAnyArgsAndReturn (mock_manuf_id);
+    app_ble_manufacturer_filter_enabled_ExpectAndReturn (&manufacturer_id, true);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_send_broadcast (&scan));
+    TEST_ASSERT_EQUAL (1, mock_sends);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_ext_decode (mock_sent_msg.data,
+                       mock_sent_msg.data_length, &resp));
+    TEST_ASSERT_EQUAL (APP_UART_EXT_ADV_RPRT_SEQ, resp.cmd);
+    TEST_ASSERT_EQUAL (17U + sizeof (mock_data), resp.len);
+    TEST_ASSERT_EQUAL (1, app_uart_ext_get_u32 (&resp, 0U));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (mock_mac, &resp.payload[4], sizeof (mock_mac));
+    TEST_ASSERT_EQUAL (37, resp.payload[13]);
+    TEST_ASSERT_EQUAL (sizeof (mock_data), resp.payload[16]);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (mock_data, &resp.payload[17], sizeof (mock_data));
+}
+
+void test_app_uart_parser_ext_set_capture (void)
+{
+    const uint8_t payload[] = {1};
+    uint8_t data[16];
+    uint8_t len = sizeof (data);
+    app_uart_ext_frame_t resp;
+    test_app_uart_init_ok();
+    ext_request (APP_UART_EXT_SET_CAPTURE, payload, sizeof (payload), data, &len);
+    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_ext,
+                                            RD_SUCCESS);
+    app_uart_parser (data, len);
+    ext_response_expect_sent (APP_UART_EXT_SET_CAPTURE, &resp);
+    TEST_ASSERT_EQUAL (1, resp.len);
+    TEST_ASSERT_EQUAL (0, resp.payload[0]);
+}
+
+void test_app_uart_send_broadcast_captured (void)
+{
+    const ri_adv_scan_t scan =
+    {
+        .addr = MOCK_MAC_ADDR_INIT(),
+        .rssi = -50,
+        .data = MOCK_DATA_INIT(),
+        .data_len = sizeof (mock_data),
+        .is_coded_phy = true,
+        .primary_phy = BLE_GAP_PHY_CODED,
+        .secondary_phy = BLE_GAP_PHY_CODED,
+        .ch_index = 8,
+        .tx_power = 4,
+    };
+    uint32_t rx_ms = 0x11223344U;
+    uint32_t time_ms = 0;
+    app_uart_ext_frame_t resp;
+    ri_adv_scan_t captured;
+    size_t len = 0;
+    test_app_uart_parser_ext_set_capture();
+    mock_sends = 0;
+    // Captured before manufacturer filter.
+    app_latency_rx_ms_get_ExpectAnyArgsAndReturn (true);
+    app_latency_rx_ms_get_ReturnThruPtr_p_rx_ms (&rx_ms);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_send_broadcast (&scan));
+    TEST_ASSERT_EQUAL (1, mock_sends);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_ext_decode (mock_sent_msg.data,
+                       mock_sent_msg.data_length, &resp));
+    TEST_ASSERT_EQUAL (APP_UART_EXT_CAPTURE, resp.cmd);
+    len = resp.len;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_capture_decode (resp.payload, &len, &time_ms,
+                       &captured));
+    TEST_ASSERT_EQUAL (resp.len, len);
+    TEST_ASSERT_EQUAL_HEX32 (rx_ms, time_ms);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (mock_mac, captured.addr, sizeof (mock_mac));
+    TEST_ASSERT_EQUAL (-50, captured.rssi);
+    TEST_ASSERT_TRUE (captured.is_coded_phy);
+    TEST_ASSERT_EQUAL (BLE_GAP_PHY_CODED, captured.secondary_phy);
+    TEST_ASSERT_EQUAL (8, captured.ch_index);
+    TEST_ASSERT_EQUAL (4, captured.tx_power);
+    TEST_ASSERT_EQUAL (sizeof (mock_data), captured.data_len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (mock_data, captured.data, sizeof (mock_data));
+}
+
+void test_app_uart_parser_ext_get_seq_status (void)
+{
+    const ri_adv_scan_t scan =
+    {
+        .addr = MOCK_MAC_ADDR_INIT(),
+        .rssi = -50,
+        .data = MOCK_DATA_INIT(),
+        .data_len = sizeof (mock_data),
+        .primary_phy = BLE_GAP_PHY_1MBPS,
+        .secondary_phy = BLE_GAP_PHY_NOT_SET,
+        .tx_power = BLE_GAP_POWER_LEVEL_INVALID,
+    };
+    uint16_t manufacturer_id = 0x0499;
+    uint8_t data[16];
+    uint8_t len = sizeof (data);
+    app_uart_ext_frame_t resp;
+    test_app_uart_init_ok();
+    // First advertisement is sent, second is not encoded.
+    ri_adv_parse_manuid_ExpectAnyArgsAndReturn (mock_manuf_id);
+    app_ble_manufacturer_filter_enabled_ExpectAndReturn (&manufacturer_id, true);
+    re_ca_uart_encode_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_send_broadcast (&scan));
+    ri_adv_parse_manuid_ExpectAnyArgsAndReturn (mock_manuf_id);
+    app_ble_manufacturer_filter_enabled_ExpectAndReturn (&manufacturer_id, true);
+    re_ca_uart_encode_ExpectAnyArgsAndReturn (RE_ERROR_INVALID_PARAM);
+    TEST_ASSERT_NOT_EQUAL (RD_SUCCESS, app_uart_send_broadcast (&scan));
+    // Filtered advertisement is not sequenced.
+    ri_adv_parse_manuid_ExpectAnyArgsAndReturn (0x0059);
+    app_ble_manufacturer_filter_enabled_ExpectAndReturn (&manufacturer_id, true);
+    TEST_ASSERT_NOT_EQUAL (RD_SUCCESS, app_uart_send_broadcast (&scan));
+    // Scheduler was full in scan interrupt.
+    app_uart_adv_seq_drop();
+    mock_sends = 0;
+    ext_request (APP_UART_EXT_GET_SEQ_STATUS, NULL, 0, data, &len);
+    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_ext,
+                                            RD_SUCCESS);
+    app_uart_parser (data, len);
+    ext_response_expect_sent (APP_UART_EXT_GET_SEQ_STATUS, &resp);
+    TEST_ASSERT_EQUAL (8, resp.len);
+    TEST_ASSERT_EQUAL (3, app_uart_ext_get_u32 (&resp, 0U));
+    TEST_ASSERT_EQUAL (2, app_uart_ext_get_u32 (&resp, 4U));
+}
+
+void test_app_uart_parser_ext_sync_time (void)
+{
+    const uint8_t payload[] = {1, 2, 3, 4, 5, 6, 7, 8};
+    uint8_t data[24];
+    uint8_t len = sizeof (data);
+    app_uart_ext_frame_t resp;
+    test_app_uart_init_ok();
+    ext_request (APP_UART_EXT_SYNC_TIME, payload, sizeof (payload), data, &len);
+    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_ext,
+                                            RD_SUCCESS);
+    app_uart_parser (data, len);
+    ext_response_expect_sent (APP_UART_EXT_SYNC_TIME, &resp);
+    TEST_ASSERT_EQUAL (12, resp.len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (payload, resp.payload, sizeof (payload));
+    TEST_ASSERT_EQUAL (0, app_uart_ext_get_u32 (&resp, 8U));
+}
+
+void test_app_uart_parser_ext_get_prof (void)
+{
+    const uint8_t payload[] = {APP_UART_EXT_STATS_FLAG_RESET};
+    uint8_t data[16];
+    uint8_t len = sizeof (data);
+    app_uart_ext_frame_t resp;
+    app_prof_stats_t stats[APP_PROF_NUM] = {0};
+    stats[APP_PROF_PARSER].count = 2U;
+    stats[APP_PROF_PARSER].min_cycles = 100U;
+    stats[APP_PROF_PARSER].avg_cycles = 150U;
+    stats[APP_PROF_PARSER].max_cycles = 200U;
+    test_app_uart_init_ok();
+    ext_request (APP_UART_EXT_GET_PROF, payload, sizeof (payload), data, &len);
+    app_prof_get_Expect (NULL, true);
+    app_prof_get_IgnoreArg_p_stats();
+    app_prof_get_ReturnArrayThruPtr_p_stats (stats, APP_PROF_NUM);
+    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_ext,
+                                            RD_SUCCESS);
+    app_uart_parser (data, len);
+    ext_response_expect_sent (APP_UART_EXT_GET_PROF, &resp);
+    TEST_ASSERT_EQUAL (1U + (16U * APP_PROF_NUM), resp.len);
+    TEST_ASSERT_EQUAL (APP_PROF_NUM, resp.payload[0]);
+    TEST_ASSERT_EQUAL (2, app_uart_ext_get_u32 (&resp, 1U + (16U * APP_PROF_PARSER)));
+    TEST_ASSERT_EQUAL (150, app_uart_ext_get_u32 (&resp, 9U + (16U * APP_PROF_PARSER)));
+    TEST_ASSERT_EQUAL (200, app_uart_ext_get_u32 (&resp, 13U + (16U * APP_PROF_PARSER)));
+}
+
+void test_app_uart_parser_ext_get_trace (void)
+{
+    const uint8_t payload[] = {0x10, 0x00, 0x00, 0x00};
+    uint8_t data[16];
+    uint8_t len = sizeof (data);
+    app_uart_ext_frame_t resp;
+    const app_trace_event_t events[2] =
+    {
+        {.time_ms = 0x01020304U, .id = APP_TRACE_CMD_RX, .arg0 = 0xAB, .arg1 = 4U},
+        {.time_ms = 0x01020305U, .id = APP_TRACE_TX_DONE, .arg0 = 0, .arg1 = 0x0102U},
+    };
+    uint32_t first = 0x12U;
+    test_app_uart_init_ok();
+    ext_request (APP_UART_EXT_GET_TRACE, payload, sizeof (payload), data, &len);
+    app_trace_next_seq_ExpectAndReturn (0x14U);
+    app_trace_read_ExpectAndReturn (0x10U, NULL, NULL, 28U, 2U);
+    app_trace_read_IgnoreArg_p_first();
+    app_trace_read_IgnoreArg_p_events();
+    app_trace_read_ReturnThruPtr_p_first (&first);
+    app_trace_read_ReturnArrayThruPtr_p_events (events, 2);
+    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_ext,
+                                            RD_SUCCESS);
+    app_uart_parser (data, len);
+    ext_response_expect_sent (APP_UART_EXT_GET_TRACE, &resp);
+    TEST_ASSERT_EQUAL (9U + (2U * APP_TRACE_EVENT_SIZE), resp.len);
+    TEST_ASSERT_EQUAL (0x14U, app_uart_ext_get_u32 (&resp, 0U));
+    TEST_ASSERT_EQUAL (0x12U, app_uart_ext_get_u32 (&resp, 4U));
+    TEST_ASSERT_EQUAL (2, resp.payload[8]);
+    TEST_ASSERT_EQUAL_HEX32 (0x01020304U, app_uart_ext_get_u32 (&resp, 9U));
+    TEST_ASSERT_EQUAL (APP_TRACE_CMD_RX, resp.payload[13]);
+    TEST_ASSERT_EQUAL_HEX8 (0xAB, resp.payload[14]);
+    TEST_ASSERT_EQUAL (0x0102U, app_uart_ext_get_u16 (&resp, 23U));
+}
+
+void test_app_uart_parser_ext_set_heartbeat (void)
+{
+    const uint8_t start[] = {0xE8, 0x03, 0x00, 0x00};
+    const uint8_t stop[] = {0x00, 0x00, 0x00, 0x00};
+    uint8_t data[16];
+    uint8_t len = sizeof (data);
+    app_uart_ext_frame_t resp;
+    test_app_uart_init_ok();
+    ri_timer_create_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_heartbeat_init (0));
+    ext_request (APP_UART_EXT_SET_HEARTBEAT, start, sizeof (start), data, &len);
+    ri_timer_start_ExpectAndReturn (NULL, 1000U, NULL, RD_SUCCESS);
+    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_ext,
+                                            RD_SUCCESS);
+    app_uart_parser (data, len);
+    ext_response_expect_sent (APP_UART_EXT_SET_HEARTBEAT, &resp);
+    TEST_ASSERT_EQUAL (0, resp.payload[0]);
+    mock_sends = 0;
+    len = sizeof (data);
+    ext_request (APP_UART_EXT_SET_HEARTBEAT, stop, sizeof (stop), data, &len);
+    ri_timer_stop_ExpectAndReturn (NULL, RD_SUCCESS);
+    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_ext,
+                                            RD_SUCCESS);
+    app_uart_parser (data, len);
+    ext_response_expect_sent (APP_UART_EXT_SET_HEARTBEAT, &resp);
+    TEST_ASSERT_EQUAL (0, resp.payload[0]);
+}
+
+void test_app_uart_parser_ext_set_heartbeat_too_short (void)
+{
+    const uint8_t payload[] = {APP_UART_HEARTBEAT_INTERVAL_MIN_MS - 1U, 0x00, 0x00, 0x00};
+    uint8_t data[16];
+    uint8_t len = sizeof (data);
+    app_uart_ext_frame_t resp;
+    test_app_uart_init_ok();
+    ext_request (APP_UART_EXT_SET_HEARTBEAT, payload, sizeof (payload), data, &len);
+    ri_scheduler_event_put_ExpectAndReturn (NULL, 0, &app_uart_on_evt_send_ext,
+                                            RD_SUCCESS);
+    app_uart_parser (data, len);
+    ext_response_expect_sent (APP_UART_EXT_SET_HEARTBEAT, &resp);
+    TEST_ASSERT_EQUAL (1, resp.payload[0]);
+}
+
+void test_app_uart_heartbeat_sent (void)
+{
+    app_uart_ext_frame_t frame;
+    app_ble_restart_stats_t restarts = {.fast_restarts = 5U, .full_restarts = 2U};
+    app_queue_stats_t queues[APP_QUEUE_NUM] = {0};
+    queues[APP_QUEUE_UART_TX].level = 3U;
+    queues[APP_QUEUE_UART_TX].high_water = 9U;
+    test_app_uart_init_ok();
+    ri_timer_create_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_heartbeat_init (0x04U));
+    app_stats_add (APP_STATS_DROP_SCHED_FULL, 7U);
+    app_ble_restart_stats_get_ExpectAnyArgs();
+    app_ble_restart_stats_get_ReturnThruPtr_p_stats (&restarts);
+    app_queue_stats_get_ExpectAnyArgs();
+    app_queue_stats_get_ReturnArrayThruPtr_p_stats (queues, APP_QUEUE_NUM);
+    app_ble_modulation_get_ExpectAndReturn (RI_RADIO_BLE_125KBPS);
+    app_uart_on_evt_heartbeat (NULL, 0);
     TEST_ASSERT_EQUAL (1, mock_sends);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_ext_decode (mock_sent_msg.data,
+                       mock_sent_msg.data_length, &frame));
+    TEST_ASSERT_EQUAL (APP_UART_EXT_HEARTBEAT, frame.cmd);
+    TEST_ASSERT_EQUAL (46U + (4U * APP_QUEUE_NUM), frame.len);
+    TEST_ASSERT_EQUAL (0x04U, app_uart_ext_get_u32 (&frame, 4U));
+    TEST_ASSERT_EQUAL (RI_RADIO_BLE_125KBPS, frame.payload[8]);
+    TEST_ASSERT_EQUAL (5, app_uart_ext_get_u32 (&frame, 9U));
+    TEST_ASSERT_EQUAL (2, app_uart_ext_get_u32 (&frame, 13U));
+    TEST_ASSERT_EQUAL (7, app_uart_ext_get_u32 (&frame, 17U));
+    TEST_ASSERT_EQUAL (0, app_uart_ext_get_u32 (&frame, 33U));
+    TEST_ASSERT_EQUAL (0, app_uart_ext_get_u32 (&frame, 37U));
+    TEST_ASSERT_EQUAL (APP_QUEUE_NUM, frame.payload[45]);
+    TEST_ASSERT_EQUAL (3, app_uart_ext_get_u16 (&frame, 46U + (4U * APP_QUEUE_UART_TX)));
+    TEST_ASSERT_EQUAL (9, app_uart_ext_get_u16 (&frame, 48U + (4U * APP_QUEUE_UART_TX)));
+}
+
+void test_app_uart_parser_ext_unknown_no_response (void)
+{
+    uint8_t data[16];
+    uint8_t len = sizeof (data);
+    ext_request (0xFEU, NULL, 0, data, &len);
+    app_uart_parser (data, len);
+    TEST_ASSERT_EQUAL (0, mock_sends);
 }
@@ -0,0 +1,117 @@
+#include "unity.h"
+
+#include "app_uart_ext.h"
+#include "ruuvi_endpoint_ca_uart.h"
+#include <string.h>
+
+void setUp (void)
+{
+}
+
+void tearDown (void)
+{
+}
+
+void test_app_uart_ext_crc16_matches_ca_uart (void)
+{
+    // LEN and CMD of CA UART GET_DEVICE_ID frame, CRC 0x8E36.
+    const uint8_t data[] = {0 + CMD_IN_LEN, RE_CA_UART_GET_DEVICE_ID};
+    TEST_ASSERT_EQUAL_HEX16 (0x8E36U, app_uart_ext_crc16 (data, sizeof (data)));
+}
+
+void test_app_uart_ext_encode_decode (void)
+{
+    uint8_t buffer[RI_COMM_MESSAGE_MAX_LENGTH];
+    uint8_t len = sizeof (buffer);
+    app_uart_ext_frame_t frame = {.cmd = APP_UART_EXT_GET_SCAN_STATS};
+    app_uart_ext_frame_t decoded;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_ext_put_u8 (&frame, 0x12U));
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_ext_put_u16 (&frame, 0x3456U));
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_ext_put_u32 (&frame, 0x789ABCDEU));
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_ext_encode (buffer, &len, &frame));
+    TEST_ASSERT_EQUAL (7 + APP_UART_EXT_OVERHEAD, len);
+    TEST_ASSERT_EQUAL_HEX8 (RE_CA_UART_STX, buffer[0]);
+    TEST_ASSERT_EQUAL (7, buffer[1]);
+    TEST_ASSERT_EQUAL_HEX8 (APP_UART_EXT_GET_SCAN_STATS, buffer[2]);
+    TEST_ASSERT_EQUAL_HEX8 (0x56U, buffer[4]);
+    TEST_ASSERT_EQUAL_HEX8 (0xDEU, buffer[6]);
+    TEST_ASSERT_EQUAL_HEX8 (RE_CA_UART_ETX, buffer[len - 1U]);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_ext_decode (buffer, len, &decoded));
+    TEST_ASSERT_EQUAL (frame.cmd, decoded.cmd);
+    TEST_ASSERT_EQUAL (frame.len, decoded.len);
+    TEST_ASSERT_EQUAL_MEMORY (frame.payload, decoded.payload, frame.len);
+}
+
+void test_app_uart_ext_encode_too_small (void)
+{
+    uint8_t buffer[APP_UART_EXT_OVERHEAD];
+    uint8_t len = sizeof (buffer);
+    app_uart_ext_frame_t frame = {.cmd = APP_UART_EXT_GET_SCAN_STATS, .len = 1};
+    TEST_ASSERT_EQUAL (RD_ERROR_DATA_SIZE, app_uart_ext_encode (buffer, &len, &frame));
+}
+
+void test_app_uart_ext_encode_null (void)
+{
+    uint8_t len = 0;
+    app_uart_ext_frame_t frame = {0};
+    TEST_ASSERT_EQUAL (RD_ERROR_NULL, app_uart_ext_encode (NULL, &len, &frame));
+}
+
+void test_app_uart_ext_decode_ca_uart_frame (void)
+{
+    const uint8_t data[] =
+    {
+        RE_CA_UART_STX,
+        0 + CMD_IN_LEN,
+        RE_CA_UART_GET_DEVICE_ID,
+        0x36U, 0x8EU, //crc
+        RE_CA_UART_ETX
+    };
+    app_uart_ext_frame_t decoded;
+    TEST_ASSERT_EQUAL (RD_ERROR_NOT_FOUND, app_uart_ext_decode (data, sizeof (data),
+                       &decoded));
+}
+
+void test_app_uart_ext_decode_corrupted (void)
+{
+    uint8_t buffer[16];
+    uint8_t len = sizeof (buffer);
+    app_uart_ext_frame_t frame = {.cmd = APP_UART_EXT_SET_SCAN_SCHED, .len = 1};
+    app_uart_ext_frame_t decoded;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_ext_encode (buffer, &len, &frame));
+    buffer[3] ^= 0x01U;
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_DATA, app_uart_ext_decode (buffer, len, &decoded));
+}
+
+void test_app_uart_ext_decode_incomplete (void)
+{
+    uint8_t buffer[16];
+    uint8_t len = sizeof (buffer);
+    app_uart_ext_frame_t frame = {.cmd = APP_UART_EXT_SET_SCAN_SCHED, .len = 4};
+    app_uart_ext_frame_t decoded;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_ext_encode (buffer, &len, &frame));
+    TEST_ASSERT_EQUAL (RD_ERROR_INVALID_DATA, app_uart_ext_decode (buffer, len - 1U,
+                       &decoded));
+}
+
+void test_app_uart_ext_put_full (void)
+{
+    app_uart_ext_frame_t frame = {.len = APP_UART_EXT_PAYLOAD_MAX_LEN - 1U};
+    TEST_ASSERT_EQUAL (RD_ERROR_DATA_SIZE, app_uart_ext_put_u16 (&frame, 0));
+}
+
+void test_app_uart_ext_get_roundtrip (void)
+{
+    app_uart_ext_frame_t frame = {0};
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_ext_put_u16 (&frame, 0xBEEFU));
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_ext_put_u32 (&frame, 0x12345678U));
+    TEST_ASSERT_EQUAL_HEX16 (0xBEEFU, app_uart_ext_get_u16 (&frame, 0));
+    TEST_ASSERT_EQUAL_HEX32 (0x12345678U, app_uart_ext_get_u32 (&frame, 2));
+}
+
+void test_app_uart_ext_get_past_payload (void)
+{
+    app_uart_ext_frame_t frame = {.len = 3, .payload = {1, 2, 3}};
+    TEST_ASSERT_EQUAL (0, app_uart_ext_get_u16 (&frame, 2));
+    TEST_ASSERT_EQUAL (0, app_uart_ext_get_u32 (&frame, 0));
+}
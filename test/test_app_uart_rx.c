@@ -0,0 +1,308 @@
+#include "unity.h"
+
+#include "app_config.h"
+#include "app_queue.h"
+#include "app_stats.h"
+#include "app_uart_ext.h"
+#include "app_uart_rx.h"
+#include "ruuvi_endpoint_ca_uart.h"
+#include <string.h>
+
+#define FRAMES_NUM     (4U)   //!< Frames in test stream.
+#define STREAM_MAX_LEN (512U) //!< Test stream with garbage and padding.
+#define RECEIVED_MAX   (16U)  //!< Frames recorded by handler.
+#define RANDOM_ROUNDS  (1000U)
+
+static uint8_t m_stream[STREAM_MAX_LEN];
+static size_t m_stream_len;
+static size_t m_frame_start[FRAMES_NUM];
+static size_t m_frame_len[FRAMES_NUM];
+static uint32_t m_received[RECEIVED_MAX];
+static size_t m_received_num;
+static uint32_t m_random;
+
+/** @brief Record identifier of a valid gateway frame, reject anything else. */
+static bool on_frame (const uint8_t * const p_frame, const size_t len)
+{
+    app_uart_ext_frame_t frame;
+    bool is_valid = (RD_SUCCESS == app_uart_ext_decode (p_frame, len, &frame));
+
+    if (is_valid && (m_received_num < RECEIVED_MAX))
+    {
+        m_received[m_received_num] = app_uart_ext_get_u32 (&frame, 0U);
+    }
+
+    m_received_num += is_valid ? 1U : 0U;
+    return is_valid;
+}
+
+static void stream_add (const uint8_t * const p_data, const size_t len)
+{
+    TEST_ASSERT_LESS_OR_EQUAL (sizeof (m_stream), m_stream_len + len);
+    memcpy (&m_stream[m_stream_len], p_data, len);
+    m_stream_len += len;
+}
+
+/** @brief Add frame whose identifier and padding contain STX and ETX bytes. */
+static void stream_add_frame (const uint8_t index)
+{
+    app_uart_ext_frame_t frame = {.cmd = APP_UART_EXT_SYNC_TIME};
+    uint8_t buffer[RI_COMM_MESSAGE_MAX_LENGTH];
+    uint8_t len = sizeof (buffer);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_ext_put_u32 (&frame,
+                       0x0ACA0000U | index));
+
+    for (uint8_t ii = 0; ii < (3U * index); ii++)
+    {
+        TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_ext_put_u8 (&frame,
+                           (0U == (ii % 2U)) ? RE_CA_UART_STX : RE_CA_UART_ETX));
+    }
+
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_ext_encode (buffer, &len, &frame));
+    m_frame_start[index] = m_stream_len;
+    m_frame_len[index] = len;
+    stream_add (buffer, len);
+}
+
+static void stream_add_frames (void)
+{
+    for (uint8_t ii = 0; ii < FRAMES_NUM; ii++)
+    {
+        stream_add_frame (ii);
+    }
+}
+
+/** @brief Add bytes which complete any frame corrupted data claims to start. */
+static void stream_add_padding (void)
+{
+    const uint8_t padding[APP_UART_RX_BUFFER_LEN] = {0};
+    stream_add (padding, sizeof (padding));
+}
+
+static void put_split (const size_t * const p_splits, const size_t num)
+{
+    size_t start = 0;
+
+    for (size_t ii = 0; ii <= num; ii++)
+    {
+        const size_t end = (ii < num) ? p_splits[ii] : m_stream_len;
+        app_uart_rx_put (&m_stream[start], end - start, &on_frame);
+        TEST_ASSERT_LESS_OR_EQUAL (APP_UART_RX_BUFFER_LEN, app_uart_rx_pending());
+        start = end;
+    }
+}
+
+/** @brief Check that frames were received once in order, except one skipped. */
+static void received_check (const size_t skipped)
+{
+    size_t expected = 0;
+    TEST_ASSERT_EQUAL (FRAMES_NUM - ( (skipped < FRAMES_NUM) ? 1U : 0U), m_received_num);
+
+    for (uint8_t ii = 0; ii < FRAMES_NUM; ii++)
+    {
+        if (ii != skipped)
+        {
+            TEST_ASSERT_EQUAL_HEX32 (0x0ACA0000U | ii, m_received[expected]);
+            expected++;
+        }
+    }
+
+    TEST_ASSERT_EQUAL (0, app_uart_rx_pending());
+    m_received_num = 0;
+    app_uart_rx_clear();
+}
+
+static uint32_t random_next (void)
+{
+    m_random = (m_random * 1103515245U) + 12345U;
+    return m_random >> 8U;
+}
+
+void setUp (void)
+{
+    m_stream_len = 0;
+    m_received_num = 0;
+    m_random = 1U;
+    app_uart_rx_clear();
+    app_queue_clear();
+    app_stats_clear();
+}
+
+void tearDown (void)
+{
+}
+
+void test_app_uart_rx_whole_stream (void)
+{
+    stream_add_frames();
+    put_split (NULL, 0);
+    received_check (FRAMES_NUM);
+}
+
+void test_app_uart_rx_every_split (void)
+{
+    stream_add_frames();
+
+    for (size_t split = 0; split <= m_stream_len; split++)
+    {
+        put_split (&split, 1U);
+        received_check (FRAMES_NUM);
+    }
+}
+
+void test_app_uart_rx_every_split_pair (void)
+{
+    stream_add_frames();
+
+    for (size_t first = 0; first <= m_stream_len; first++)
+    {
+        for (size_t second = first; second <= m_stream_len; second++)
+        {
+            const size_t splits[] = {first, second};
+            put_split (splits, 2U);
+            received_check (FRAMES_NUM);
+        }
+    }
+}
+
+void test_app_uart_rx_every_chunk_size (void)
+{
+    stream_add_frames();
+
+    for (size_t chunk = 1; chunk <= m_stream_len; chunk++)
+    {
+        for (size_t start = 0; start < m_stream_len; start += chunk)
+        {
+            const size_t end = ( (start + chunk) < m_stream_len) ? (start + chunk) : m_stream_len;
+            app_uart_rx_put (&m_stream[start], end - start, &on_frame);
+        }
+
+        received_check (FRAMES_NUM);
+    }
+}
+
+void test_app_uart_rx_garbage_between_frames (void)
+{
+    const uint8_t garbage[] = {0x00U, RE_CA_UART_ETX, RE_CA_UART_STX, 0xFFU, RE_CA_UART_STX};
+    app_stats_t stats;
+
+    for (uint8_t ii = 0; ii < FRAMES_NUM; ii++)
+    {
+        stream_add (garbage, sizeof (garbage));
+        stream_add_frame (ii);
+    }
+
+    for (size_t split = 0; split <= m_stream_len; split++)
+    {
+        put_split (&split, 1U);
+        received_check (FRAMES_NUM);
+    }
+
+    app_stats_get (&stats, false);
+    TEST_ASSERT_GREATER_OR_EQUAL (FRAMES_NUM, stats.counters[APP_STATS_DECODE_ERRORS]);
+}
+
+void test_app_uart_rx_corrupted_frame_skipped (void)
+{
+    stream_add_frames();
+    stream_add_padding();
+
+    for (size_t index = 0; index < m_frame_len[1]; index++)
+    {
+        m_stream[m_frame_start[1] + index] ^= 0x55U;
+
+        for (size_t split = 0; split <= m_stream_len; split += 7U)
+        {
+            put_split (&split, 1U);
+            received_check (1U);
+        }
+
+        m_stream[m_frame_start[1] + index] ^= 0x55U;
+    }
+}
+
+void test_app_uart_rx_too_long_discarded (void)
+{
+    const uint8_t data[] = {RE_CA_UART_STX, APP_UART_RX_BUFFER_LEN - APP_UART_EXT_OVERHEAD + 1U};
+    app_stats_t stats;
+    app_uart_rx_put (data, sizeof (data), &on_frame);
+    TEST_ASSERT_EQUAL (0, app_uart_rx_pending());
+    app_stats_get (&stats, false);
+    TEST_ASSERT_EQUAL (1, stats.counters[APP_STATS_DECODE_ERRORS]);
+}
+
+void test_app_uart_rx_longest_frame (void)
+{
+    app_uart_ext_frame_t frame = {.cmd = APP_UART_EXT_SYNC_TIME};
+    app_queue_stats_t queues[APP_QUEUE_NUM];
+    uint8_t len = RI_COMM_MESSAGE_MAX_LENGTH;
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_ext_put_u32 (&frame, 0x0ACA0000U));
+
+    while (frame.len < (APP_UART_RX_BUFFER_LEN - APP_UART_EXT_OVERHEAD))
+    {
+        TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_ext_put_u8 (&frame, RE_CA_UART_STX));
+    }
+
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_uart_ext_encode (m_stream, &len, &frame));
+    TEST_ASSERT_EQUAL (APP_UART_RX_BUFFER_LEN, len);
+    app_uart_rx_put (m_stream, len - 1U, &on_frame);
+    app_queue_stats_get (queues, false);
+    TEST_ASSERT_EQUAL (len - 1U, queues[APP_QUEUE_UART_RX].high_water);
+    app_uart_rx_put (&m_stream[len - 1U], 1U, &on_frame);
+    TEST_ASSERT_EQUAL (1, m_received_num);
+    TEST_ASSERT_EQUAL (0, app_uart_rx_pending());
+}
+
+void test_app_uart_rx_rejected_frame_resync (void)
+{
+    // Valid CA UART frame, not a gateway command.
+    const uint8_t ca_frame[] =
+    {
+        RE_CA_UART_STX, 0 + CMD_IN_LEN, RE_CA_UART_GET_DEVICE_ID, 0x36U, 0x8EU, RE_CA_UART_ETX
+    };
+    stream_add_frame (0U);
+    stream_add (ca_frame, sizeof (ca_frame));
+
+    for (uint8_t ii = 1; ii < FRAMES_NUM; ii++)
+    {
+        stream_add_frame (ii);
+    }
+
+    put_split (NULL, 0);
+    received_check (FRAMES_NUM);
+}
+
+void test_app_uart_rx_random_splits_and_corruption (void)
+{
+    stream_add_frames();
+    stream_add_padding();
+
+    for (size_t round = 0; round < RANDOM_ROUNDS; round++)
+    {
+        size_t splits[8];
+        const size_t corrupted = random_next() % (FRAMES_NUM + 1U);
+        size_t index = 0;
+
+        for (size_t ii = 0; ii < (sizeof (splits) / sizeof (splits[0])); ii++)
+        {
+            index += random_next() % ( (m_stream_len - index) + 1U);
+            splits[ii] = index;
+        }
+
+        if (corrupted < FRAMES_NUM)
+        {
+            index = m_frame_start[corrupted] + (random_next() % m_frame_len[corrupted]);
+            m_stream[index] ^= (uint8_t) ( (random_next() % 255U) + 1U);
+        }
+
+        put_split (splits, sizeof (splits) / sizeof (splits[0]));
+        received_check (corrupted);
+
+        if (corrupted < FRAMES_NUM)
+        {
+            m_stream_len = 0;
+            stream_add_frames();
+            stream_add_padding();
+        }
+    }
+}
@@ -0,0 +1,69 @@
+#include "unity.h"
+
+#include "app_config.h"
+#include "app_wdt.h"
+#include "mock_app_trace.h"
+#include "mock_ruuvi_interface_rtc.h"
+#include "mock_ruuvi_interface_scheduler.h"
+#include "mock_ruuvi_interface_timer.h"
+#include "mock_ruuvi_interface_watchdog.h"
+
+void setUp (void)
+{
+    ri_timer_create_ExpectAnyArgsAndReturn (RD_SUCCESS);
+    ri_timer_start_ExpectAndReturn (NULL, APP_WDT_CHECK_INTERVAL_MS, NULL, RD_SUCCESS);
+    TEST_ASSERT_EQUAL (RD_SUCCESS, app_wdt_init());
+}
+
+void tearDown (void)
+{
+}
+
+static void check_expect_fed (const uint32_t now_ms)
+{
+    ri_rtc_millis_ExpectAndReturn (now_ms);
+    ri_watchdog_feed_ExpectAndReturn (RD_SUCCESS);
+    TEST_ASSERT_EQUAL (0, app_wdt_check());
+}
+
+void test_app_wdt_feeds_when_disarmed (void)
+{
+    check_expect_fed (100000U);
+}
+
+void test_app_wdt_checkin_keeps_feeding (void)
+{
+    ri_rtc_millis_ExpectAndReturn (1000U);
+    app_wdt_arm (APP_WDT_SCAN, 5000U);
+    check_expect_fed (6000U);
+    ri_rtc_millis_ExpectAndReturn (5500U);
+    app_wdt_checkin (APP_WDT_SCAN);
+    check_expect_fed (10500U);
+}
+
+void test_app_wdt_late_starves (void)
+{
+    ri_rtc_millis_ExpectAndReturn (1000U);
+    app_wdt_arm (APP_WDT_SCAN, 5000U);
+    ri_rtc_millis_ExpectAndReturn (2000U);
+    app_wdt_arm (APP_WDT_UART_TX, 100U);
+    ri_rtc_millis_ExpectAndReturn (2101U);
+    app_trace_record_Expect (APP_TRACE_WDT_STARVE, 1U << APP_WDT_UART_TX, 0U);
+    TEST_ASSERT_EQUAL (1U << APP_WDT_UART_TX, app_wdt_check());
+    ri_rtc_millis_ExpectAndReturn (6001U);
+    app_trace_record_Expect (APP_TRACE_WDT_STARVE,
+                             (1U << APP_WDT_SCAN) | (1U << APP_WDT_UART_TX), 0U);
+    TEST_ASSERT_EQUAL ( (1U << APP_WDT_SCAN) | (1U << APP_WDT_UART_TX), app_wdt_check());
+    // Idle subsystem is not supervised.
+    app_wdt_disarm (APP_WDT_UART_TX);
+    ri_rtc_millis_ExpectAndReturn (6002U);
+    app_trace_record_Expect (APP_TRACE_WDT_STARVE, 1U << APP_WDT_SCAN, 0U);
+    TEST_ASSERT_EQUAL (1U << APP_WDT_SCAN, app_wdt_check());
+}
+
+void test_app_wdt_time_wraps (void)
+{
+    ri_rtc_millis_ExpectAndReturn (UINT32_MAX - 10U);
+    app_wdt_arm (APP_WDT_UART_TX, 100U);
+    check_expect_fed (50U);
+}
@@ -5,11 +5,15 @@
 #include "ruuvi_boards.h"
 
 #include "mock_app_ble.h"
+#include "mock_app_flash.h"
+#include "mock_app_log.h"
 #include "mock_app_uart.h"
+#include "mock_app_wdt.h"
 #include "mock_ruuvi_driver_error.h"
 #include "mock_ruuvi_interface_communication_ble_advertising.h"
 #include "mock_ruuvi_interface_gpio.h"
 #include "mock_ruuvi_interface_log.h"
+#include "mock_ruuvi_interface_rtc.h"
 #include "mock_ruuvi_interface_scheduler.h"
 #include "mock_ruuvi_interface_timer.h"
 #include "mock_ruuvi_interface_watchdog.h"
@@ -49,15 +53,21 @@ void test_app_main (void)
     ri_watchdog_init_ExpectAndReturn (APP_WDT_INTERVAL_MS, &on_wdt, RD_SUCCESS);
     ri_yield_init_ExpectAndReturn (RD_SUCCESS);
     ri_timer_init_ExpectAndReturn (RD_SUCCESS);
+    ri_rtc_init_ExpectAndReturn (RD_SUCCESS);
     ri_scheduler_init_ExpectAndReturn (RD_SUCCESS);
+    app_wdt_init_ExpectAndReturn (RD_SUCCESS);
     ri_gpio_init_ExpectAndReturn (RD_SUCCESS);
     leds_expect();
     ri_yield_low_power_enable_ExpectAndReturn (true, RD_SUCCESS);
     app_uart_init_ExpectAndReturn (RD_SUCCESS);
+    app_uart_heartbeat_init_ExpectAndReturn (0, RD_SUCCESS);
+    app_flash_init_ExpectAndReturn (RD_SUCCESS);
+    app_ble_config_restore_ExpectAndReturn (RD_SUCCESS);
     app_uart_poll_configuration_ExpectAndReturn (RD_SUCCESS);
     app_ble_scan_start_ExpectAndReturn (RD_SUCCESS);
     ri_watchdog_feed_IgnoreAndReturn (RD_SUCCESS);
     ri_scheduler_execute_ExpectAndReturn (RD_SUCCESS);
+    app_log_process_Expect();
     ri_yield_ExpectAndReturn (RD_SUCCESS);
     app_main();
 }
\ No newline at end of file